@@ -9,11 +9,20 @@
 #include "xcore_c_channel_transaction.h"
 #include "xcore_c_clock.h"
 #include "xcore_c_error_codes.h"
+#include "xcore_c_exception.h"
+#include "xcore_c_host.h"
 #include "xcore_c_hwtimer.h"
+#include "xcore_c_i2s.h"
 #include "xcore_c_interrupt.h"
 #include "xcore_c_lock.h"
 #include "xcore_c_port.h"
 #include "xcore_c_port_protocol.h"
+#include "xcore_c_port_stream.h"
 #include "xcore_c_select.h"
+#include "xcore_c_spi.h"
+#include "xcore_c_stats.h"
+#include "xcore_c_trace.h"
+#include "xcore_c_track.h"
+#include "xcore_c_uart.h"
 
 #endif // __xcore_c_h__
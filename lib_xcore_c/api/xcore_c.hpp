@@ -0,0 +1,216 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+
+#ifndef __xcore_c_hpp__
+#define __xcore_c_hpp__
+
+#if defined(__cplusplus) && (!defined(__XC__) || defined(__DOXYGEN__))
+
+// Typed C++ wrappers over the library, requiring C++11.
+// They are header only: each transfer is resolved at compile time to the
+// same library call as the equivalent C, so they add no run time cost.
+
+extern "C" {
+#include "xcore_c.h"
+}
+#include "xcore_c_cpp_impl.h"
+#include <type_traits>
+
+namespace xcore_c {
+
+/** A chan-end of a channel carrying values of type T.
+ *
+ *  T must be trivially copyable, and both ends must use the same T.
+ *  Each value is transferred by the cheapest path for its size and alignment:
+ *  one byte or word, a block of words if it is a word aligned multiple of
+ *  words, or otherwise a block of bytes.
+ *  It does not own the chan-end.
+ */
+template <typename T>
+class ChanEnd {
+  static_assert(std::is_trivially_copyable<T>::value,
+                "A channel carries trivially copyable values");
+
+public:
+  explicit ChanEnd(chanend c) : c_(c) {}
+
+  /** The underlying chan-end, for use with the C API. */
+  chanend get() const { return c_; }
+
+  /** Output a value over the channel.
+   *
+   *  \return     error_none (or exception type if policy is XCORE_C_NO_EXCEPTION).
+   */
+  xcore_c_error_t out(const T &v) const
+  {
+    return _chan_transfer<_chan_ops, T>::out(c_, v);
+  }
+
+  /** Input a value from the channel.
+   *
+   *  \return     error_none (or exception type if policy is XCORE_C_NO_EXCEPTION).
+   */
+  xcore_c_error_t in(T &v) const
+  {
+    return _chan_transfer<_chan_ops, T>::in(c_, v);
+  }
+
+private:
+  chanend c_;
+};
+
+/** A channel carrying values of type T.
+ *
+ *  The two chan-ends are allocated and joined on construction, and freed on
+ *  destruction. If there were not enough chan-ends the channel is invalid.
+ *  **The chan-ends must be accessed on the same tile**
+ */
+template <typename T>
+class Channel {
+  static_assert(std::is_trivially_copyable<T>::value,
+                "A channel carries trivially copyable values");
+
+public:
+  Channel() { chan_alloc(&c_); }
+  ~Channel() { if (c_.end_a) { chan_free(&c_); } }
+  Channel(const Channel &) = delete;
+  Channel &operator=(const Channel &) = delete;
+
+  /** Whether the chan-ends were allocated. */
+  explicit operator bool() const { return c_.end_a != 0; }
+
+  ChanEnd<T> end_a() const { return ChanEnd<T>(c_.end_a); }
+  ChanEnd<T> end_b() const { return ChanEnd<T>(c_.end_b); }
+
+private:
+  channel_t c_;
+};
+
+/** A chan-end of a streaming channel carrying values of type T.
+ *
+ *  As ChanEnd, but the values are not synchronised.
+ */
+template <typename T>
+class StreamingChanEnd {
+  static_assert(std::is_trivially_copyable<T>::value,
+                "A channel carries trivially copyable values");
+
+public:
+  explicit StreamingChanEnd(streaming_chanend_t c) : c_(c) {}
+
+  /** The underlying chan-end, for use with the C API. */
+  streaming_chanend_t get() const { return c_; }
+
+  /** Output a value over the streaming channel.
+   *
+   *  \return     error_none (or exception type if policy is XCORE_C_NO_EXCEPTION).
+   */
+  xcore_c_error_t out(const T &v) const
+  {
+    return _chan_transfer<_s_chan_ops, T>::out(c_, v);
+  }
+
+  /** Input a value from the streaming channel.
+   *
+   *  \return     error_none (or exception type if policy is XCORE_C_NO_EXCEPTION).
+   */
+  xcore_c_error_t in(T &v) const
+  {
+    return _chan_transfer<_s_chan_ops, T>::in(c_, v);
+  }
+
+private:
+  streaming_chanend_t c_;
+};
+
+/** A streaming channel carrying values of type T.
+ *
+ *  The two chan-ends are allocated and joined on construction, and freed on
+ *  destruction. If there were not enough chan-ends the channel is invalid.
+ *  **The chan-ends must be accessed on the same tile**
+ */
+template <typename T>
+class StreamingChannel {
+  static_assert(std::is_trivially_copyable<T>::value,
+                "A channel carries trivially copyable values");
+
+public:
+  StreamingChannel() { s_chan_alloc(&c_); }
+  ~StreamingChannel() { if (c_.end_a) { s_chan_free(&c_); } }
+  StreamingChannel(const StreamingChannel &) = delete;
+  StreamingChannel &operator=(const StreamingChannel &) = delete;
+
+  /** Whether the chan-ends were allocated. */
+  explicit operator bool() const { return c_.end_a != 0; }
+
+  StreamingChanEnd<T> end_a() const { return StreamingChanEnd<T>(c_.end_a); }
+  StreamingChanEnd<T> end_b() const { return StreamingChanEnd<T>(c_.end_b); }
+
+private:
+  streaming_channel_t c_;
+};
+
+/** A port transferring Width bits at a time.
+ *
+ *  The port is allocated on construction and freed on destruction. A buffered
+ *  port serialises each transfer over the port's pins, so Width may be 1, 4, 8
+ *  or 32 and must be at least the width of the port. An unbuffered port's
+ *  Width must be the width of the port.
+ *  The data of each transfer is held in the smallest type which fits it.
+ */
+template <size_t Width, bool Buffered = false>
+class Port {
+  static_assert(Width == 1 || Width == 4 || Width == 8 || Width == 16 || Width == 32,
+                "A port is 1, 4, 8, 16 or 32 bits wide");
+  static_assert(!Buffered || Width != 16,
+                "A buffered port's transfer width is 1, 4, 8 or 32 bits");
+
+public:
+  typedef typename _port_data<Width>::type data_t;
+  static_assert(std::is_trivially_copyable<data_t>::value,
+                "A port transfers trivially copyable values");
+
+  explicit Port(port_id_t id) : p_(0)
+  {
+    if (Buffered) {
+      xassert(_XCORE_C_PORT_ID_WIDTH(id) <= Width && msg("Port is wider than its transfer width"));
+      port_alloc_buffered(&p_, id, Width);
+    }
+    else {
+      xassert(_XCORE_C_PORT_ID_WIDTH(id) == Width && msg("Port is not of its width"));
+      port_alloc(&p_, id);
+    }
+  }
+  ~Port() { if (p_) { port_free(&p_); } }
+  Port(const Port &) = delete;
+  Port &operator=(const Port &) = delete;
+
+  /** The underlying port, for use with the C API. */
+  port get() const { return p_; }
+
+  /** Output data to the port.
+   *
+   *  \return     error_none (or exception type if policy is XCORE_C_NO_EXCEPTION).
+   */
+  xcore_c_error_t out(data_t data) const { return port_out(p_, data); }
+
+  /** Input data from the port.
+   *
+   *  \return     error_none (or exception type if policy is XCORE_C_NO_EXCEPTION).
+   */
+  xcore_c_error_t in(data_t &data) const
+  {
+    uint32_t d;
+    xcore_c_error_t error = port_in(p_, &d);
+    data = static_cast<data_t>(d);
+    return error;
+  }
+
+private:
+  port p_;
+};
+
+} // namespace xcore_c
+
+#endif // defined(__cplusplus) && !defined(__XC__)
+
+#endif // __xcore_c_hpp__
@@ -10,6 +10,8 @@
 #include "xcore_c_channel_streaming.h"
 #include "xcore_c_chan_impl.h"
 #include "xcore_c_exception_impl.h"
+#include "xcore_c_trace_impl.h"
+#include "xcore_c_stats_impl.h"
 
 /** Helper type for passing around both ends of a channel.
 */
@@ -76,13 +78,15 @@ inline xcore_c_error_t chan_free(channel_t *c)
  */
 inline xcore_c_error_t chan_out_word(chanend c, uint32_t data)
 {
-  RETURN_EXCEPTION_OR_ERROR(  do { \
+  _XCORE_C_TRACE(trace_chan_out, c);
+  _XCORE_C_TRACK_USE(c);
+  RETURN_EXCEPTION_OR_ERROR(  _XCORE_C_STATS_TRANSFER(c, 1, do { \
                                 _s_chan_out_ct_end(c); \
                                 _s_chan_check_ct_end(c); \
                                 _s_chan_out_word(c, data); \
                                 _s_chan_out_ct_end(c); \
                                 _s_chan_check_ct_end(c); \
-                              } while (0) );
+                              } while (0)) );
 }
 
 /** Output a byte over a channel.
@@ -100,13 +104,15 @@ inline xcore_c_error_t chan_out_word(chanend c, uint32_t data)
  */
 inline xcore_c_error_t chan_out_byte(chanend c, uint8_t data)
 {
-  RETURN_EXCEPTION_OR_ERROR(  do { \
+  _XCORE_C_TRACE(trace_chan_out, c);
+  _XCORE_C_TRACK_USE(c);
+  RETURN_EXCEPTION_OR_ERROR(  _XCORE_C_STATS_TRANSFER(c, 1, do { \
                                 _s_chan_out_ct_end(c); \
                                 _s_chan_check_ct_end(c); \
                                 _s_chan_out_byte(c, data); \
                                 _s_chan_out_ct_end(c); \
                                 _s_chan_check_ct_end(c); \
-                              } while (0) );
+                              } while (0)) );
 }
 
 /** Output a block of data over a channel.
@@ -127,7 +133,9 @@ inline xcore_c_error_t chan_out_byte(chanend c, uint8_t data)
  */
 inline xcore_c_error_t chan_out_buf_word(chanend c, const uint32_t buf[], size_t n)
 {
-  RETURN_EXCEPTION_OR_ERROR(  do { \
+  _XCORE_C_TRACE(trace_chan_out, c);
+  _XCORE_C_TRACK_USE(c);
+  RETURN_EXCEPTION_OR_ERROR(  _XCORE_C_STATS_TRANSFER(c, n, do { \
                                 _s_chan_out_ct_end(c); \
                                 _s_chan_check_ct_end(c); \
                                 for (size_t i = 0; i < n; i++) { \
@@ -135,7 +143,7 @@ inline xcore_c_error_t chan_out_buf_word(chanend c, const uint32_t buf[], size_t
                                 } \
                                 _s_chan_out_ct_end(c); \
                                 _s_chan_check_ct_end(c); \
-                              } while (0) );
+                              } while (0)) );
 }
 
 /** Output a block of data over a channel.
@@ -156,7 +164,9 @@ inline xcore_c_error_t chan_out_buf_word(chanend c, const uint32_t buf[], size_t
  */
 inline xcore_c_error_t chan_out_buf_byte(chanend c, const uint8_t buf[], size_t n)
 {
-  RETURN_EXCEPTION_OR_ERROR(  do { \
+  _XCORE_C_TRACE(trace_chan_out, c);
+  _XCORE_C_TRACK_USE(c);
+  RETURN_EXCEPTION_OR_ERROR(  _XCORE_C_STATS_TRANSFER(c, n, do { \
                                 _s_chan_out_ct_end(c); \
                                 _s_chan_check_ct_end(c); \
                                 for (size_t i = 0; i < n; i++) { \
@@ -164,7 +174,7 @@ inline xcore_c_error_t chan_out_buf_byte(chanend c, const uint8_t buf[], size_t
                                 } \
                                 _s_chan_out_ct_end(c); \
                                 _s_chan_check_ct_end(c); \
-                              } while (0) );
+                              } while (0)) );
 }
 
 /** Input a word from a channel.
@@ -182,13 +192,15 @@ inline xcore_c_error_t chan_out_buf_byte(chanend c, const uint8_t buf[], size_t
  */
 inline xcore_c_error_t chan_in_word(chanend c, uint32_t *data)
 {
-  RETURN_EXCEPTION_OR_ERROR(  do { \
+  _XCORE_C_TRACE(trace_chan_in, c);
+  _XCORE_C_TRACK_USE(c);
+  RETURN_EXCEPTION_OR_ERROR(  _XCORE_C_STATS_TRANSFER(c, 1, do { \
                                 _s_chan_check_ct_end(c); \
                                 _s_chan_out_ct_end(c); \
                                 *data = _s_chan_in_word(c); \
                                 _s_chan_check_ct_end(c); \
                                 _s_chan_out_ct_end(c); \
-                              } while (0) );
+                              } while (0)) );
 }
 
 /** Input a byte from a channel.
@@ -206,13 +218,15 @@ inline xcore_c_error_t chan_in_word(chanend c, uint32_t *data)
  */
 inline xcore_c_error_t chan_in_byte(chanend c, uint8_t *data)
 {
-  RETURN_EXCEPTION_OR_ERROR(  do { \
+  _XCORE_C_TRACE(trace_chan_in, c);
+  _XCORE_C_TRACK_USE(c);
+  RETURN_EXCEPTION_OR_ERROR(  _XCORE_C_STATS_TRANSFER(c, 1, do { \
                                 _s_chan_check_ct_end(c); \
                                 _s_chan_out_ct_end(c); \
                                 *data = _s_chan_in_byte(c); \
                                 _s_chan_check_ct_end(c); \
                                 _s_chan_out_ct_end(c); \
-                              } while (0) );
+                              } while (0)) );
 }
 
 /** Input a block of data from a channel.
@@ -232,7 +246,9 @@ inline xcore_c_error_t chan_in_byte(chanend c, uint8_t *data)
  */
 inline xcore_c_error_t chan_in_buf_word(chanend c, uint32_t buf[], size_t n)
 {
-  RETURN_EXCEPTION_OR_ERROR(  do { \
+  _XCORE_C_TRACE(trace_chan_in, c);
+  _XCORE_C_TRACK_USE(c);
+  RETURN_EXCEPTION_OR_ERROR(  _XCORE_C_STATS_TRANSFER(c, n, do { \
                                 _s_chan_check_ct_end(c);
                                 _s_chan_out_ct_end(c);
                                 for (size_t i = 0; i < n; i++) { \
@@ -240,7 +256,7 @@ inline xcore_c_error_t chan_in_buf_word(chanend c, uint32_t buf[], size_t n)
                                 } \
                                 _s_chan_check_ct_end(c);
                                 _s_chan_out_ct_end(c);
-                              } while (0) );
+                              } while (0)) );
 }
 
 /** Input a block of data from a channel.
@@ -260,7 +276,9 @@ inline xcore_c_error_t chan_in_buf_word(chanend c, uint32_t buf[], size_t n)
  */
 inline xcore_c_error_t chan_in_buf_byte(chanend c, uint8_t buf[], size_t n)
 {
-  RETURN_EXCEPTION_OR_ERROR(  do { \
+  _XCORE_C_TRACE(trace_chan_in, c);
+  _XCORE_C_TRACK_USE(c);
+  RETURN_EXCEPTION_OR_ERROR(  _XCORE_C_STATS_TRANSFER(c, n, do { \
                                 _s_chan_check_ct_end(c);
                                 _s_chan_out_ct_end(c);
                                 for (size_t i = 0; i < n; i++) { \
@@ -268,7 +286,7 @@ inline xcore_c_error_t chan_in_buf_byte(chanend c, uint8_t buf[], size_t n)
                                 } \
                                 _s_chan_check_ct_end(c);
                                 _s_chan_out_ct_end(c);
-                              } while (0) );
+                              } while (0)) );
 }
 
 #endif // !defined(__XC__)
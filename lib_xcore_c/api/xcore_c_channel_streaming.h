@@ -9,6 +9,8 @@
 #include <stddef.h>
 #include "xcore_c_chan_impl.h"
 #include "xcore_c_exception_impl.h"
+#include "xcore_c_trace_impl.h"
+#include "xcore_c_stats_impl.h"
 
 /** Helper type for passing around both ends of a streaming channel.
 */
@@ -98,7 +100,9 @@ inline xcore_c_error_t s_chan_free(streaming_channel_t *c)
  */
 inline xcore_c_error_t s_chan_out_word(streaming_chanend_t c, uint32_t data)
 {
-  RETURN_EXCEPTION_OR_ERROR( _s_chan_out_word(c, data) );
+  _XCORE_C_TRACE(trace_chan_out, c);
+  _XCORE_C_TRACK_USE(c);
+  RETURN_EXCEPTION_OR_ERROR( _XCORE_C_STATS_TRANSFER(c, 1, _s_chan_out_word(c, data)) );
 }
 
 /** Output an byte over a streaming_channel_t.
@@ -115,7 +119,9 @@ inline xcore_c_error_t s_chan_out_word(streaming_chanend_t c, uint32_t data)
  */
 inline xcore_c_error_t s_chan_out_byte(streaming_chanend_t c, uint8_t data)
 {
-  RETURN_EXCEPTION_OR_ERROR( _s_chan_out_byte(c, data) );
+  _XCORE_C_TRACE(trace_chan_out, c);
+  _XCORE_C_TRACK_USE(c);
+  RETURN_EXCEPTION_OR_ERROR( _XCORE_C_STATS_TRANSFER(c, 1, _s_chan_out_byte(c, data)) );
 }
 
 /** Output a block of data over a streaming_channel_t.
@@ -135,11 +141,13 @@ inline xcore_c_error_t s_chan_out_byte(streaming_chanend_t c, uint8_t data)
  */
 inline xcore_c_error_t s_chan_out_buf_word(streaming_chanend_t c, const uint32_t buf[], size_t n)
 {
-  RETURN_EXCEPTION_OR_ERROR(  do { \
+  _XCORE_C_TRACE(trace_chan_out, c);
+  _XCORE_C_TRACK_USE(c);
+  RETURN_EXCEPTION_OR_ERROR(  _XCORE_C_STATS_TRANSFER(c, n, do { \
                                 for (size_t i = 0; i < n; i++) { \
                                   _s_chan_out_word(c, buf[i]); \
                                 } \
-                              } while (0) );
+                              } while (0)) );
 }
 
 /** Output a block of data over a streaming_channel_t.
@@ -159,12 +167,14 @@ inline xcore_c_error_t s_chan_out_buf_word(streaming_chanend_t c, const uint32_t
  */
 inline xcore_c_error_t s_chan_out_buf_byte(streaming_chanend_t c, const uint8_t buf[], size_t n)
 {
-  RETURN_EXCEPTION_OR_ERROR(  do { \
+  _XCORE_C_TRACE(trace_chan_out, c);
+  _XCORE_C_TRACK_USE(c);
+  RETURN_EXCEPTION_OR_ERROR(  _XCORE_C_STATS_TRANSFER(c, n, do { \
                                 for (size_t i = 0; i < n; i++) { \
                                   _s_chan_out_byte(c, buf[i]); \
                                 } \
                               } \
-                              while (0) );
+                              while (0)) );
 }
 
 /** Input a word from a streaming_channel_t.
@@ -182,7 +192,9 @@ inline xcore_c_error_t s_chan_out_buf_byte(streaming_chanend_t c, const uint8_t
  */
 inline xcore_c_error_t s_chan_in_word(streaming_chanend_t c, uint32_t *data)
 {
-  RETURN_EXCEPTION_OR_ERROR( *data = _s_chan_in_word(c) );
+  _XCORE_C_TRACE(trace_chan_in, c);
+  _XCORE_C_TRACK_USE(c);
+  RETURN_EXCEPTION_OR_ERROR( _XCORE_C_STATS_TRANSFER(c, 1, *data = _s_chan_in_word(c)) );
 }
 
 /** Input a byte from a streaming_channel_t.
@@ -200,7 +212,9 @@ inline xcore_c_error_t s_chan_in_word(streaming_chanend_t c, uint32_t *data)
  */
 inline xcore_c_error_t s_chan_in_byte(streaming_chanend_t c, uint8_t *data)
 {
-  RETURN_EXCEPTION_OR_ERROR( *data = _s_chan_in_byte(c) );
+  _XCORE_C_TRACE(trace_chan_in, c);
+  _XCORE_C_TRACK_USE(c);
+  RETURN_EXCEPTION_OR_ERROR( _XCORE_C_STATS_TRANSFER(c, 1, *data = _s_chan_in_byte(c)) );
 }
 
 /** Input a block of data from a streaming_channel_t.
@@ -220,11 +234,13 @@ inline xcore_c_error_t s_chan_in_byte(streaming_chanend_t c, uint8_t *data)
  */
 inline xcore_c_error_t s_chan_in_buf_word(streaming_chanend_t c, uint32_t buf[], size_t n)
 {
-  RETURN_EXCEPTION_OR_ERROR(  do { \
+  _XCORE_C_TRACE(trace_chan_in, c);
+  _XCORE_C_TRACK_USE(c);
+  RETURN_EXCEPTION_OR_ERROR(  _XCORE_C_STATS_TRANSFER(c, n, do { \
                                 for (size_t i = 0; i < n; i++) { \
                                   buf[i] = _s_chan_in_word(c); \
                                 } \
-                              } while (0) );
+                              } while (0)) );
 }
 
 /** Input a block of data from a streaming_channel_t.
@@ -244,11 +260,13 @@ inline xcore_c_error_t s_chan_in_buf_word(streaming_chanend_t c, uint32_t buf[],
  */
 inline xcore_c_error_t s_chan_in_buf_byte(streaming_chanend_t c, uint8_t buf[], size_t n)
 {
-  RETURN_EXCEPTION_OR_ERROR(  do { \
+  _XCORE_C_TRACE(trace_chan_in, c);
+  _XCORE_C_TRACK_USE(c);
+  RETURN_EXCEPTION_OR_ERROR(  _XCORE_C_STATS_TRANSFER(c, n, do { \
                                 for (size_t i = 0; i < n; i++) { \
                                   buf[i] = _s_chan_in_byte(c); \
                                 } \
-                              } while (0) );
+                              } while (0)) );
 }
 
 /** Output a control token onto a streaming_channel_t.
@@ -129,10 +129,12 @@ inline xcore_c_error_t chan_complete_transaction(chanend *c, transacting_chanend
  */
 inline xcore_c_error_t t_chan_out_word(transacting_chanend_t *tc, uint32_t data)
 {
-  RETURN_EXCEPTION_OR_ERROR(  do { \
+  _XCORE_C_TRACE(trace_chan_out, tc->c);
+  _XCORE_C_TRACK_USE(tc->c);
+  RETURN_EXCEPTION_OR_ERROR(  _XCORE_C_STATS_TRANSFER(tc->c, 1, do { \
                                 _t_chan_change_to_output(tc); \
                                 _s_chan_out_word(tc->c, data); \
-                              } while (0) );
+                              } while (0)) );
 }
 
 /** Output an byte over a transacting chan-end.
@@ -150,10 +152,12 @@ inline xcore_c_error_t t_chan_out_word(transacting_chanend_t *tc, uint32_t data)
  */
 inline xcore_c_error_t t_chan_out_byte(transacting_chanend_t *tc, uint8_t data)
 {
-  RETURN_EXCEPTION_OR_ERROR(  do { \
+  _XCORE_C_TRACE(trace_chan_out, tc->c);
+  _XCORE_C_TRACK_USE(tc->c);
+  RETURN_EXCEPTION_OR_ERROR(  _XCORE_C_STATS_TRANSFER(tc->c, 1, do { \
                                 _t_chan_change_to_output(tc); \
                                 _s_chan_out_byte(tc->c, data); \
-                              } while (0) );
+                              } while (0)) );
 }
 
 /** Output a block of data over a transacting chan-end.
@@ -172,12 +176,14 @@ inline xcore_c_error_t t_chan_out_byte(transacting_chanend_t *tc, uint8_t data)
  */
 inline xcore_c_error_t t_chan_out_buf_word(transacting_chanend_t *tc, const uint32_t buf[], size_t n)
 {
-  RETURN_EXCEPTION_OR_ERROR(  do { \
+  _XCORE_C_TRACE(trace_chan_out, tc->c);
+  _XCORE_C_TRACK_USE(tc->c);
+  RETURN_EXCEPTION_OR_ERROR(  _XCORE_C_STATS_TRANSFER(tc->c, n, do { \
                                 _t_chan_change_to_output(tc); \
                                 for (size_t i = 0; i < n; i++) { \
                                   _s_chan_out_word(tc->c, buf[i]); \
                                 } \
-                              } while (0) );
+                              } while (0)) );
 }
 
 /** Output a block of data over a transacting chan-end.
@@ -196,12 +202,14 @@ inline xcore_c_error_t t_chan_out_buf_word(transacting_chanend_t *tc, const uint
  */
 inline xcore_c_error_t t_chan_out_buf_byte(transacting_chanend_t *tc, const uint8_t buf[], size_t n)
 {
-  RETURN_EXCEPTION_OR_ERROR(  do { \
+  _XCORE_C_TRACE(trace_chan_out, tc->c);
+  _XCORE_C_TRACK_USE(tc->c);
+  RETURN_EXCEPTION_OR_ERROR(  _XCORE_C_STATS_TRANSFER(tc->c, n, do { \
                                 _t_chan_change_to_output(tc); \
                                 for (size_t i = 0; i < n; i++) { \
                                   _s_chan_out_byte(tc->c, buf[i]); \
                                 } \
-                              } while (0) );
+                              } while (0)) );
 }
 
 /** Input a word from a transacting chan-end.
@@ -219,10 +227,12 @@ inline xcore_c_error_t t_chan_out_buf_byte(transacting_chanend_t *tc, const uint
  */
 inline xcore_c_error_t t_chan_in_word(transacting_chanend_t *tc, uint32_t *data)
 {
-  RETURN_EXCEPTION_OR_ERROR(  do { \
+  _XCORE_C_TRACE(trace_chan_in, tc->c);
+  _XCORE_C_TRACK_USE(tc->c);
+  RETURN_EXCEPTION_OR_ERROR(  _XCORE_C_STATS_TRANSFER(tc->c, 1, do { \
                                 _t_chan_change_to_input(tc); \
                                 *data = _s_chan_in_word(tc->c); \
-                              } while (0) );
+                              } while (0)) );
 }
 
 /** Input a byte from a transacting chan-end.
@@ -240,10 +250,12 @@ inline xcore_c_error_t t_chan_in_word(transacting_chanend_t *tc, uint32_t *data)
  */
 inline xcore_c_error_t t_chan_in_byte(transacting_chanend_t *tc, uint8_t *data)
 {
-  RETURN_EXCEPTION_OR_ERROR(  do { \
+  _XCORE_C_TRACE(trace_chan_in, tc->c);
+  _XCORE_C_TRACK_USE(tc->c);
+  RETURN_EXCEPTION_OR_ERROR(  _XCORE_C_STATS_TRANSFER(tc->c, 1, do { \
                                 _t_chan_change_to_input(tc); \
                                 *data = _s_chan_in_byte(tc->c); \
-                              } while (0) );
+                              } while (0)) );
 }
 
 /** Input a block of data from a transacting chan-end.
@@ -262,12 +274,14 @@ inline xcore_c_error_t t_chan_in_byte(transacting_chanend_t *tc, uint8_t *data)
  */
 inline xcore_c_error_t t_chan_in_buf_word(transacting_chanend_t *tc, uint32_t buf[], size_t n)
 {
-  RETURN_EXCEPTION_OR_ERROR(  do { \
+  _XCORE_C_TRACE(trace_chan_in, tc->c);
+  _XCORE_C_TRACK_USE(tc->c);
+  RETURN_EXCEPTION_OR_ERROR(  _XCORE_C_STATS_TRANSFER(tc->c, n, do { \
                                 _t_chan_change_to_input(tc); \
                                 for (size_t i = 0; i < n; i++) { \
                                   buf[i] = _s_chan_in_word(tc->c); \
                                 } \
-                              } while (0) );
+                              } while (0)) );
 }
 
 /** Input a block of data from a transacting chan-end.
@@ -286,12 +300,14 @@ inline xcore_c_error_t t_chan_in_buf_word(transacting_chanend_t *tc, uint32_t bu
  */
 inline xcore_c_error_t t_chan_in_buf_byte(transacting_chanend_t *tc, uint8_t buf[], size_t n)
 {
-  RETURN_EXCEPTION_OR_ERROR(  do { \
+  _XCORE_C_TRACE(trace_chan_in, tc->c);
+  _XCORE_C_TRACK_USE(tc->c);
+  RETURN_EXCEPTION_OR_ERROR(  _XCORE_C_STATS_TRANSFER(tc->c, n, do { \
                                 _t_chan_change_to_input(tc); \
                                 for (size_t i = 0; i < n; i++) { \
                                   buf[i] = _s_chan_in_byte(tc->c); \
                                 } \
-                              } while (0) );
+                              } while (0)) );
 }
 
 #endif // !defined(__XC__)
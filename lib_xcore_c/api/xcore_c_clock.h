@@ -79,7 +79,7 @@ inline xcore_c_error_t clock_free(clock *clk)
  */
 inline xcore_c_error_t clock_start(clock clk)
 {
-  RETURN_EXCEPTION_OR_ERROR( _RESOURCE_SETCI(clk, XS1_SETC_RUN_STARTR) );
+  RETURN_EXCEPTION_OR_ERROR( _clock_start(clk) );
 }
 
 /** Stop a clock
@@ -95,7 +95,7 @@ inline xcore_c_error_t clock_start(clock clk)
  */
 inline xcore_c_error_t clock_stop(clock clk)
 {
-  RETURN_EXCEPTION_OR_ERROR( _RESOURCE_SETCI(clk, XS1_SETC_RUN_STOPR) );
+  RETURN_EXCEPTION_OR_ERROR( _clock_stop(clk) );
 }
 
 /** Configure a clock's source to a 1-bit port
@@ -118,7 +118,7 @@ inline xcore_c_error_t clock_stop(clock clk)
  */
 inline xcore_c_error_t clock_set_source_port(clock clk, port p)
 {
-  RETURN_EXCEPTION_OR_ERROR( asm volatile("setclk res[%0], %1" :: "r" (clk), "r" (p)) );
+  RETURN_EXCEPTION_OR_ERROR( _clock_set_source_port(clk, p) );
 }
 
 /** Configure a clock's source to be the 100MHz reference clock
@@ -133,7 +133,11 @@ inline xcore_c_error_t clock_set_source_port(clock clk, port p)
  */
 inline xcore_c_error_t clock_set_source_clk_ref(clock clk)
 {
+#if XCORE_C_HOST
+  RETURN_EXCEPTION_OR_ERROR( _host_setclk(clk, XS1_CLK_REF) );
+#else
   RETURN_EXCEPTION_OR_ERROR( asm volatile("setclk res[%0], %1" :: "r" (clk), "r" (XS1_CLK_REF)) );
+#endif
 }
 
 /** Configure a clock's source to be the xCORE clock.
@@ -151,7 +155,11 @@ inline xcore_c_error_t clock_set_source_clk_ref(clock clk)
  */
 inline xcore_c_error_t clock_set_source_clk_xcore(clock clk)
 {
+#if XCORE_C_HOST
+  RETURN_EXCEPTION_OR_ERROR( _host_setclk(clk, XS1_CLK_XCORE) );
+#else
   RETURN_EXCEPTION_OR_ERROR( asm volatile("setclk res[%0], %1" :: "r" (clk), "r" (XS1_CLK_XCORE)) );
+#endif
 }
 
 /** Configure the divider for a clock.
@@ -178,7 +186,11 @@ inline xcore_c_error_t clock_set_source_clk_xcore(clock clk)
  */
 inline xcore_c_error_t clock_set_divide(clock clk, uint8_t divide)
 {
+#if XCORE_C_HOST
+  RETURN_EXCEPTION_OR_ERROR( _host_setd(clk, divide) );
+#else
   RETURN_EXCEPTION_OR_ERROR( asm volatile("setd res[%0], %1" :: "r" (clk), "r" (divide)) );
+#endif
 }
 
 /** Sets a clock to use a 1-bit port for the ready-in signal.
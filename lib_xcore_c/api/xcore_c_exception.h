@@ -0,0 +1,139 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+
+#ifndef __xcore_c_exception_h__
+#define __xcore_c_exception_h__
+
+#if !defined(__XC__) || defined(__DOXYGEN__)
+
+#include "xcore_c_exception_impl.h"
+#include "xassert.h"
+
+/** Run a block of library calls, catching any exception they raise.
+ *
+ *  With the XCORE_C_NO_EXCEPTION policy every library call sets up a TRY of
+ *  its own, which costs more than many of the calls themselves. Within an
+ *  error scope the calls set up none, so one TRY covers the whole block.
+ *  If a call raises an exception the rest of the block is skipped and
+ *  *error* is set to the exception's type, otherwise it is set to error_none.
+ *  It may be used whatever the exception policy, and may be nested.
+ *
+ *  The block may contain any statements, but must not leave the scope by a
+ *  return, break, continue or goto. As with setjmp(), a local variable which
+ *  is changed in the block and read after an exception must be volatile. The
+ *  scope does not extend into interrupt callbacks taken while it runs.
+ *
+ *  Example::
+ *
+ *    xcore_c_error_t error;
+ *    ERROR_SCOPE(error, {
+ *      chan_out_word(c, header);
+ *      chan_out_buf_word(c, data, n);
+ *      port_out(p, 1);
+ *    });
+ *    if (error) { ... }
+ *
+ *  \param error  An xcore_c_error_t variable, set to the result of the block
+ *  \param ...    The block of statements
+ */
+#define ERROR_SCOPE(error, ...) \
+  do { \
+    exception_t _error_scope_exception; \
+    (error) = error_none; \
+    _error_scope_enter(); \
+    TRY { \
+      __VA_ARGS__ ; \
+    } \
+    CATCH(_error_scope_exception) { \
+      (error) = (xcore_c_error_t)_error_scope_exception.type; \
+    } \
+    _error_scope_exit(); \
+  } while (0)
+
+/** Run a block of library calls, handling any exception raised by resuming
+ *  from the start of the block.
+ *
+ *  The block is run as an ERROR_SCOPE(), so the calls within it carry no
+ *  exception checks of their own. If a call raises an exception, the handler
+ *  the logical core registered for its type using exception_set_handler() is
+ *  called. The handler may log the exception and reset the resource
+ *  identified by the exception's data, then return non-zero to run the block
+ *  again from its start. If there is no handler, or it returns zero, the
+ *  recovery point is left with *error* set to the exception's type.
+ *  Otherwise, when the block completes, *error* is set to error_none.
+ *
+ *  This allows a logical core's main loop to survive faults, with no cost to
+ *  each call it makes. The block must not leave the recovery point by a
+ *  return, break, continue or goto.
+ *
+ *  Example::
+ *
+ *    xcore_c_error_t error;
+ *    exception_set_handler(error_illegal_resource, reset_resource, &state);
+ *    EXCEPTION_RECOVERY_POINT(error, {
+ *      setup(&state);
+ *      for (;;) {
+ *        ...
+ *      }
+ *    });
+ *
+ *  \param error  An xcore_c_error_t variable, set to the result of the block
+ *  \param ...    The block of statements
+ */
+#define EXCEPTION_RECOVERY_POINT(error, ...) \
+  do { \
+    int _error_recovery_resume; \
+    do { \
+      exception_t _error_recovery_exception; \
+      (error) = error_none; \
+      _error_recovery_resume = 0; \
+      _error_scope_enter(); \
+      TRY { \
+        __VA_ARGS__ ; \
+      } \
+      CATCH(_error_recovery_exception) { \
+        (error) = (xcore_c_error_t)_error_recovery_exception.type; \
+        _error_scope_exit(); \
+        _error_recovery_resume = _exception_dispatch(_error_recovery_exception); \
+        _error_scope_enter(); \
+      } \
+      _error_scope_exit(); \
+    } while (_error_recovery_resume); \
+  } while (0)
+
+/** Register the logical core's handler for a type of exception.
+ *
+ *  The handler is called when an exception of the type is raised within an
+ *  EXCEPTION_RECOVERY_POINT() on the logical core which registered it. It
+ *  replaces any handler registered for the type before.
+ *
+ *  \param type     The exception type, error_link_error to error_resource_dep
+ *  \param handler  The handler to call
+ *  \param data     The user data passed to the handler
+ *
+ *  \return     error_none (or exception type if policy is XCORE_C_NO_EXCEPTION).
+ *
+ *  \exception  ET_ECALL              when xassert enabled, an invalid exception type.
+ */
+inline xcore_c_error_t exception_set_handler(xcore_c_error_t type, exception_handler_t handler, void *data)
+{
+  xassert(type != error_none && type < _XCORE_C_EXCEPTION_TYPES && msg("Exception type has no handler"));
+  RETURN_EXCEPTION_OR_ERROR( _exception_set_handler(type, handler, data) );
+}
+
+/** Remove the logical core's handler for a type of exception.
+ *
+ *  \param type  The exception type, error_link_error to error_resource_dep
+ *
+ *  \return     error_none (or exception type if policy is XCORE_C_NO_EXCEPTION).
+ *
+ *  \exception  ET_ECALL              when xassert enabled, an invalid exception type.
+ */
+inline xcore_c_error_t exception_clear_handler(xcore_c_error_t type)
+{
+  xassert(type != error_none && type < _XCORE_C_EXCEPTION_TYPES && msg("Exception type has no handler"));
+  RETURN_EXCEPTION_OR_ERROR( _exception_set_handler(type, 0, 0) );
+}
+
+#endif // !defined(__XC__)
+
+#endif // __xcore_c_exception_h__
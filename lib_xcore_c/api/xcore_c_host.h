@@ -0,0 +1,145 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+
+#ifndef __xcore_c_host_h__
+#define __xcore_c_host_h__
+
+#include "xcore_c_host_impl.h"
+
+#ifndef XCORE_C_HOST
+/** Build the library for the host backend.
+ *
+ *  The user may build the library, and the application, to run natively on
+ *  the host by setting the XCORE_C_HOST define to 1. The xCORE resources are
+ *  then emulated, with each logical core run as a thread. When it is 0 (the
+ *  default) the library targets the xCORE.
+ */
+#define XCORE_C_HOST 0
+#endif
+
+#ifndef XCORE_C_HOST_SIM
+/** Schedule the logical cores deterministically on the host.
+ *
+ *  When building for the host backend the user may set the XCORE_C_HOST_SIM
+ *  define to 1, to run the logical cores as fibers on the thread which calls
+ *  host_par() rather than as threads. Only one core runs at a time, switching
+ *  between cores only within the library. After each call into the library,
+ *  which core runs next is picked pseudo-randomly, as is the time each channel
+ *  token takes to arrive. Running with the same seed (see host_sim_seed())
+ *  reproduces the interleaving exactly, and running with many seeds tests many
+ *  interleavings.
+ *
+ *  A logical core must not wait for another by polling memory, as the other
+ *  core does not run until it calls the library.
+ */
+#define XCORE_C_HOST_SIM 0
+#endif
+
+#if XCORE_C_HOST || defined(__DOXYGEN__)
+
+#include <stddef.h>
+#include <stdint.h>
+#include <xccompat.h>
+#include "xcore_c_exception_impl.h"
+
+/** Run logical cores in parallel on the host.
+ *
+ *  This is the host equivalent of a par statement. Each function is called
+ *  on a logical core of its own, and this function returns once they have all
+ *  returned. The calling thread is a logical core itself, with identity 0 if
+ *  it is the first to use the library. At most 8 logical cores may run at once.
+ *
+ *  \param cores  The functions to run, each with its argument
+ *  \param n      The number of functions in *cores[]*
+ *
+ *  \exception  ET_ECALL              more than 8 logical cores.
+ */
+void host_par(const host_core_t cores[], size_t n);
+
+#if XCORE_C_HOST_SIM || defined(__DOXYGEN__)
+
+/** Seed the deterministic scheduler.
+ *
+ *  Only available when XCORE_C_HOST_SIM is set. The seed picks the
+ *  interleaving of the logical cores, and the channel latencies, from here on.
+ *  It is reported with any deadlock or unhandled exception, so that the
+ *  failure can be replayed. The default seed is 0.
+ *
+ *  The virtual time is restarted from 0, so that running with a seed behaves
+ *  the same wherever it is done. It must be called while no other logical
+ *  core is running.
+ *
+ *  \param seed  The seed
+ */
+void host_sim_seed(uint32_t seed);
+
+#endif // XCORE_C_HOST_SIM || defined(__DOXYGEN__)
+
+/** Connect the pins of two ports on the host.
+ *
+ *  Data input from port *to* is that output by port *from*, so two ports can
+ *  be looped back to each other as they are on a test board. Each port's pins
+ *  may be driven by one other port. The ports need not be allocated.
+ *
+ *  \param from  The port driving the pins
+ *  \param to    The port inputting from the pins
+ *
+ *  \return     error_none (or exception type if policy is XCORE_C_NO_EXCEPTION).
+ *
+ *  \exception  ET_ILLEGAL_RESOURCE   not a valid port.
+ */
+inline xcore_c_error_t host_port_connect(port from, port to)
+{
+  RETURN_EXCEPTION_OR_ERROR( _host_port_connect(from, to) );
+}
+
+/** Drive the pins of a port on the host from a stimulus file.
+ *
+ *  The file is in a subset of the Value Change Dump (VCD) format, as written
+ *  by logic analysers and simulators, and by host_port_trace(). The value
+ *  changes of the first variable declared are loaded, with the time of each
+ *  measured from when this function is called. Vector ('b') and scalar value
+ *  changes are supported, with 'x' and 'z' bits read as 0. Before the first
+ *  change the pins are 0.
+ *
+ *  This replaces any connection of the port's pins made by host_port_connect().
+ *  The port need not be allocated. The application exits, reporting the line
+ *  at fault, if the file cannot be read.
+ *
+ *  \param p         The port whose pins are driven
+ *  \param filename  The stimulus file, or NULL to stop driving the pins
+ *
+ *  \return     error_none (or exception type if policy is XCORE_C_NO_EXCEPTION).
+ *
+ *  \exception  ET_ILLEGAL_RESOURCE   not a valid port.
+ */
+inline xcore_c_error_t host_port_stimulus(port p, const char *filename)
+{
+  RETURN_EXCEPTION_OR_ERROR( _host_port_stimulus(p, filename) );
+}
+
+/** Capture the data output on the pins of a port on the host to a trace file.
+ *
+ *  Each change of the value output on the port's pins is recorded, with its
+ *  time in nanoseconds since this function was called. The trace is
+ *  written in the Value Change Dump (VCD) format, to be viewed with a waveform
+ *  viewer or used as a stimulus file, when tracing is stopped or the
+ *  application exits. Tracing a port again stops its previous trace.
+ *
+ *  The port need not be allocated. The application exits if the file cannot
+ *  be created.
+ *
+ *  \param p         The port whose output is traced
+ *  \param filename  The trace file, or NULL to stop tracing
+ *
+ *  \return     error_none (or exception type if policy is XCORE_C_NO_EXCEPTION).
+ *
+ *  \exception  ET_ILLEGAL_RESOURCE   not a valid port.
+ */
+inline xcore_c_error_t host_port_trace(port p, const char *filename)
+{
+  RETURN_EXCEPTION_OR_ERROR( _host_port_trace(p, filename) );
+}
+
+#endif // XCORE_C_HOST || defined(__DOXYGEN__)
+
+#endif // __xcore_c_host_h__
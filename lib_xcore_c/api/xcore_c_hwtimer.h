@@ -10,6 +10,29 @@
 #include "xcore_c_resource_impl.h"
 #include "xcore_c_exception_impl.h"
 
+#ifndef XCORE_C_DELAY_OVERHEAD_TICKS
+/** Specify the fixed cost, in reference time ticks, of a hwtimer_core_delay() call.
+ *
+ *  The delay period is measured from the point at which hwtimer_core_delay()
+ *  reads the time, so most of the cost of setting up the delay is already
+ *  included. This define accounts for the remainder, which depends upon the
+ *  core clock frequency and the number of active logical cores.
+ *  It is subtracted from each requested period.
+ *
+ *  The user may measure it using hwtimer_core_delay_calibrate() and set the
+ *  XCORE_C_DELAY_OVERHEAD_TICKS define in their Makefile.
+ */
+#define XCORE_C_DELAY_OVERHEAD_TICKS 0
+#endif
+
+#ifndef XCORE_C_SPIN_OVERHEAD_TICKS
+/** Specify the fixed cost, in reference time ticks, of a hwtimer_core_spin() call.
+ *
+ *  As XCORE_C_DELAY_OVERHEAD_TICKS, but for hwtimer_core_spin().
+ */
+#define XCORE_C_SPIN_OVERHEAD_TICKS 0
+#endif
+
 /** Deallocate the xC timer resource for a thread
  *
  *  This function deallcoates the hardware timer automatically allocated
@@ -106,6 +129,7 @@ inline xcore_c_error_t hwtimer_free(hwtimer_t *t)
  */
 inline xcore_c_error_t hwtimer_get_time(hwtimer_t t, uint32_t *now)
 {
+  _XCORE_C_TRACK_USE(t);
   RETURN_EXCEPTION_OR_ERROR( _hwtimer_get_time(t, now) );
 }
 
@@ -129,6 +153,7 @@ inline xcore_c_error_t hwtimer_get_time(hwtimer_t t, uint32_t *now)
  */
 inline xcore_c_error_t hwtimer_set_trigger_time(hwtimer_t t, uint32_t time)
 {
+  _XCORE_C_TRACK_USE(t);
   RETURN_EXCEPTION_OR_ERROR( _hwtimer_set_trigger_time(t, time) );
 }
 
@@ -148,6 +173,7 @@ inline xcore_c_error_t hwtimer_set_trigger_time(hwtimer_t t, uint32_t time)
  */
 inline xcore_c_error_t hwtimer_change_trigger_time(hwtimer_t t, uint32_t time)
 {
+  _XCORE_C_TRACK_USE(t);
   RETURN_EXCEPTION_OR_ERROR( _hwtimer_change_trigger_time(t, time) );
 }
 
@@ -167,6 +193,7 @@ inline xcore_c_error_t hwtimer_change_trigger_time(hwtimer_t t, uint32_t time)
 
 inline xcore_c_error_t hwtimer_clear_trigger_time(hwtimer_t t)
 {
+  _XCORE_C_TRACK_USE(t);
   RETURN_EXCEPTION_OR_ERROR( _hwtimer_clear_trigger_time(t) );
 }
 
@@ -186,6 +213,7 @@ inline xcore_c_error_t hwtimer_clear_trigger_time(hwtimer_t t)
  */
 inline xcore_c_error_t hwtimer_wait_until(hwtimer_t t, uint32_t until, uint32_t *now)
 {
+  _XCORE_C_TRACK_USE(t);
   RETURN_EXCEPTION_OR_ERROR(  do { \
                                 _hwtimer_set_trigger_time(t, until); \
                                 _hwtimer_get_time(t, now); \
@@ -208,6 +236,7 @@ inline xcore_c_error_t hwtimer_wait_until(hwtimer_t t, uint32_t until, uint32_t
  */
 inline xcore_c_error_t hwtimer_delay(hwtimer_t t, uint32_t period)
 {
+  _XCORE_C_TRACK_USE(t);
   RETURN_EXCEPTION_OR_ERROR(  do { \
                                 uint32_t start; \
                                 _hwtimer_get_time(t, &start); \
@@ -340,6 +369,277 @@ inline xcore_c_error_t hwtimer_disable_trigger(hwtimer_t t)
   RETURN_EXCEPTION_OR_ERROR( _resource_disable_trigger(t) );
 }
 
+/** Get the current time without allocating a timer.
+ *
+ *  On XS2 the time is read directly from the reference clock. On XS1 the
+ *  logical core's xC timer is read and any trigger set on it is cleared,
+ *  except that the trigger of a hwtimer_core_wait_until() interrupted by the
+ *  caller is restored, so it is safe to use from an interrupt handler.
+ *
+ *  **On XS1 the xC timer must not have been deallocated by
+ *  hwtimer_free_xc_timer()**
+ *
+ *  \param now  The time value (a 32-bit value)
+ *
+ *  \return     error_none (or exception type if policy is XCORE_C_NO_EXCEPTION).
+ *
+ *  \exception  ET_LOAD_STORE         invalid *\*now* argument.
+ */
+inline xcore_c_error_t hwtimer_core_get_time(uint32_t *now)
+{
+  RETURN_EXCEPTION_OR_ERROR( *now = _hwtimer_core_get_time() );
+}
+
+/** Wait until after a specified time using the logical core's xC timer.
+ *
+ *  This pauses the logical core, allowing the other logical cores to use its
+ *  issue slots, but the core will take a few cycles to resume once the time
+ *  is reached. Use hwtimer_core_spin_until() when the exit time must be exact.
+ *
+ *  **The xC timer must not have been deallocated by hwtimer_free_xc_timer()
+ *  and must not be in use by an xC select**
+ *
+ *  \param until  The time to wait until
+ *
+ *  \return     error_none (or exception type if policy is XCORE_C_NO_EXCEPTION).
+ *
+ *  \exception  ET_ILLEGAL_RESOURCE   the xC timer has been deallocated.
+ */
+inline xcore_c_error_t hwtimer_core_wait_until(uint32_t until)
+{
+  RETURN_EXCEPTION_OR_ERROR( _hwtimer_core_wait_until(until) );
+}
+
+/** Delay for a specified time using the logical core's xC timer.
+ *
+ *  The delay is measured from the start of the call and is shortened by
+ *  XCORE_C_DELAY_OVERHEAD_TICKS, so successive calls produce the requested
+ *  timing. See hwtimer_core_wait_until() for the conditions of use.
+ *
+ *  \param period The amount of time to wait (in reference time ticks, usually 10ns steps)
+ *
+ *  \return     error_none (or exception type if policy is XCORE_C_NO_EXCEPTION).
+ *
+ *  \exception  ET_ILLEGAL_RESOURCE   the xC timer has been deallocated.
+ */
+inline xcore_c_error_t hwtimer_core_delay(uint32_t period)
+{
+  RETURN_EXCEPTION_OR_ERROR(  do { \
+                                uint32_t start = _hwtimer_core_get_time(); \
+                                if (period > XCORE_C_DELAY_OVERHEAD_TICKS) { \
+                                  _hwtimer_core_wait_until(start + period - XCORE_C_DELAY_OVERHEAD_TICKS); \
+                                } \
+                              } while (0) );
+}
+
+/** Busy-wait until after a specified time.
+ *
+ *  The logical core polls the time rather than pausing, so it will continue
+ *  within a few instructions of the time being reached, at the cost of using
+ *  its issue slots for the duration of the wait.
+ *
+ *  **On XS1 the xC timer must not have been deallocated by
+ *  hwtimer_free_xc_timer()**
+ *
+ *  \param until  The time to wait until
+ *
+ *  \return     error_none (or exception type if policy is XCORE_C_NO_EXCEPTION).
+ *
+ *  \exception  ET_ILLEGAL_RESOURCE   on XS1, the xC timer has been deallocated.
+ */
+inline xcore_c_error_t hwtimer_core_spin_until(uint32_t until)
+{
+  RETURN_EXCEPTION_OR_ERROR( _hwtimer_core_spin_until(until) );
+}
+
+/** Busy-wait for a specified time.
+ *
+ *  The delay is measured from the start of the call and is shortened by
+ *  XCORE_C_SPIN_OVERHEAD_TICKS. See hwtimer_core_spin_until() for details.
+ *
+ *  \param period The amount of time to wait (in reference time ticks, usually 10ns steps)
+ *
+ *  \return     error_none (or exception type if policy is XCORE_C_NO_EXCEPTION).
+ *
+ *  \exception  ET_ILLEGAL_RESOURCE   on XS1, the xC timer has been deallocated.
+ */
+inline xcore_c_error_t hwtimer_core_spin(uint32_t period)
+{
+  RETURN_EXCEPTION_OR_ERROR(  do { \
+                                uint32_t start = _hwtimer_core_get_time(); \
+                                if (period > XCORE_C_SPIN_OVERHEAD_TICKS) { \
+                                  _hwtimer_core_spin_until(start + period - XCORE_C_SPIN_OVERHEAD_TICKS); \
+                                } \
+                              } while (0) );
+}
+
+/** Measure the fixed cost of hwtimer_core_delay() and hwtimer_core_spin().
+ *
+ *  Times minimum length delays and returns the smallest cost observed.
+ *  The results do not depend upon the current values of XCORE_C_DELAY_OVERHEAD_TICKS
+ *  and XCORE_C_SPIN_OVERHEAD_TICKS, and are the values they should be set to.
+ *  They should be measured with the same core clock frequency, number of
+ *  active logical cores and optimisation level as the final application.
+ *
+ *  \param delay_overhead  The value for XCORE_C_DELAY_OVERHEAD_TICKS
+ *  \param spin_overhead   The value for XCORE_C_SPIN_OVERHEAD_TICKS
+ *
+ *  \return     error_none (or exception type if policy is XCORE_C_NO_EXCEPTION).
+ *
+ *  \exception  ET_ILLEGAL_RESOURCE   the xC timer has been deallocated.
+ *  \exception  ET_LOAD_STORE         invalid *\*delay_overhead* or *\*spin_overhead* argument.
+ */
+xcore_c_error_t hwtimer_core_delay_calibrate(uint32_t *delay_overhead, uint32_t *spin_overhead);
+
+/** Initialise a periodic timer.
+ *
+ *  A periodic timer generates events at exact multiples of period from the
+ *  time of initialisation. Each deadline is calculated from the previous
+ *  deadline rather than from when the event was handled, so event latency
+ *  does not accumulate as drift.
+ *
+ *  The first event is armed for one period from now.
+ *  The timer remains owned by the caller, who must enable triggers on it using
+ *  hwtimer_enable_trigger() after one of the hwtimer_periodic_setup_*()
+ *  functions has been called, and free it when no longer required.
+ *
+ *  \param pt       The periodic timer to initialise
+ *  \param t        An allocated timer to use
+ *  \param period   The period of the events in reference time ticks
+ *                  (usually 10ns steps). Must be non-zero.
+ *
+ *  \return     error_none (or exception type if policy is XCORE_C_NO_EXCEPTION).
+ *
+ *  \exception  ET_ILLEGAL_RESOURCE   not an allocated timer.
+ *  \exception  ET_RESOURCE_DEP       another core is actively using the timer.
+ *  \exception  ET_LOAD_STORE         invalid *\*pt* argument.
+ */
+inline xcore_c_error_t hwtimer_periodic_init(hwtimer_periodic_t *pt, hwtimer_t t, uint32_t period)
+{
+  RETURN_EXCEPTION_OR_ERROR( _hwtimer_periodic_init(pt, t, period) );
+}
+
+/** Setup select events on a periodic timer.
+ *
+ *  Same as hwtimer_setup_select() except that the trigger time is the next
+ *  deadline of the periodic timer.
+ *
+ *  \param pt       The periodic timer to setup the select event on
+ *  \param enum_id  The value to be returned by select_wait() et al when the
+ *                  timer event is triggered.
+ *
+ *  \return     error_none (or exception type if policy is XCORE_C_NO_EXCEPTION).
+ *
+ *  \exception  ET_ILLEGAL_RESOURCE   not a valid timer.
+ *  \exception  ET_RESOURCE_DEP       another core is actively using the timer.
+ *  \exception  ET_LOAD_STORE         invalid *\*pt* argument.
+ *  \exception  ET_ECALL              when xassert enabled, on XS1 bit 16 not set in enum_id.
+ */
+inline xcore_c_error_t hwtimer_periodic_setup_select(hwtimer_periodic_t *pt, uint32_t enum_id)
+{
+  RETURN_EXCEPTION_OR_ERROR(  do { \
+                                _resource_setup_select(pt->t, enum_id); \
+                                _hwtimer_set_trigger_time(pt->t, pt->next); \
+                              } while (0) );
+}
+
+/** Setup select events on a periodic timer where the events are handled by a function.
+ *
+ *  Same as hwtimer_setup_select_callback() except that the trigger time is the
+ *  next deadline of the periodic timer.
+ *  The select_callback_t function must call hwtimer_periodic_rearm() each
+ *  time it runs, to clear the event and arm the next.
+ *
+ *  \param pt     The periodic timer to setup the select event on
+ *  \param data   The value to be passed to the select_callback_t function
+ *  \param func   The select_callback_t function to handle the event
+ *
+ *  \return     error_none (or exception type if policy is XCORE_C_NO_EXCEPTION).
+ *
+ *  \exception  ET_ILLEGAL_RESOURCE   not a valid timer.
+ *  \exception  ET_RESOURCE_DEP       another core is actively using the timer.
+ *  \exception  ET_LOAD_STORE         invalid *\*pt* argument.
+ *  \exception  ET_ECALL              when xassert enabled, on XS1 bit 16 not set in data.
+ */
+inline xcore_c_error_t
+hwtimer_periodic_setup_select_callback(hwtimer_periodic_t *pt, void *data, select_callback_t func)
+{
+  RETURN_EXCEPTION_OR_ERROR(  do { \
+                                _resource_setup_select_callback(pt->t, data, func); \
+                                _hwtimer_set_trigger_time(pt->t, pt->next); \
+                              } while (0) );
+}
+
+/** Setup interrupt events on a periodic timer.
+ *
+ *  Same as hwtimer_setup_interrupt_callback() except that the trigger time is
+ *  the next deadline of the periodic timer.
+ *  The interrupt_callback_t function must call hwtimer_periodic_rearm() each
+ *  time it runs, to clear the event and arm the next.
+ *
+ *  \param pt     The periodic timer to setup the interrupt event on
+ *  \param data   The value to be passed to the interrupt_callback_t function
+ *  \param func   The interrupt_callback_t function to handle the events
+ *
+ *  \return     error_none (or exception type if policy is XCORE_C_NO_EXCEPTION).
+ *
+ *  \exception  ET_ILLEGAL_RESOURCE   not a valid timer.
+ *  \exception  ET_RESOURCE_DEP       another core is actively using the timer.
+ *  \exception  ET_LOAD_STORE         invalid *\*pt* argument.
+ *  \exception  ET_ECALL              when xassert enabled, on XS1 bit 16 not set in data.
+ */
+inline xcore_c_error_t
+hwtimer_periodic_setup_interrupt_callback(hwtimer_periodic_t *pt, void *data, interrupt_callback_t func)
+{
+  RETURN_EXCEPTION_OR_ERROR(  do { \
+                                _resource_setup_interrupt_callback(pt->t, data, func); \
+                                _hwtimer_set_trigger_time(pt->t, pt->next); \
+                              } while (0) );
+}
+
+/** Clear the current event of a periodic timer and arm the next one.
+ *
+ *  This must be called once from the select or interrupt handling of each
+ *  periodic timer event; it replaces the hwtimer_get_time() and
+ *  hwtimer_change_trigger_time() calls needed with a plain timer.
+ *  The timer is not rearmed automatically, so a select_callback_t or
+ *  interrupt_callback_t function handling the events must call it every time
+ *  it runs, or the same event will be raised again straight away.
+ *  If called before the current deadline it will pause until the deadline,
+ *  so it may also be used without events to pace a loop.
+ *
+ *  If the handling was so late that one or more later deadlines have also
+ *  passed, those events are skipped (rather than being raised back-to-back)
+ *  and counted as overruns. The period phase is preserved.
+ *
+ *  \param pt       The periodic timer
+ *  \param missed   The number of events skipped, zero if none
+ *
+ *  \return     error_none (or exception type if policy is XCORE_C_NO_EXCEPTION).
+ *
+ *  \exception  ET_ILLEGAL_RESOURCE   not a valid timer.
+ *  \exception  ET_RESOURCE_DEP       another core is actively using the timer.
+ *  \exception  ET_LOAD_STORE         invalid *\*pt* or *\*missed* argument.
+ */
+inline xcore_c_error_t hwtimer_periodic_rearm(hwtimer_periodic_t *pt, uint32_t *missed)
+{
+  RETURN_EXCEPTION_OR_ERROR( *missed = _hwtimer_periodic_rearm(pt) );
+}
+
+/** Get the total number of events skipped by a periodic timer.
+ *
+ *  \param pt        The periodic timer
+ *  \param overruns  The number of events skipped since hwtimer_periodic_init()
+ *
+ *  \return     error_none (or exception type if policy is XCORE_C_NO_EXCEPTION).
+ *
+ *  \exception  ET_LOAD_STORE         invalid *\*pt* or *\*overruns* argument.
+ */
+inline xcore_c_error_t hwtimer_periodic_get_overruns(const hwtimer_periodic_t *pt, uint32_t *overruns)
+{
+  RETURN_EXCEPTION_OR_ERROR( *overruns = pt->overruns );
+}
+
 #endif // !defined(__XC__)
 
 #endif // __xcore_c_hwtimer_h__
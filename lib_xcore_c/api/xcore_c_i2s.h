@@ -0,0 +1,292 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+
+#ifndef __xcore_c_i2s_h__
+#define __xcore_c_i2s_h__
+
+#include "xcore_c_i2s_impl.h"
+
+#if !defined(__XC__) || defined(__DOXYGEN__)
+
+#include <stdint.h>
+#include <stddef.h>
+#include "xcore_c_exception_impl.h"
+
+/** Initialise a buffer of frames for exchanging samples with an I2S engine.
+ *
+ *  The buffer is written by one logical core and read by another without
+ *  the use of locks or channels. The engine reads the frames to output from
+ *  one buffer and writes the frames it inputs to another.
+ *
+ *  A frame holds one sample per channel per data port, with the samples of
+ *  each data port held consecutively. So sample *n* of data port *i* is held
+ *  in word *i* * channels + *n* of the frame.
+ *
+ *  \param b            The buffer to initialise
+ *  \param mem          The memory for the buffer, at least *frame_words* * *num_frames* words
+ *  \param frame_words  The number of words in each frame
+ *  \param num_frames   The number of frames the buffer can hold
+ *
+ *  \return     error_none
+ *
+ *  \exception  ET_ECALL              when xassert enabled, the frame is larger than
+ *                                    XCORE_C_I2S_MAX_FRAME_WORDS, or *num_frames* is 0.
+ */
+inline xcore_c_error_t i2s_buffer_init(i2s_buffer_t *b, uint32_t mem[], size_t frame_words, size_t num_frames)
+{
+  xassert(frame_words <= XCORE_C_I2S_MAX_FRAME_WORDS &&
+          msg("Frame larger than XCORE_C_I2S_MAX_FRAME_WORDS"));
+  xassert(num_frames && msg("Buffer holds no frames"));
+  b->frames = mem;
+  b->frame_words = frame_words;
+  b->num_frames = num_frames;
+  b->written = 0;
+  b->read = 0;
+  return error_none;
+}
+
+/** Write a frame into a buffer, if there is room.
+ *
+ *  \param b        The buffer
+ *  \param frame    The frame to write
+ *  \param written  1 if the frame was written, or 0 if the buffer was full
+ *
+ *  \return     error_none (or exception type if policy is XCORE_C_NO_EXCEPTION).
+ *
+ *  \exception  ET_LOAD_STORE         invalid *\*b*, *frame[]* or *\*written* argument.
+ */
+inline xcore_c_error_t i2s_buffer_write(i2s_buffer_t *b, const uint32_t frame[], size_t *written)
+{
+  RETURN_EXCEPTION_OR_ERROR( *written = _i2s_buffer_write(b, frame) );
+}
+
+/** Read the oldest frame from a buffer, if there is one.
+ *
+ *  \param b      The buffer
+ *  \param frame  The frame read
+ *  \param read   1 if a frame was read, or 0 if the buffer was empty
+ *
+ *  \return     error_none (or exception type if policy is XCORE_C_NO_EXCEPTION).
+ *
+ *  \exception  ET_LOAD_STORE         invalid *\*b*, *frame[]* or *\*read* argument.
+ */
+inline xcore_c_error_t i2s_buffer_read(i2s_buffer_t *b, uint32_t frame[], size_t *read)
+{
+  RETURN_EXCEPTION_OR_ERROR( *read = _i2s_buffer_read(b, frame) );
+}
+
+/** Initialise an I2S or TDM master engine.
+ *
+ *  The master drives the bit clock and the word clock (or frame sync).
+ *  The clock block must already be configured to run at the bit clock rate,
+ *  for example using clock_set_source_port() with a master clock input and
+ *  clock_set_divide(), and must not be running. It is started by i2s_run().
+ *
+ *  The ports must already be allocated. The word clock port is made a 32-bit
+ *  buffered port clocked by the clock block, and the bit clock port drives out
+ *  the clock block's clock.
+ *
+ *  \param i2s       The engine to initialise
+ *  \param mode      The frame format
+ *  \param channels  The number of channels in each frame, which must be 2 for I2S_MODE_I2S
+ *  \param clk       The clock block which generates the bit clock
+ *  \param p_bclk    A 1-bit port to output the bit clock on
+ *  \param p_lrclk   A 1-bit port to output the word clock (or frame sync) on
+ *
+ *  \return     error_none (or exception type if policy is XCORE_C_NO_EXCEPTION).
+ *
+ *  \exception  ET_ILLEGAL_RESOURCE   not a valid port or clock,
+ *                                    or the clock is running.
+ *  \exception  ET_RESOURCE_DEP       another core is actively changing a port or clock.
+ *  \exception  ET_LOAD_STORE         invalid *\*i2s* argument.
+ *  \exception  ET_ECALL              when xassert enabled, *mode* is I2S_MODE_I2S
+ *                                    and *channels* is not 2.
+ */
+inline xcore_c_error_t i2s_init_master(i2s_t *i2s, i2s_mode_t mode, size_t channels, clock clk, port p_bclk, port p_lrclk)
+{
+  xassert((mode != I2S_MODE_I2S || channels == 2) &&
+          msg("I2S frames have two channels"));
+  RETURN_EXCEPTION_OR_ERROR(  do { \
+                                i2s->mode = mode; \
+                                i2s->master = 1; \
+                                i2s->channels = channels; \
+                                i2s->clk = clk; \
+                                i2s->p_lrclk = p_lrclk; \
+                                i2s->num_out = 0; \
+                                i2s->num_in = 0; \
+                                i2s->stop = 0; \
+                                i2s->underruns = 0; \
+                                i2s->overruns = 0; \
+                                i2s->sync_errors = 0; \
+                                _port_set_clock(p_bclk, clk); \
+                                _port_set_out_clock(p_bclk); \
+                                _i2s_configure_port(p_lrclk, clk); \
+                              } while (0) );
+}
+
+/** Initialise an I2S or TDM slave engine.
+ *
+ *  The slave is clocked by the bit clock input and follows the word clock
+ *  (or frame sync) input. The clock block's source is set to the bit clock
+ *  port, so the clock block must not be running. It is started by this
+ *  function.
+ *
+ *  The ports must already be allocated. The word clock port is made a 32-bit
+ *  buffered port clocked by the clock block.
+ *
+ *  \param i2s       The engine to initialise
+ *  \param mode      The frame format
+ *  \param channels  The number of channels in each frame, which must be 2 for I2S_MODE_I2S
+ *  \param clk       The clock block to clock the ports from the bit clock
+ *  \param p_bclk    A 1-bit port to input the bit clock from
+ *  \param p_lrclk   A 1-bit port to input the word clock (or frame sync) from
+ *
+ *  \return     error_none (or exception type if policy is XCORE_C_NO_EXCEPTION).
+ *
+ *  \exception  ET_ILLEGAL_RESOURCE   not a valid port or clock,
+ *                                    or the clock is running.
+ *  \exception  ET_RESOURCE_DEP       another core is actively changing a port or clock.
+ *  \exception  ET_LOAD_STORE         invalid *\*i2s* argument.
+ *  \exception  ET_ECALL              when xassert enabled, *mode* is I2S_MODE_I2S
+ *                                    and *channels* is not 2.
+ */
+inline xcore_c_error_t i2s_init_slave(i2s_t *i2s, i2s_mode_t mode, size_t channels, clock clk, port p_bclk, port p_lrclk)
+{
+  xassert((mode != I2S_MODE_I2S || channels == 2) &&
+          msg("I2S frames have two channels"));
+  RETURN_EXCEPTION_OR_ERROR(  do { \
+                                i2s->mode = mode; \
+                                i2s->master = 0; \
+                                i2s->channels = channels; \
+                                i2s->clk = clk; \
+                                i2s->p_lrclk = p_lrclk; \
+                                i2s->num_out = 0; \
+                                i2s->num_in = 0; \
+                                i2s->stop = 0; \
+                                i2s->underruns = 0; \
+                                i2s->overruns = 0; \
+                                i2s->sync_errors = 0; \
+                                _clock_set_source_port(clk, p_bclk); \
+                                _i2s_configure_port(p_lrclk, clk); \
+                                _clock_start(clk); \
+                              } while (0) );
+}
+
+/** Set the data ports of an I2S engine.
+ *
+ *  The ports must already be allocated. Each is made a 32-bit buffered port
+ *  clocked by the engine's clock block. Each data port carries all the
+ *  channels of a frame, so the engine's frames hold *num_out* * channels words
+ *  to output and *num_in* * channels words which have been input.
+ *  **The arrays of ports must remain valid while the engine is running.**
+ *
+ *  \param i2s      The initialised engine
+ *  \param p_dout   The 1-bit ports to output data on
+ *  \param num_out  The number of output data ports, which may be zero
+ *  \param p_din    The 1-bit ports to input data from
+ *  \param num_in   The number of input data ports, which may be zero
+ *
+ *  \return     error_none (or exception type if policy is XCORE_C_NO_EXCEPTION).
+ *
+ *  \exception  ET_ILLEGAL_RESOURCE   not a valid port.
+ *  \exception  ET_RESOURCE_DEP       another core is actively changing a port.
+ *  \exception  ET_LOAD_STORE         invalid *\*i2s*, *p_dout[]* or *p_din[]* argument.
+ *  \exception  ET_ECALL              when xassert enabled, the frame is larger than
+ *                                    XCORE_C_I2S_MAX_FRAME_WORDS.
+ */
+inline xcore_c_error_t i2s_set_data_ports(i2s_t *i2s, const port p_dout[], size_t num_out, const port p_din[], size_t num_in)
+{
+  xassert(num_out * i2s->channels <= XCORE_C_I2S_MAX_FRAME_WORDS &&
+          num_in * i2s->channels <= XCORE_C_I2S_MAX_FRAME_WORDS &&
+          msg("Frame larger than XCORE_C_I2S_MAX_FRAME_WORDS"));
+  RETURN_EXCEPTION_OR_ERROR(  do { \
+                                i2s->p_dout = p_dout; \
+                                i2s->num_out = num_out; \
+                                i2s->p_din = p_din; \
+                                i2s->num_in = num_in; \
+                                for (size_t i = 0; i < num_out; i++) { \
+                                  _i2s_configure_port(p_dout[i], i2s->clk); \
+                                } \
+                                for (size_t i = 0; i < num_in; i++) { \
+                                  _i2s_configure_port(p_din[i], i2s->clk); \
+                                } \
+                              } while (0) );
+}
+
+/** Run an I2S engine.
+ *
+ *  This function exchanges frames with the application until i2s_stop() is
+ *  called, and should be called on a logical core dedicated to the engine.
+ *  Each frame output is read from *tx* and each frame input is written to *rx*.
+ *  The samples are 32-bit values which are transferred most significant bit
+ *  first.
+ *
+ *  If *tx* is empty when a frame is due, a frame of silence is output and an
+ *  underrun is counted. If *rx* is full, the frame input is discarded and an
+ *  overrun is counted.
+ *
+ *  A master starts its clock block once the first frame is ready to output,
+ *  and stops it when the engine is stopped. A slave waits for the start of a
+ *  frame on the word clock before starting. If it then finds the word clock
+ *  is not as expected it counts a sync error and waits for the start of a frame
+ *  again. While it waits it uses select events and a hardware timer of its own,
+ *  to see if it has been stopped every XCORE_C_I2S_STOP_POLL_TICKS.
+ *
+ *  \param i2s  The initialised engine
+ *  \param tx   The buffer of frames to output, or null if there are no output data ports
+ *  \param rx   The buffer for frames input, or null if there are no input data ports
+ *
+ *  \return     error_none (or exception type if policy is XCORE_C_NO_EXCEPTION).
+ *
+ *  \exception  ET_ILLEGAL_RESOURCE   not a valid port or clock,
+ *                                    or no hardware timer is free for a slave.
+ *  \exception  ET_RESOURCE_DEP       another core is actively using a port or clock.
+ *  \exception  ET_LOAD_STORE         invalid *\*i2s*, *\*tx* or *\*rx* argument.
+ *  \exception  ET_ECALL              when xassert enabled, the frames of *tx* or *rx*
+ *                                    do not match the engine's data ports.
+ */
+inline xcore_c_error_t i2s_run(i2s_t *i2s, i2s_buffer_t *tx, i2s_buffer_t *rx)
+{
+  xassert((!i2s->num_out || tx->frame_words == i2s->num_out * i2s->channels) &&
+          (!i2s->num_in || rx->frame_words == i2s->num_in * i2s->channels) &&
+          msg("Buffer frames do not match the data ports"));
+  RETURN_EXCEPTION_OR_ERROR( _i2s_run(i2s, tx, rx) );
+}
+
+/** Stop an I2S engine.
+ *
+ *  The engine stops at the end of the current frame. A slave waiting for the
+ *  start of a frame stops within XCORE_C_I2S_STOP_POLL_TICKS, even if its bit
+ *  clock has stopped, but one part way through a frame needs the bit clock to
+ *  finish it. This function may be called from any logical core on the same
+ *  tile as the one running i2s_run(), or from a callback.
+ *
+ *  \param i2s  The running engine
+ *
+ *  \return     error_none
+ */
+inline xcore_c_error_t i2s_stop(i2s_t *i2s)
+{
+  i2s->stop = 1;
+  return error_none;
+}
+
+/** Get the number of errors seen by an I2S engine.
+ *
+ *  \param i2s          The engine
+ *  \param underruns    The number of frames for which no output frame was ready
+ *  \param overruns     The number of input frames discarded because the buffer was full
+ *  \param sync_errors  The number of times a slave has lost the word clock
+ *
+ *  \return     error_none
+ */
+inline xcore_c_error_t i2s_get_errors(const i2s_t *i2s, uint32_t *underruns, uint32_t *overruns, uint32_t *sync_errors)
+{
+  *underruns = i2s->underruns;
+  *overruns = i2s->overruns;
+  *sync_errors = i2s->sync_errors;
+  return error_none;
+}
+
+#endif // !defined(__XC__)
+
+#endif // __xcore_c_i2s_h__
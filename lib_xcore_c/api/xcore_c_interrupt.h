@@ -4,8 +4,11 @@
 #define __xcore_c_interrupt_h__
 
 #include "xcore_c_interrupt_impl.h"
+#include "xcore_c_trace_impl.h"
+#include "xcore_c_stats_impl.h"
 #include "xcore_c_resource_impl.h"
 #include "xcore_c_error_codes.h"
+#include "xcore_c_exception_impl.h"
 #include "xcore_c_macros.h"
 #include <xs1.h>
 
@@ -102,7 +105,11 @@
  */
 inline xcore_c_error_t interrupt_mask_all(void)
 {
+#if XCORE_C_HOST
+  _host_clrsr(XS1_SR_IEBLE_MASK);
+#else
   asm volatile("clrsr" _XCORE_C_STR(XS1_SR_IEBLE_MASK));
+#endif
   return error_none;
 }
 
@@ -115,10 +122,98 @@ inline xcore_c_error_t interrupt_mask_all(void)
  */
 inline xcore_c_error_t interrupt_unmask_all(void)
 {
+#if XCORE_C_HOST
+  _host_setsr(XS1_SR_IEBLE_MASK);
+#else
   asm volatile("setsr" _XCORE_C_STR(XS1_SR_IEBLE_MASK));
+#endif
+  return error_none;
+}
+
+#if !defined(__XC__) || defined(__DOXYGEN__)
+
+/** Mask all interrupts on this logical core, saving the previous mask state.
+ *
+ *  Use this in preference to interrupt_mask_all() when entering a critical
+ *  section which may be nested, or which may be called from code that has
+ *  already masked interrupts (including an interrupt_callback_t).
+ *  The critical section is ended by passing the saved state to interrupt_restore(),
+ *  which will only unmask interrupts if they were unmasked on entry.
+ *
+ *  Example usage: \code
+ *    interrupt_state_t state;
+ *    interrupt_mask_all_save(&state);
+ *    // Critical section - keep it short.
+ *    interrupt_restore(state);
+ *  \endcode
+ *
+ *  \param state  The mask state prior to the call
+ *
+ *  \return     error_none
+ */
+inline xcore_c_error_t interrupt_mask_all_save(interrupt_state_t *state)
+{
+  *state = _interrupt_mask_all_save();
+  return error_none;
+}
+
+/** Restore the interrupt mask state saved by interrupt_mask_all_save().
+ *
+ *  Interrupts are unmasked only if they were unmasked when the matching
+ *  interrupt_mask_all_save() was called. Calls must be correctly nested.
+ *
+ *  \param state  The state returned by the matching interrupt_mask_all_save()
+ *
+ *  \return     error_none
+ */
+inline xcore_c_error_t interrupt_restore(interrupt_state_t state)
+{
+  _interrupt_restore(state);
   return error_none;
 }
 
+/** Mask the interrupt of a single resource.
+ *
+ *  Prevents the resource's *res*_setup_interrupt_callback() function from
+ *  triggering, leaving interrupts from all other resources on this
+ *  logical core unaffected. This allows a short critical section against one
+ *  interrupt_callback_t without delaying unrelated high-rate interrupts.
+ *  The interrupt is unmasked using interrupt_unmask_resource().
+ *
+ *  **The resource's interrupt_callback_t must not itself re-enable the trigger
+ *  on the resource**
+ *
+ *  \param r    The resource whose interrupt is to be masked
+ *
+ *  \return     error_none (or exception type if policy is XCORE_C_NO_EXCEPTION).
+ *
+ *  \exception  ET_ILLEGAL_RESOURCE   not a valid resource.
+ *  \exception  ET_RESOURCE_DEP       another core is actively using the resource.
+ */
+inline xcore_c_error_t interrupt_mask_resource(resource_t r)
+{
+  RETURN_EXCEPTION_OR_ERROR( _resource_disable_trigger(r) );
+}
+
+/** Unmask the interrupt of a single resource.
+ *
+ *  Allows the resource's *res*_setup_interrupt_callback() function to trigger
+ *  again after a call to interrupt_mask_resource().
+ *
+ *  \param r    The resource whose interrupt is to be unmasked
+ *
+ *  \return     error_none (or exception type if policy is XCORE_C_NO_EXCEPTION).
+ *
+ *  \exception  ET_ILLEGAL_RESOURCE   not a valid resource.
+ *  \exception  ET_RESOURCE_DEP       another core is actively using the resource.
+ */
+inline xcore_c_error_t interrupt_unmask_resource(resource_t r)
+{
+  RETURN_EXCEPTION_OR_ERROR( _resource_enable_trigger(r) );
+}
+
+#endif // !defined(__XC__)
+
 /** Define an interrupt handling function
  *
  *  This macro will define two functions for you:
@@ -64,10 +64,8 @@ inline xcore_c_error_t lock_free(lock_t *l)
  */
 inline xcore_c_error_t lock_acquire(lock_t l)
 {
-  RETURN_EXCEPTION_OR_ERROR(  do { \
-                                unsigned dummy; \
-                                asm volatile("in %0, res[%1]" : "=r" (dummy): "r" (l) : "memory"); \
-                              } while (0) );
+  _XCORE_C_TRACK_USE(l);
+  RETURN_EXCEPTION_OR_ERROR( _lock_acquire(l) );
 }
 
 /** Release a lock.
@@ -86,7 +84,304 @@ inline xcore_c_error_t lock_acquire(lock_t l)
  */
 inline xcore_c_error_t lock_release(lock_t l)
 {
-  RETURN_EXCEPTION_OR_ERROR( asm volatile("out res[%0], %0" :: "r" (l) : "memory") );
+  _XCORE_C_TRACK_USE(l);
+  RETURN_EXCEPTION_OR_ERROR( _lock_release(l) );
+}
+
+/** Allocates a pool of software locks.
+ *
+ *  There are only a few hardware locks on each tile. A pool uses one hardware
+ *  lock to guard any number of software locks, which are allocated from it
+ *  using swlock_alloc() and used like hardware locks. The storage for the
+ *  software locks is provided by *slots[]*.
+ *
+ *  If there are no hardware locks available the pool is left without one,
+ *  and swlock_alloc() returns NULL for every software lock requested from it.
+ *  Callers should check the first software lock they allocate to detect this.
+ *  When the pool is no longer required, lock_pool_free() must be called to
+ *  deallocate its hardware lock.
+ *
+ *  \param pool   The pool to initialise
+ *  \param slots  The storage for the pool's software locks
+ *  \param size   The number of software locks *slots[]* holds
+ *
+ *  \return     error_none (or exception type if policy is XCORE_C_NO_EXCEPTION).
+ *
+ *  \exception  ET_LOAD_STORE         invalid *\*pool* or *slots[]* argument.
+ */
+inline xcore_c_error_t lock_pool_alloc(lock_pool_t *pool, swlock_slot_t slots[], size_t size)
+{
+  RETURN_EXCEPTION_OR_ERROR( _lock_pool_alloc(pool, slots, size) );
+}
+
+/** Deallocate a pool of software locks.
+ *
+ *  This function frees the pool's hardware lock, if it was allocated one.
+ *  All the software locks allocated from the pool must be freed first.
+ *
+ *  \param pool   The pool to be freed
+ *
+ *  \return     error_none (or exception type if policy is XCORE_C_NO_EXCEPTION).
+ *
+ *  \exception  ET_LOAD_STORE         invalid *\*pool* argument.
+ *  \exception  ET_ECALL              when xassert enabled, a software lock has
+ *                                    not been freed.
+ */
+inline xcore_c_error_t lock_pool_free(lock_pool_t *pool)
+{
+  RETURN_EXCEPTION_OR_ERROR( _lock_pool_free(pool) );
+}
+
+/** Allocates a software lock from a pool.
+ *
+ *  If all the pool's software locks are allocated the function returns NULL.
+ *  When the lock is no longer required, swlock_free() must be called
+ *  to return it to the pool.
+ *
+ *  \param pool   The pool to allocate from
+ *  \param l      swlock_t variable representing the initialised lock
+ *
+ *  \return     error_none (or exception type if policy is XCORE_C_NO_EXCEPTION).
+ *
+ *  \exception  ET_LOAD_STORE         invalid *\*pool* or *\*l* argument.
+ */
+inline xcore_c_error_t swlock_alloc(lock_pool_t *pool, swlock_t *l)
+{
+  RETURN_EXCEPTION_OR_ERROR( *l = _swlock_alloc(pool) );
+}
+
+/** Deallocate a software lock, returning it to its pool.
+ *
+ *  The lock must be released prior to calling this function.
+ *
+ *  \param l    The swlock_t to be freed
+ *
+ *  \return     error_none (or exception type if policy is XCORE_C_NO_EXCEPTION).
+ *
+ *  \exception  ET_LOAD_STORE         invalid *\*l* argument.
+ *  \exception  ET_ECALL              when xassert enabled, the lock is NULL
+ *                                    or has not been released.
+ */
+inline xcore_c_error_t swlock_free(swlock_t *l)
+{
+  RETURN_EXCEPTION_OR_ERROR(  do { \
+                                _swlock_free(*l); \
+                                *l = NULL; \
+                              } while (0) );
+}
+
+/** Acquire a software lock.
+ *
+ *  Only one core at a time can acquire a lock. If another core has already
+ *  acquired this lock then this function will spin until the lock is released
+ *  and this core becomes the owner. Waiting cores become the owner in the order
+ *  they called this function.
+ *
+ *  The pool's hardware lock is only held while taking a place in the order,
+ *  so cores acquiring different locks from the same pool rarely wait for each
+ *  other.
+ *
+ *  \param l    The swlock_t to acquire
+ *
+ *  \return     error_none (or exception type if policy is XCORE_C_NO_EXCEPTION).
+ *
+ *  \exception  ET_LOAD_STORE         invalid *l* argument.
+ *  \exception  ET_ECALL              when xassert enabled, the lock is NULL.
+ */
+inline xcore_c_error_t swlock_acquire(swlock_t l)
+{
+  RETURN_EXCEPTION_OR_ERROR( _swlock_acquire(l) );
+}
+
+/** Release a software lock.
+ *
+ *  This releases the lock to the next waiting core, if there is one.
+ *  *Note*: there are no checks that the core releasing the lock is the current
+ *  owner.
+ *
+ *  \param l    The swlock_t to release
+ *
+ *  \return     error_none (or exception type if policy is XCORE_C_NO_EXCEPTION).
+ *
+ *  \exception  ET_LOAD_STORE         invalid *l* argument.
+ *  \exception  ET_ECALL              when xassert enabled, the lock is NULL.
+ */
+inline xcore_c_error_t swlock_release(swlock_t l)
+{
+  RETURN_EXCEPTION_OR_ERROR( _swlock_release(l) );
+}
+
+/** Initialise a reader-writer lock.
+ *
+ *  Many cores may own a reader-writer lock for reading at the same time, or
+ *  one core may own it for writing. It suits data which is read often and
+ *  updated rarely, as the readers do not wait for each other.
+ *
+ *  The lock's counts are guarded by a hardware lock, which is only held while
+ *  they are changed. So the hardware lock may also guard other reader-writer
+ *  locks, or a lock pool. It must stay allocated while the reader-writer lock
+ *  is used, and be freed by the caller afterwards.
+ *
+ *  \param rw     The reader-writer lock to initialise
+ *  \param guard  The allocated hardware lock guarding it
+ *
+ *  \return     error_none (or exception type if policy is XCORE_C_NO_EXCEPTION).
+ *
+ *  \exception  ET_LOAD_STORE         invalid *\*rw* argument.
+ */
+inline xcore_c_error_t rwlock_init(rwlock_t *rw, lock_t guard)
+{
+  RETURN_EXCEPTION_OR_ERROR( _rwlock_init(rw, guard) );
+}
+
+/** Acquire a reader-writer lock for reading.
+ *
+ *  If a core owns the lock for writing, or is waiting to, then this function
+ *  will spin until it has released the lock. Other readers do not wait.
+ *
+ *  \param rw   The reader-writer lock to acquire
+ *
+ *  \return     error_none (or exception type if policy is XCORE_C_NO_EXCEPTION).
+ *
+ *  \exception  ET_ILLEGAL_RESOURCE   the guard is not an allocated lock.
+ *  \exception  ET_LOAD_STORE         invalid *\*rw* argument.
+ */
+inline xcore_c_error_t rwlock_read_acquire(rwlock_t *rw)
+{
+  RETURN_EXCEPTION_OR_ERROR( _rwlock_read_acquire(rw) );
+}
+
+/** Release a reader-writer lock acquired for reading.
+ *
+ *  \param rw   The reader-writer lock to release
+ *
+ *  \return     error_none (or exception type if policy is XCORE_C_NO_EXCEPTION).
+ *
+ *  \exception  ET_ILLEGAL_RESOURCE   the guard is not an allocated lock.
+ *  \exception  ET_LOAD_STORE         invalid *\*rw* argument.
+ */
+inline xcore_c_error_t rwlock_read_release(rwlock_t *rw)
+{
+  RETURN_EXCEPTION_OR_ERROR( _rwlock_read_release(rw) );
+}
+
+/** Acquire a reader-writer lock for writing.
+ *
+ *  This function will spin until no other core owns the lock. New readers wait
+ *  while a writer is waiting, so writers are not starved by the readers.
+ *
+ *  \param rw   The reader-writer lock to acquire
+ *
+ *  \return     error_none (or exception type if policy is XCORE_C_NO_EXCEPTION).
+ *
+ *  \exception  ET_ILLEGAL_RESOURCE   the guard is not an allocated lock.
+ *  \exception  ET_LOAD_STORE         invalid *\*rw* argument.
+ */
+inline xcore_c_error_t rwlock_write_acquire(rwlock_t *rw)
+{
+  RETURN_EXCEPTION_OR_ERROR( _rwlock_write_acquire(rw) );
+}
+
+/** Release a reader-writer lock acquired for writing.
+ *
+ *  \param rw   The reader-writer lock to release
+ *
+ *  \return     error_none (or exception type if policy is XCORE_C_NO_EXCEPTION).
+ *
+ *  \exception  ET_LOAD_STORE         invalid *\*rw* argument.
+ */
+inline xcore_c_error_t rwlock_write_release(rwlock_t *rw)
+{
+  RETURN_EXCEPTION_OR_ERROR( _rwlock_write_release(rw) );
+}
+
+/** Initialise a sequence lock.
+ *
+ *  A sequence lock lets readers take a copy of shared data without writing to
+ *  shared memory at all. A reader checks that no writer changed the data while
+ *  it was being read, and reads it again if one did. Writers never wait for
+ *  readers, so it suits small data which is read very often.
+ *
+ *  The hardware lock is held by a writer while it updates the data, so that
+ *  writers update the data one at a time. It must stay allocated while the
+ *  sequence lock is used, and be freed by the caller afterwards.
+ *
+ *  \param s      The sequence lock to initialise
+ *  \param guard  The allocated hardware lock guarding it
+ *
+ *  \return     error_none (or exception type if policy is XCORE_C_NO_EXCEPTION).
+ *
+ *  \exception  ET_LOAD_STORE         invalid *\*s* argument.
+ */
+inline xcore_c_error_t seqlock_init(seqlock_t *s, lock_t guard)
+{
+  RETURN_EXCEPTION_OR_ERROR( _seqlock_init(s, guard) );
+}
+
+/** Start updating the data protected by a sequence lock.
+ *
+ *  If another writer is updating the data this function will pause until it
+ *  has finished.
+ *
+ *  \param s    The sequence lock
+ *
+ *  \return     error_none (or exception type if policy is XCORE_C_NO_EXCEPTION).
+ *
+ *  \exception  ET_ILLEGAL_RESOURCE   the guard is not an allocated lock.
+ *  \exception  ET_LOAD_STORE         invalid *\*s* argument.
+ */
+inline xcore_c_error_t seqlock_write_begin(seqlock_t *s)
+{
+  RETURN_EXCEPTION_OR_ERROR( _seqlock_write_begin(s) );
+}
+
+/** Finish updating the data protected by a sequence lock.
+ *
+ *  \param s    The sequence lock
+ *
+ *  \return     error_none (or exception type if policy is XCORE_C_NO_EXCEPTION).
+ *
+ *  \exception  ET_ILLEGAL_RESOURCE   the guard is not an allocated lock.
+ *  \exception  ET_LOAD_STORE         invalid *\*s* argument.
+ */
+inline xcore_c_error_t seqlock_write_end(seqlock_t *s)
+{
+  RETURN_EXCEPTION_OR_ERROR( _seqlock_write_end(s) );
+}
+
+/** Start reading the data protected by a sequence lock.
+ *
+ *  If a writer is updating the data this function will spin until it has
+ *  finished.
+ *
+ *  \param s    The sequence lock
+ *  \param seq  The sequence number to pass to seqlock_read_retry()
+ *
+ *  \return     error_none (or exception type if policy is XCORE_C_NO_EXCEPTION).
+ *
+ *  \exception  ET_LOAD_STORE         invalid *\*s* or *\*seq* argument.
+ */
+inline xcore_c_error_t seqlock_read_begin(seqlock_t *s, uint32_t *seq)
+{
+  RETURN_EXCEPTION_OR_ERROR( *seq = _seqlock_read_begin(s) );
+}
+
+/** Finish reading the data protected by a sequence lock.
+ *
+ *  If a writer changed the data since seqlock_read_begin() the copy read may be
+ *  inconsistent, and must be discarded and read again.
+ *
+ *  \param s      The sequence lock
+ *  \param seq    The sequence number given by seqlock_read_begin()
+ *  \param retry  1 if the data must be read again, otherwise 0
+ *
+ *  \return     error_none (or exception type if policy is XCORE_C_NO_EXCEPTION).
+ *
+ *  \exception  ET_LOAD_STORE         invalid *\*s* or *\*retry* argument.
+ */
+inline xcore_c_error_t seqlock_read_retry(seqlock_t *s, uint32_t seq, int *retry)
+{
+  RETURN_EXCEPTION_OR_ERROR( *retry = _seqlock_read_retry(s, seq) );
 }
 
 #endif // !defined(__XC__)
@@ -8,8 +8,11 @@
 #include <stdint.h>
 #include <stddef.h>
 #include "xcore_c_port_impl.h"
+#include "xcore_c_hwtimer_impl.h"
 #include "xcore_c_resource_impl.h"
 #include "xcore_c_exception_impl.h"
+#include "xcore_c_trace_impl.h"
+#include "xcore_c_stats_impl.h"
 
 /** A port identifier
  *
@@ -455,6 +458,59 @@ inline xcore_c_error_t port_set_ready_handshake(port p)
   RETURN_EXCEPTION_OR_ERROR( _port_set_ready_handshake(p) );
 }
 
+/** Configure a port from a description of its configuration.
+ *
+ *  This applies all the settings described by *config* to a newly allocated
+ *  (or reset) port, in the order that the port requires, with a single
+ *  exception check. When *config* points to a constant known at compile time,
+ *  only the instructions for the settings used are generated.
+ *
+ *  \param p       The port to configure
+ *  \param config  The configuration to apply
+ *
+ *  \return     error_none (or exception type if policy is XCORE_C_NO_EXCEPTION).
+ *
+ *  \exception  ET_ILLEGAL_RESOURCE   not a valid port or clock,
+ *                                    or the configuration is not valid for the port,
+ *                                    or a ready input is given while the clock is running.
+ *  \exception  ET_RESOURCE_DEP       another core is actively changing the port.
+ *  \exception  ET_LOAD_STORE         invalid *\*config* argument.
+ *  \exception  ET_ECALL              when xassert enabled, a ready input is given
+ *                                    without a clock block.
+ */
+inline xcore_c_error_t port_configure(port p, const port_config_t *config)
+{
+  RETURN_EXCEPTION_OR_ERROR( _port_configure(p, config) );
+}
+
+/** Configure a group of ports from descriptions of their configurations.
+ *
+ *  This is equivalent to calling port_configure() for each port in turn,
+ *  but with a single exception check for the whole group.
+ *
+ *  \param p       The ports to configure
+ *  \param config  The configuration to apply to each port
+ *  \param n       The number of ports
+ *
+ *  \return     error_none (or exception type if policy is XCORE_C_NO_EXCEPTION).
+ *
+ *  \exception  ET_ILLEGAL_RESOURCE   not a valid port or clock,
+ *                                    or a configuration is not valid for its port,
+ *                                    or a ready input is given while its clock is running.
+ *  \exception  ET_RESOURCE_DEP       another core is actively changing a port.
+ *  \exception  ET_LOAD_STORE         invalid *p[]* or *config[]* argument.
+ *  \exception  ET_ECALL              when xassert enabled, a ready input is given
+ *                                    without a clock block.
+ */
+inline xcore_c_error_t port_configure_group(const port p[], const port_config_t config[], size_t n)
+{
+  RETURN_EXCEPTION_OR_ERROR(  do { \
+                                for (size_t i = 0; i < n; i++) { \
+                                  _port_configure(p[i], &config[i]); \
+                                } \
+                              } while (0) );
+}
+
 /** Get the timestamp of the last operation on a port.
  *
  *  This function gets the timestamp of the last input or output operation
@@ -609,7 +665,9 @@ inline xcore_c_error_t port_peek(port p, uint32_t *data)
  */
 inline xcore_c_error_t port_out(port p, uint32_t data)
 {
-  RETURN_EXCEPTION_OR_ERROR( _port_out(p, data) );
+  _XCORE_C_TRACE(trace_port_out, p);
+  _XCORE_C_TRACK_USE(p);
+  RETURN_EXCEPTION_OR_ERROR( _XCORE_C_STATS_TRANSFER(p, 1, _port_out(p, data)) );
 }
 
 /** Input a value from a port.
@@ -631,7 +689,9 @@ inline xcore_c_error_t port_out(port p, uint32_t data)
  */
 inline xcore_c_error_t port_in(port p, uint32_t *data)
 {
-  RETURN_EXCEPTION_OR_ERROR( *data = _port_in(p) );
+  _XCORE_C_TRACE(trace_port_in, p);
+  _XCORE_C_TRACK_USE(p);
+  RETURN_EXCEPTION_OR_ERROR( _XCORE_C_STATS_TRANSFER(p, 1, *data = _port_in(p)) );
 }
 
 /** Outputs a value onto a port and shift the output data.
@@ -656,7 +716,9 @@ inline xcore_c_error_t port_in(port p, uint32_t *data)
  */
 inline xcore_c_error_t port_out_shift_right(port p, uint32_t *data)
 {
-  RETURN_EXCEPTION_OR_ERROR( _port_out_shift_right(p, data) );
+  _XCORE_C_TRACE(trace_port_out, p);
+  _XCORE_C_TRACK_USE(p);
+  RETURN_EXCEPTION_OR_ERROR( _XCORE_C_STATS_TRANSFER(p, 1, _port_out_shift_right(p, data)) );
 }
 
 /** Input a value from a port and shift the data.
@@ -679,7 +741,298 @@ inline xcore_c_error_t port_out_shift_right(port p, uint32_t *data)
  */
 inline xcore_c_error_t port_in_shift_right(port p, uint32_t *data)
 {
-  RETURN_EXCEPTION_OR_ERROR( _port_in_shift_right(p, data) );
+  _XCORE_C_TRACE(trace_port_in, p);
+  _XCORE_C_TRACK_USE(p);
+  RETURN_EXCEPTION_OR_ERROR( _XCORE_C_STATS_TRANSFER(p, 1, _port_in_shift_right(p, data)) );
+}
+
+/** Output a block of values onto a port.
+ *
+ *  This is equivalent to calling port_out() for each value in turn, but
+ *  without the per call overhead.
+ *
+ *  \param p      Port to output to
+ *  \param buf    The values to output
+ *  \param n      The number of values to output
+ *
+ *  \return     error_none (or exception type if policy is XCORE_C_NO_EXCEPTION).
+ *
+ *  \exception  ET_ILLEGAL_RESOURCE   not a valid port.
+ *  \exception  ET_RESOURCE_DEP       another core is actively changing the port.
+ *  \exception  ET_LOAD_STORE         invalid *buf[]* argument.
+ */
+inline xcore_c_error_t port_out_buf(port p, const uint32_t buf[], size_t n)
+{
+  _XCORE_C_TRACE(trace_port_out, p);
+  _XCORE_C_TRACK_USE(p);
+  RETURN_EXCEPTION_OR_ERROR( _XCORE_C_STATS_TRANSFER(p, n, do { \
+                                for (size_t i = 0; i < n; i++) { \
+                                  _port_out(p, buf[i]); \
+                                } \
+                              } while (0)) );
+}
+
+/** Input a block of values from a port.
+ *
+ *  This is equivalent to calling port_in() for each value in turn, but
+ *  without the per call overhead.
+ *
+ *  \param p      Port to input from
+ *  \param buf    The memory to fill with the inputted values
+ *  \param n      The number of values to input
+ *
+ *  \return     error_none (or exception type if policy is XCORE_C_NO_EXCEPTION).
+ *
+ *  \exception  ET_ILLEGAL_RESOURCE   not a valid port.
+ *  \exception  ET_RESOURCE_DEP       another core is actively changing the port.
+ *  \exception  ET_LOAD_STORE         invalid *buf[]* argument.
+ */
+inline xcore_c_error_t port_in_buf(port p, uint32_t buf[], size_t n)
+{
+  _XCORE_C_TRACE(trace_port_in, p);
+  _XCORE_C_TRACK_USE(p);
+  RETURN_EXCEPTION_OR_ERROR( _XCORE_C_STATS_TRANSFER(p, n, do { \
+                                for (size_t i = 0; i < n; i++) { \
+                                  buf[i] = _port_in(p); \
+                                } \
+                              } while (0)) );
+}
+
+/** Output a block of values onto a port, recording the port timestamp of each.
+ *
+ *  This is the same as port_out_buf(), except that the port timestamp of each
+ *  output (as returned by port_get_trigger_time()) is stored in *ts[]*.
+ *
+ *  \param p      Port to output to
+ *  \param buf    The values to output
+ *  \param ts     The memory to fill with the timestamps of the outputs
+ *  \param n      The number of values to output
+ *
+ *  \return     error_none (or exception type if policy is XCORE_C_NO_EXCEPTION).
+ *
+ *  \exception  ET_ILLEGAL_RESOURCE   not a valid port.
+ *  \exception  ET_RESOURCE_DEP       another core is actively changing the port.
+ *  \exception  ET_LOAD_STORE         invalid *buf[]* or *ts[]* argument.
+ */
+inline xcore_c_error_t port_out_buf_timestamped(port p, const uint32_t buf[], int16_t ts[], size_t n)
+{
+  _XCORE_C_TRACE(trace_port_out, p);
+  _XCORE_C_TRACK_USE(p);
+  RETURN_EXCEPTION_OR_ERROR( _XCORE_C_STATS_TRANSFER(p, n, do { \
+                                for (size_t i = 0; i < n; i++) { \
+                                  _port_out(p, buf[i]); \
+                                  ts[i] = _port_get_trigger_time(p); \
+                                } \
+                              } while (0)) );
+}
+
+/** Input a block of values from a port, recording the port timestamp of each.
+ *
+ *  This is the same as port_in_buf(), except that the port timestamp of each
+ *  input (as returned by port_get_trigger_time()) is stored in *ts[]*.
+ *
+ *  \param p      Port to input from
+ *  \param buf    The memory to fill with the inputted values
+ *  \param ts     The memory to fill with the timestamps of the inputs
+ *  \param n      The number of values to input
+ *
+ *  \return     error_none (or exception type if policy is XCORE_C_NO_EXCEPTION).
+ *
+ *  \exception  ET_ILLEGAL_RESOURCE   not a valid port.
+ *  \exception  ET_RESOURCE_DEP       another core is actively changing the port.
+ *  \exception  ET_LOAD_STORE         invalid *buf[]* or *ts[]* argument.
+ */
+inline xcore_c_error_t port_in_buf_timestamped(port p, uint32_t buf[], int16_t ts[], size_t n)
+{
+  _XCORE_C_TRACE(trace_port_in, p);
+  _XCORE_C_TRACK_USE(p);
+  RETURN_EXCEPTION_OR_ERROR( _XCORE_C_STATS_TRANSFER(p, n, do { \
+                                for (size_t i = 0; i < n; i++) { \
+                                  buf[i] = _port_in(p); \
+                                  ts[i] = _port_get_trigger_time(p); \
+                                } \
+                              } while (0)) );
+}
+
+/** Output a block of values onto a port, shifting each value.
+ *
+ *  This is equivalent to calling port_out_shift_right() for each value in turn,
+ *  but without the per call overhead.
+ *
+ *  \param p      Port to output to
+ *  \param buf    Each value is shifted right by the transfer width of the port,
+ *                with the bits shifting out onto the port.
+ *                The remaining shifted bits are returned in the value.
+ *  \param n      The number of values to output
+ *
+ *  \return     error_none (or exception type if policy is XCORE_C_NO_EXCEPTION).
+ *
+ *  \exception  ET_ILLEGAL_RESOURCE   not a valid port.
+ *  \exception  ET_RESOURCE_DEP       another core is actively changing the port.
+ *  \exception  ET_LOAD_STORE         invalid *buf[]* argument.
+ */
+inline xcore_c_error_t port_out_shift_right_buf(port p, uint32_t buf[], size_t n)
+{
+  _XCORE_C_TRACE(trace_port_out, p);
+  _XCORE_C_TRACK_USE(p);
+  RETURN_EXCEPTION_OR_ERROR( _XCORE_C_STATS_TRANSFER(p, n, do { \
+                                for (size_t i = 0; i < n; i++) { \
+                                  _port_out_shift_right(p, &buf[i]); \
+                                } \
+                              } while (0)) );
+}
+
+/** Input a block of values from a port, shifting the data into each value.
+ *
+ *  This is equivalent to calling port_in_shift_right() for each value in turn,
+ *  but without the per call overhead.
+ *
+ *  \param p      Port to input from
+ *  \param buf    Each value is shifted right by the transfer width of the port,
+ *                with the inputted data shifted into its top bits
+ *  \param n      The number of values to input
+ *
+ *  \return     error_none (or exception type if policy is XCORE_C_NO_EXCEPTION).
+ *
+ *  \exception  ET_ILLEGAL_RESOURCE   not a valid port.
+ *  \exception  ET_RESOURCE_DEP       another core is actively changing the port.
+ *  \exception  ET_LOAD_STORE         invalid *buf[]* argument.
+ */
+inline xcore_c_error_t port_in_shift_right_buf(port p, uint32_t buf[], size_t n)
+{
+  _XCORE_C_TRACE(trace_port_in, p);
+  _XCORE_C_TRACK_USE(p);
+  RETURN_EXCEPTION_OR_ERROR( _XCORE_C_STATS_TRANSFER(p, n, do { \
+                                for (size_t i = 0; i < n; i++) { \
+                                  _port_in_shift_right(p, &buf[i]); \
+                                } \
+                              } while (0)) );
+}
+
+/** Reverse the order of the bits of a value.
+ *
+ *  Ports shift data out and in least significant bit first. This converts
+ *  a value to or from the most significant bit first order used by many
+ *  serial protocols.
+ *
+ *  \param data   The value to reverse, updated in place
+ *
+ *  \return     error_none (or exception type if policy is XCORE_C_NO_EXCEPTION).
+ *
+ *  \exception  ET_LOAD_STORE         invalid *\*data* argument.
+ */
+inline xcore_c_error_t port_data_bitrev(uint32_t *data)
+{
+  RETURN_EXCEPTION_OR_ERROR( *data = _port_bitrev(*data) );
+}
+
+/** Interleave four serial lanes into the data for a 4-bit port.
+ *
+ *  Bit *i* of *lanes[k]* is placed so that it is driven on pin *k* of the port
+ *  by the *i*'th transfer, when *data[0]* to *data[3]* are output in turn using
+ *  port_out_shift_right() (or port_out_shift_right_buf()) on a 4-bit port with
+ *  a 32-bit transfer width. That is, it goes to bit *4i+k* of the 128 bits of
+ *  *data[]*, least significant bit of *data[0]* first.
+ *
+ *  \param lanes  The 32 bits to be serialised on each pin, least significant
+ *                bit first (see port_data_bitrev())
+ *  \param data   The data to output
+ *
+ *  \return     error_none (or exception type if policy is XCORE_C_NO_EXCEPTION).
+ *
+ *  \exception  ET_LOAD_STORE         invalid *lanes[]* or *data[]* argument.
+ */
+inline xcore_c_error_t port_data_zip_4(const uint32_t lanes[4], uint32_t data[4])
+{
+  RETURN_EXCEPTION_OR_ERROR(  do { \
+                                for (unsigned w = 0; w < 4; w++) { \
+                                  unsigned shift = w * 8; \
+                                  data[w] = _port_spread_4(lanes[0] >> shift & 0xFF) | \
+                                            _port_spread_4(lanes[1] >> shift & 0xFF) << 1 | \
+                                            _port_spread_4(lanes[2] >> shift & 0xFF) << 2 | \
+                                            _port_spread_4(lanes[3] >> shift & 0xFF) << 3; \
+                                } \
+                              } while (0) );
+}
+
+/** Separate the data input from a 4-bit port into four serial lanes.
+ *
+ *  This is the inverse of port_data_zip_4(). Bit *4i+k* of the 128 bits of
+ *  *data[]*, as input using port_in() or port_in_shift_right() on a 4-bit port
+ *  with a 32-bit transfer width, is placed in bit *i* of *lanes[k]*.
+ *
+ *  \param data   The data input from the port
+ *  \param lanes  The 32 bits deserialised from each pin, first received in
+ *                the least significant bit (see port_data_bitrev())
+ *
+ *  \return     error_none (or exception type if policy is XCORE_C_NO_EXCEPTION).
+ *
+ *  \exception  ET_LOAD_STORE         invalid *data[]* or *lanes[]* argument.
+ */
+inline xcore_c_error_t port_data_unzip_4(const uint32_t data[4], uint32_t lanes[4])
+{
+  RETURN_EXCEPTION_OR_ERROR(  do { \
+                                for (unsigned k = 0; k < 4; k++) { \
+                                  uint32_t l = 0; \
+                                  for (unsigned w = 0; w < 4; w++) { \
+                                    l |= _port_compact_4(data[w] >> k) << (w * 8); \
+                                  } \
+                                  lanes[k] = l; \
+                                } \
+                              } while (0) );
+}
+
+/** Interleave eight serial lanes into the data for an 8-bit port.
+ *
+ *  As port_data_zip_4(), but for an 8-bit port with a 32-bit transfer width:
+ *  bit *i* of *lanes[k]* goes to bit *8i+k* of the 256 bits of *data[]*.
+ *
+ *  \param lanes  The 32 bits to be serialised on each pin, least significant
+ *                bit first (see port_data_bitrev())
+ *  \param data   The data to output
+ *
+ *  \return     error_none (or exception type if policy is XCORE_C_NO_EXCEPTION).
+ *
+ *  \exception  ET_LOAD_STORE         invalid *lanes[]* or *data[]* argument.
+ */
+inline xcore_c_error_t port_data_zip_8(const uint32_t lanes[8], uint32_t data[8])
+{
+  RETURN_EXCEPTION_OR_ERROR(  do { \
+                                for (unsigned w = 0; w < 8; w++) { \
+                                  unsigned shift = w * 4; \
+                                  uint32_t d = 0; \
+                                  for (unsigned k = 0; k < 8; k++) { \
+                                    d |= _port_spread_8(lanes[k] >> shift & 0xF) << k; \
+                                  } \
+                                  data[w] = d; \
+                                } \
+                              } while (0) );
+}
+
+/** Separate the data input from an 8-bit port into eight serial lanes.
+ *
+ *  This is the inverse of port_data_zip_8(). Bit *8i+k* of the 256 bits of
+ *  *data[]* is placed in bit *i* of *lanes[k]*.
+ *
+ *  \param data   The data input from the port
+ *  \param lanes  The 32 bits deserialised from each pin, first received in
+ *                the least significant bit (see port_data_bitrev())
+ *
+ *  \return     error_none (or exception type if policy is XCORE_C_NO_EXCEPTION).
+ *
+ *  \exception  ET_LOAD_STORE         invalid *data[]* or *lanes[]* argument.
+ */
+inline xcore_c_error_t port_data_unzip_8(const uint32_t data[8], uint32_t lanes[8])
+{
+  RETURN_EXCEPTION_OR_ERROR(  do { \
+                                for (unsigned k = 0; k < 8; k++) { \
+                                  uint32_t l = 0; \
+                                  for (unsigned w = 0; w < 8; w++) { \
+                                    l |= _port_compact_8(data[w] >> k) << (w * 4); \
+                                  } \
+                                  lanes[k] = l; \
+                                } \
+                              } while (0) );
 }
 
 /** Outputs a value onto a port at a specified port timestamp.
@@ -700,10 +1053,12 @@ inline xcore_c_error_t port_in_shift_right(port p, uint32_t *data)
  */
 inline xcore_c_error_t port_out_at_time(port p, int16_t t, uint32_t data)
 {
-  RETURN_EXCEPTION_OR_ERROR(  do { \
+  _XCORE_C_TRACE(trace_port_out, p);
+  _XCORE_C_TRACK_USE(p);
+  RETURN_EXCEPTION_OR_ERROR(  _XCORE_C_STATS_TRANSFER(p, 1, do { \
                                 _port_set_trigger_time(p, t); \
                                 _port_out(p, data); \
-                              } while (0) );
+                              } while (0)) );
 }
 
 /** Input data from a port when its counter is at a specific time.
@@ -725,10 +1080,12 @@ inline xcore_c_error_t port_out_at_time(port p, int16_t t, uint32_t data)
  */
 inline xcore_c_error_t port_in_at_time(port p, int16_t t, uint32_t *data)
 {
-  RETURN_EXCEPTION_OR_ERROR(  do { \
+  _XCORE_C_TRACE(trace_port_in, p);
+  _XCORE_C_TRACK_USE(p);
+  RETURN_EXCEPTION_OR_ERROR(  _XCORE_C_STATS_TRANSFER(p, 1, do { \
                                 _port_set_trigger_time(p, t); \
                                 *data = _port_in(p); \
-                              } while (0) );
+                              } while (0)) );
 }
 
 /** Outputs a value onto a port at a specified time and shifts the output data.
@@ -752,10 +1109,12 @@ inline xcore_c_error_t port_in_at_time(port p, int16_t t, uint32_t *data)
  */
 inline xcore_c_error_t port_out_shift_right_at_time(port p, int16_t t, uint32_t *data)
 {
-  RETURN_EXCEPTION_OR_ERROR(  do { \
+  _XCORE_C_TRACE(trace_port_out, p);
+  _XCORE_C_TRACK_USE(p);
+  RETURN_EXCEPTION_OR_ERROR(  _XCORE_C_STATS_TRANSFER(p, 1, do { \
                                 _port_set_trigger_time(p, t); \
                                 _port_out_shift_right(p, data); \
-                              } while (0) );
+                              } while (0)) );
 }
 
 /** Input data from a port at a specific time and shift the data.
@@ -778,10 +1137,79 @@ inline xcore_c_error_t port_out_shift_right_at_time(port p, int16_t t, uint32_t
  */
 inline xcore_c_error_t port_in_shift_right_at_time(port p, int16_t t, uint32_t *data)
 {
-  RETURN_EXCEPTION_OR_ERROR(  do { \
+  _XCORE_C_TRACE(trace_port_in, p);
+  _XCORE_C_TRACK_USE(p);
+  RETURN_EXCEPTION_OR_ERROR(  _XCORE_C_STATS_TRANSFER(p, 1, do { \
                                 _port_set_trigger_time(p, t); \
                                 _port_in_shift_right(p, data); \
-                              } while (0) );
+                              } while (0)) );
+}
+
+#ifndef XCORE_C_PORT_MIN_GAP_TICKS
+/** The minimum number of port clock ticks by which port_out_buf_at_time()
+ *  requires a timestamp to be ahead of the port's time.
+ *
+ *  This covers the instructions between reading the port's time and setting
+ *  up its next output, around four. With eight active logical cores at 500MHz
+ *  each instruction takes 16ns, so the default of 8 ticks suits a port clock
+ *  of up to 100MHz, the reference clock. The user may lower this for a divided
+ *  port clock or fewer active cores, or raise it for a port clocked faster
+ *  than the reference clock, by setting the XCORE_C_PORT_MIN_GAP_TICKS define
+ *  in their Makefile.
+ */
+#define XCORE_C_PORT_MIN_GAP_TICKS 8
+#endif
+
+/** Output a block of values onto a port, each at a specified port timestamp.
+ *
+ *  This plays back a precomputed waveform: *buf[i]* is driven on the pins when
+ *  the port counter reaches *ts[i]*. The timestamps are normally calculated from
+ *  the timestamp of an earlier output, as returned by port_get_trigger_time().
+ *  The port should be unbuffered and not used by interrupt_callback_t functions
+ *  during the playback.
+ *
+ *  A port waits for its 16-bit counter to wrap around if it is set to a time
+ *  which has already passed. Instead, the port's counter is read before the
+ *  first value, by outputting the value already on its pins, and a value whose
+ *  timestamp is not at least XCORE_C_PORT_MIN_GAP_TICKS ahead of the port's
+ *  time is output immediately and counted as a missed deadline. Later values
+ *  are checked against the time of the value before, which an unbuffered port
+ *  has just output, and are still output at their own timestamps.
+ *
+ *  \param p      Port to output to
+ *  \param buf    The values to output
+ *  \param ts     The timestamps at which to output each value
+ *  \param n      The number of values to output
+ *  \param missed The number of values whose deadline was missed
+ *
+ *  \return     error_none (or exception type if policy is XCORE_C_NO_EXCEPTION).
+ *
+ *  \exception  ET_ILLEGAL_RESOURCE   not a valid port.
+ *  \exception  ET_RESOURCE_DEP       another core is actively changing the port.
+ *  \exception  ET_LOAD_STORE         invalid *buf[]*, *ts[]* or *\*missed* argument.
+ */
+inline xcore_c_error_t port_out_buf_at_time(port p, const uint32_t buf[], const int16_t ts[],
+                                            size_t n, size_t *missed)
+{
+  _XCORE_C_TRACE(trace_port_out, p);
+  _XCORE_C_TRACK_USE(p);
+  RETURN_EXCEPTION_OR_ERROR( _XCORE_C_STATS_TRANSFER(p, n, do { \
+                                size_t late = 0; \
+                                /* getts gives the time of the last transfer, */ \
+                                /* so make one which leaves the pins unchanged. */ \
+                                _port_out(p, _port_peek(p)); \
+                                for (size_t i = 0; i < n; i++) { \
+                                  int16_t now = _port_get_trigger_time(p); \
+                                  if ((int16_t)(ts[i] - now) >= XCORE_C_PORT_MIN_GAP_TICKS) { \
+                                    _port_set_trigger_time(p, ts[i]); \
+                                  } \
+                                  else { \
+                                    late++; \
+                                  } \
+                                  _port_out(p, buf[i]); \
+                                } \
+                                *missed = late; \
+                              } while (0)) );
 }
 
 
@@ -805,11 +1233,13 @@ inline xcore_c_error_t port_in_shift_right_at_time(port p, int16_t t, uint32_t *
  */
 inline xcore_c_error_t port_in_when_pinseq(port p, port_type_t pt, uint32_t value, uint32_t *data)
 {
-  RETURN_EXCEPTION_OR_ERROR(  do { \
+  _XCORE_C_TRACE(trace_port_in, p);
+  _XCORE_C_TRACK_USE(p);
+  RETURN_EXCEPTION_OR_ERROR(  _XCORE_C_STATS_TRANSFER(p, 1, do { \
                                 _port_set_trigger_in_equal(p , value); \
                                 *data = _port_in(p); \
                                 if (pt==PORT_UNBUFFERED) _port_clear_trigger_in(p); \
-                              } while (0) );
+                              } while (0)) );
 }
 
 /** Input data from a port when its pins do not match a specific value.
@@ -832,11 +1262,58 @@ inline xcore_c_error_t port_in_when_pinseq(port p, port_type_t pt, uint32_t valu
  */
 inline xcore_c_error_t port_in_when_pinsneq(port p, port_type_t pt, uint32_t value, uint32_t *data)
 {
-  RETURN_EXCEPTION_OR_ERROR(  do { \
+  _XCORE_C_TRACE(trace_port_in, p);
+  _XCORE_C_TRACK_USE(p);
+  RETURN_EXCEPTION_OR_ERROR(  _XCORE_C_STATS_TRANSFER(p, 1, do { \
                                 _port_set_trigger_in_not_equal(p , value); \
                                 *data = _port_in(p); \
                                 if (pt==PORT_UNBUFFERED) _port_clear_trigger_in(p); \
-                              } while (0) );
+                              } while (0)) );
+}
+
+/** Capture the changes of an unbuffered port's pins.
+ *
+ *  Rather than sampling the pins on every port clock, only the time and new
+ *  value of each change is recorded. This allows a slowly changing bus to be
+ *  monitored for long periods using little memory. The function returns once
+ *  *n* changes have been recorded.
+ *
+ *  Each change is timestamped with the port counter, which wraps every 65536
+ *  port clock ticks, and with the reference time at which it was recorded.
+ *  The port timestamp gives the interval between close changes exactly; the
+ *  reference time gives the interval between distant changes to within the
+ *  few instructions needed to record each change, up to 2^32 reference clock
+ *  ticks. Changes which are closer together than those few instructions are
+ *  merged into a single change.
+ *
+ *  \param p      Unbuffered port to capture from
+ *  \param value  The current value of the pins, updated to the last value recorded
+ *  \param buf    The changes recorded
+ *  \param n      The number of changes to record
+ *
+ *  \return     error_none (or exception type if policy is XCORE_C_NO_EXCEPTION).
+ *
+ *  \exception  ET_ILLEGAL_RESOURCE   not a valid port, or on XS1 the xC timer
+ *                                    has been deallocated.
+ *  \exception  ET_RESOURCE_DEP       another core is actively changing the port.
+ *  \exception  ET_LOAD_STORE         invalid *\*value* or *buf[]* argument.
+ */
+inline xcore_c_error_t port_capture_edges(port p, uint32_t *value, port_edge_t buf[], size_t n)
+{
+  _XCORE_C_TRACE(trace_port_in, p);
+  _XCORE_C_TRACK_USE(p);
+  RETURN_EXCEPTION_OR_ERROR(  _XCORE_C_STATS_TRANSFER(p, n, do { \
+                                uint32_t v = *value; \
+                                for (size_t i = 0; i < n; i++) { \
+                                  _port_set_trigger_in_not_equal(p, v); \
+                                  v = _port_in(p); \
+                                  buf[i].time = _port_get_trigger_time(p); \
+                                  buf[i].ref_time = _hwtimer_core_get_time(); \
+                                  buf[i].value = v; \
+                                } \
+                                _port_clear_trigger_in(p); \
+                                *value = v; \
+                              } while (0)) );
 }
 
 
@@ -860,11 +1337,13 @@ inline xcore_c_error_t port_in_when_pinsneq(port p, port_type_t pt, uint32_t val
  */
 inline xcore_c_error_t port_in_shift_right_when_pinseq(port p, port_type_t pt, uint32_t value, uint32_t *data)
 {
-  RETURN_EXCEPTION_OR_ERROR(  do { \
+  _XCORE_C_TRACE(trace_port_in, p);
+  _XCORE_C_TRACK_USE(p);
+  RETURN_EXCEPTION_OR_ERROR(  _XCORE_C_STATS_TRANSFER(p, 1, do { \
                                 _port_set_trigger_in_equal(p , value); \
                                 _port_in_shift_right(p, data); \
                                 if (pt==PORT_UNBUFFERED) _port_clear_trigger_in(p); \
-                              } while (0) );
+                              } while (0)) );
 }
 
 /** Input data from a port when its pins do not
@@ -888,11 +1367,13 @@ inline xcore_c_error_t port_in_shift_right_when_pinseq(port p, port_type_t pt, u
  */
 inline xcore_c_error_t port_in_shift_right_when_pinsneq(port p, port_type_t pt, uint32_t value, uint32_t *data)
 {
-  RETURN_EXCEPTION_OR_ERROR(  do { \
+  _XCORE_C_TRACE(trace_port_in, p);
+  _XCORE_C_TRACK_USE(p);
+  RETURN_EXCEPTION_OR_ERROR(  _XCORE_C_STATS_TRANSFER(p, 1, do { \
                                 _port_set_trigger_in_not_equal(p , value); \
                                 _port_in_shift_right(p, data); \
                                 if (pt==PORT_UNBUFFERED) _port_clear_trigger_in(p); \
-                              } while (0) );
+                              } while (0)) );
 }
 
 /** Clears the buffer used by a port.
@@ -6,6 +6,7 @@
 #if !defined(__XC__) || defined(__DOXYGEN__)
 
 #include <stdint.h>
+#include <stddef.h>
 #include "xcore_c_port_impl.h"
 #include "xcore_c_clock_impl.h"
 #include "xcore_c_exception_impl.h"
@@ -254,6 +255,112 @@ port_protocol_out_strobed_slave(port p, port readyin, clock clk, uint32_t initia
                               } while (0) );
 }
 
+/** Configure a group of ports to be clocked by one clock block.
+ *
+ *  Each port is connected to the clock and its buffer is cleared. The clock's
+ *  source and divide should be configured (using clock_set_source_port() et al)
+ *  before the group is started by port_protocol_group_start(). The clock must
+ *  not be running.
+ *
+ *  Ports given a first value to output must be buffered (using
+ *  port_set_buffered()). The value is output before the clock is started, and
+ *  an output to an unbuffered port would wait for a clock edge which never
+ *  comes.
+ *
+ *  \param p    The ports to configure
+ *  \param n    The number of ports
+ *  \param clk  The clock used to configure the ports
+ *
+ *  \return     error_none (or exception type if policy is XCORE_C_NO_EXCEPTION).
+ *
+ *  \exception  ET_ILLEGAL_RESOURCE   not a valid port/clock
+ *                                    or clock is running.
+ *  \exception  ET_RESOURCE_DEP       another core is actively changing a port/clock
+ *  \exception  ET_LOAD_STORE         invalid *p[]* argument.
+ */
+inline xcore_c_error_t
+port_protocol_group_setup(const port p[], size_t n, clock clk)
+{
+  RETURN_EXCEPTION_OR_ERROR(  do { \
+                                for (size_t i = 0; i < n; i++) { \
+                                  _port_set_clock(p[i], clk); \
+                                  _port_clear_buffer(p[i]); \
+                                } \
+                              } while (0) );
+}
+
+/** Start a group of ports together on the same clock edge.
+ *
+ *  The first value for each port is placed in its buffer and then the clock
+ *  is started. Starting the clock resets the counters of all the ports it
+ *  clocks, so the values are driven on the same edge and the ports' timestamps
+ *  remain aligned, allowing multi-lane data to be transferred cycle aligned.
+ *
+ *  The ports must have been configured by port_protocol_group_setup(), and
+ *  must be buffered if *data* is given. The clock must not be running.
+ *
+ *  \param p     The ports to start
+ *  \param data  The first value to output on each port, or null if the ports
+ *               are inputs
+ *  \param n     The number of ports
+ *  \param clk   The clock used to configure the ports
+ *
+ *  \return     error_none (or exception type if policy is XCORE_C_NO_EXCEPTION).
+ *
+ *  \exception  ET_ILLEGAL_RESOURCE   not a valid port/clock.
+ *  \exception  ET_RESOURCE_DEP       another core is actively changing a port/clock
+ *  \exception  ET_LOAD_STORE         invalid *p[]* or *data[]* argument.
+ */
+inline xcore_c_error_t
+port_protocol_group_start(const port p[], const uint32_t data[], size_t n, clock clk)
+{
+  RETURN_EXCEPTION_OR_ERROR(  do { \
+                                for (size_t i = 0; data && i < n; i++) { \
+                                  _port_out(p[i], data[i]); \
+                                } \
+                                _clock_start(clk); \
+                              } while (0) );
+}
+
+/** Start a group of ports together at a specified port timestamp.
+ *
+ *  This is the same as port_protocol_group_start(), except that each port's
+ *  first transfer takes place when its counter reaches *t*. As the counters are
+ *  reset when the clock starts, the first value is output (or the first input
+ *  begins) on the same clock edge for every port, leaving time for the
+ *  application to prepare the following values.
+ *
+ *  Output ports must be buffered, so that the timed outputs are held in their
+ *  buffers until the clock is started. On an unbuffered port the output would
+ *  wait for time *t* on a clock which is not yet running, and never return.
+ *
+ *  \param p     The ports to start
+ *  \param data  The first value to output on each port, or null if the ports
+ *               are inputs
+ *  \param n     The number of ports
+ *  \param clk   The clock used to configure the ports
+ *  \param t     The port timestamp of the first transfer
+ *
+ *  \return     error_none (or exception type if policy is XCORE_C_NO_EXCEPTION).
+ *
+ *  \exception  ET_ILLEGAL_RESOURCE   not a valid port/clock.
+ *  \exception  ET_RESOURCE_DEP       another core is actively changing a port/clock
+ *  \exception  ET_LOAD_STORE         invalid *p[]* or *data[]* argument.
+ */
+inline xcore_c_error_t
+port_protocol_group_start_at_time(const port p[], const uint32_t data[], size_t n, clock clk, int16_t t)
+{
+  RETURN_EXCEPTION_OR_ERROR(  do { \
+                                for (size_t i = 0; i < n; i++) { \
+                                  _port_set_trigger_time(p[i], t); \
+                                  if (data) { \
+                                    _port_out(p[i], data[i]); \
+                                  } \
+                                } \
+                                _clock_start(clk); \
+                              } while (0) );
+}
+
 #endif // !defined(__XC__)
 
 #endif // __xcore_c_port_protocol_h__
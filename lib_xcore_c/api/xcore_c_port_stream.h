@@ -0,0 +1,124 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+
+#ifndef __xcore_c_port_stream_h__
+#define __xcore_c_port_stream_h__
+
+#if !defined(__XC__) || defined(__DOXYGEN__)
+
+#include <stdint.h>
+#include <stddef.h>
+#include "xcore_c_port_stream_impl.h"
+#include "xcore_c_port_impl.h"
+#include "xcore_c_chan_impl.h"
+#include "xcore_c_exception_impl.h"
+#include "xcore_c_trace_impl.h"
+#include "xcore_c_stats_impl.h"
+
+/** Initialise a port stream.
+ *
+ *  A port stream continuously inputs words from a buffered port into a ring of
+ *  *num_bufs* buffers, each of *words* words, which are held consecutively in *buf[]*.
+ *  As each buffer is filled its address is output on the streaming chan-end *c*,
+ *  to be received using port_stream_get_buffer() (which may be selected upon).
+ *  The consumer must have finished with a buffer before the stream wraps round
+ *  to refill it, so at least two buffers should be used.
+ *
+ *  The port must already be allocated using port_alloc_buffered() and
+ *  configured, for example using port_set_clock().
+ *
+ *  \param s        The port stream to initialise
+ *  \param p        The buffered port to input from
+ *  \param buf      The memory for the buffers, at least *words* * *num_bufs* words
+ *  \param words    The number of words in each buffer
+ *  \param num_bufs The number of buffers
+ *  \param c        The streaming chan-end the filled buffers are signalled on
+ *
+ *  \return     error_none
+ */
+inline xcore_c_error_t port_stream_init(port_stream_t *s, port p, uint32_t buf[],
+                                        size_t words, size_t num_bufs,
+                                        streaming_chanend_t c)
+{
+  s->p = p;
+  s->buf = buf;
+  s->words = words;
+  s->bufs = num_bufs;
+  s->c = c;
+  s->stop = 0;
+  return error_none;
+}
+
+/** Run a port stream.
+ *
+ *  This function fills the stream's buffers from the port until port_stream_stop()
+ *  is called, and should be called on a logical core dedicated to the stream.
+ *  Each buffer is filled by a tight loop with no per-word function call,
+ *  so data is not lost provided the port's transfer period is longer than a few
+ *  instructions. The buffered port absorbs the short gap while a full buffer is
+ *  signalled.
+ *
+ *  When the stream is stopped, the buffer being filled is completed and
+ *  signalled, followed by a null buffer address to mark the end of the stream.
+ *
+ *  \param s    The initialised port stream
+ *
+ *  \return     error_none (or exception type if policy is XCORE_C_NO_EXCEPTION).
+ *
+ *  \exception  ET_ILLEGAL_RESOURCE   not a valid port or chan-end.
+ *  \exception  ET_RESOURCE_DEP       another core is actively using the port or chan-end.
+ *  \exception  ET_LOAD_STORE         invalid *\*s* argument or buffer memory.
+ */
+inline xcore_c_error_t port_stream_in(port_stream_t *s)
+{
+  RETURN_EXCEPTION_OR_ERROR(  do { \
+                                uint32_t *next = s->buf; \
+                                uint32_t *end = s->buf + s->words * s->bufs; \
+                                while (!s->stop) { \
+                                  _XCORE_C_TRACE(trace_port_in, s->p); \
+                                  _XCORE_C_STATS_TRANSFER(s->p, s->words, \
+                                      _port_stream_fill(s->p, next, s->words)); \
+                                  _port_stream_out_buffer(s->c, next); \
+                                  next += s->words; \
+                                  if (next == end) { \
+                                    next = s->buf; \
+                                  } \
+                                } \
+                                _port_stream_out_buffer(s->c, 0); \
+                              } while (0) );
+}
+
+/** Stop a port stream.
+ *
+ *  This function may be called from any logical core on the same tile as
+ *  the one running port_stream_in(), or from a callback.
+ *
+ *  \param s    The running port stream
+ *
+ *  \return     error_none
+ */
+inline xcore_c_error_t port_stream_stop(port_stream_t *s)
+{
+  s->stop = 1;
+  return error_none;
+}
+
+/** Receive the next filled buffer of a port stream.
+ *
+ *  \param c    The streaming chan-end connected to the stream's chan-end
+ *  \param buf  The filled buffer, which holds the number of words passed to
+ *              port_stream_init(), or null if the stream has stopped
+ *
+ *  \return     error_none (or exception type if policy is XCORE_C_NO_EXCEPTION).
+ *
+ *  \exception  ET_ILLEGAL_RESOURCE   not an allocated chan-end.
+ *  \exception  ET_RESOURCE_DEP       another core is actively using the chan-end.
+ *  \exception  ET_LOAD_STORE         invalid *\*buf* argument.
+ */
+inline xcore_c_error_t port_stream_get_buffer(streaming_chanend_t c, uint32_t **buf)
+{
+  RETURN_EXCEPTION_OR_ERROR( *buf = _port_stream_in_buffer(c) );
+}
+
+#endif // !defined(__XC__)
+
+#endif // __xcore_c_port_stream_h__
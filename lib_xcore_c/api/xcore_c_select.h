@@ -18,7 +18,7 @@
  *  On XS1 the environment vectors (EVs) are only 16-bit and bit 16 will be set
  *  to 1 as it is expected to be used as a memory address.
 */
-#if defined(__XS2A__)
+#if defined(__XS2A__) || XCORE_C_HOST
 #define ENUM_ID_BASE 0
 #else
 #define ENUM_ID_BASE 0x10000
@@ -37,7 +37,11 @@
  */
 inline xcore_c_error_t select_disable_trigger_all(void)
 {
+#if XCORE_C_HOST
+  _host_clre();
+#else
   asm volatile("clre");
+#endif
   return error_none;
 }
 
@@ -102,6 +106,18 @@ uint32_t select_wait_ordered(const resource_t ids[]);
  */
 uint32_t select_no_wait_ordered(uint32_t no_wait_id, const resource_t ids[]);
 
+#if (XCORE_C_TRACE || XCORE_C_STATS) && !defined(__DOXYGEN__)
+// Instrument the entry to, and the enum_id returned by, the selects.
+#define select_wait() \
+    (_select_wait_begin(), _select_wait_end(select_wait()))
+#define select_wait_ordered(ids) \
+    (_select_wait_begin(), _select_wait_end(select_wait_ordered(ids)))
+#define select_no_wait(no_wait_id) \
+    _select_no_wait_end(select_no_wait(no_wait_id))
+#define select_no_wait_ordered(no_wait_id, ids) \
+    _select_no_wait_end(select_no_wait_ordered((no_wait_id), (ids)))
+#endif
+
 /** Define a select callback handling function
  *
  *  This macro will define two functions for you:
@@ -0,0 +1,195 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+
+#ifndef __xcore_c_spi_h__
+#define __xcore_c_spi_h__
+
+#if !defined(__XC__) || defined(__DOXYGEN__)
+
+#include <stdint.h>
+#include <stddef.h>
+#include "xcore_c_spi_impl.h"
+#include "xcore_c_exception_impl.h"
+#include "xcore_c_trace_impl.h"
+#include "xcore_c_stats_impl.h"
+
+/** Initialise an SPI master.
+ *
+ *  The master uses SPI mode 3: the bit clock idles high, data is driven on its
+ *  falling edge and sampled on its rising edge. Data is transferred most
+ *  significant bit first. Slave select signals are driven by the application,
+ *  for example using port_out().
+ *
+ *  The bit clock is generated by a 32-bit buffered port, so it only runs while
+ *  data is being transferred. *clk_sclk* clocks this port, and must already be
+ *  configured but not running. The bit clock runs at half of its rate, so it is
+ *  25MHz / *divide* when clk_sclk is the reference clock divided using
+ *  clock_set_divide() (or 50MHz with no divide). *clk_data* is sourced from the
+ *  bit clock port and clocks the data ports. Both clock blocks are started by
+ *  this function. To change the rate afterwards, stop clk_sclk, change its
+ *  divide and start it again.
+ *
+ *  The ports must already be allocated.
+ *
+ *  \param spi       The master to initialise
+ *  \param clk_sclk  The clock block for the bit clock port
+ *  \param clk_data  The clock block for the data ports
+ *  \param p_sclk    A 1-bit port to output the bit clock on
+ *  \param p_mosi    A 1-bit port to output data on
+ *  \param p_miso    A 1-bit port to input data from
+ *
+ *  \return     error_none (or exception type if policy is XCORE_C_NO_EXCEPTION).
+ *
+ *  \exception  ET_ILLEGAL_RESOURCE   not a valid port or clock,
+ *                                    or a clock is running.
+ *  \exception  ET_RESOURCE_DEP       another core is actively changing a port or clock.
+ *  \exception  ET_LOAD_STORE         invalid *\*spi* argument.
+ */
+inline xcore_c_error_t spi_master_init(spi_master_t *spi, clock clk_sclk, clock clk_data,
+                                       port p_sclk, port p_mosi, port p_miso)
+{
+  RETURN_EXCEPTION_OR_ERROR(  do { \
+                                spi->p_sclk = p_sclk; \
+                                spi->p_mosi = p_mosi; \
+                                spi->p_miso = p_miso; \
+                                _spi_configure_port(p_sclk, clk_sclk); \
+                                _clock_set_source_port(clk_data, p_sclk); \
+                                _spi_configure_port(p_mosi, clk_data); \
+                                _spi_configure_port(p_miso, clk_data); \
+                                _clock_start(clk_sclk); \
+                                _clock_start(clk_data); \
+                                _port_out(p_sclk, _SPI_SCLK_IDLE); \
+                              } while (0) );
+}
+
+/** Transfer words to and from an SPI slave.
+ *
+ *  Each word is output while the next word is input, without gaps in the bit
+ *  clock between words provided the logical core keeps up with the bit clock.
+ *  The words are bit reversed as they pass through the ports, rather than
+ *  being shifted out a bit at a time.
+ *
+ *  \param spi  The initialised master
+ *  \param out  The words to output, or null to output all ones
+ *  \param in   The words input, or null to discard them
+ *  \param n    The number of words to transfer
+ *
+ *  \return     error_none (or exception type if policy is XCORE_C_NO_EXCEPTION).
+ *
+ *  \exception  ET_ILLEGAL_RESOURCE   not a valid port.
+ *  \exception  ET_RESOURCE_DEP       another core is actively using a port.
+ *  \exception  ET_LOAD_STORE         invalid *\*spi*, *out[]* or *in[]* argument.
+ */
+inline xcore_c_error_t spi_master_transfer_words(const spi_master_t *spi, const uint32_t out[], uint32_t in[], size_t n)
+{
+  _XCORE_C_TRACE(trace_port_out, spi->p_mosi);
+  _XCORE_C_TRACK_USE(spi->p_mosi);
+  RETURN_EXCEPTION_OR_ERROR( _XCORE_C_STATS_TRANSFER(spi->p_mosi, n, \
+                               _spi_transfer(spi->p_sclk, spi->p_mosi, spi->p_miso, out, in, n, 32)) );
+}
+
+/** Transfer bytes to and from an SPI slave.
+ *
+ *  As spi_master_transfer_words(), but transferring bytes.
+ *
+ *  \param spi  The initialised master
+ *  \param out  The bytes to output, or null to output all ones
+ *  \param in   The bytes input, or null to discard them
+ *  \param n    The number of bytes to transfer
+ *
+ *  \return     error_none (or exception type if policy is XCORE_C_NO_EXCEPTION).
+ *
+ *  \exception  ET_ILLEGAL_RESOURCE   not a valid port.
+ *  \exception  ET_RESOURCE_DEP       another core is actively using a port.
+ *  \exception  ET_LOAD_STORE         invalid *\*spi*, *out[]* or *in[]* argument.
+ */
+inline xcore_c_error_t spi_master_transfer_bytes(const spi_master_t *spi, const uint8_t out[], uint8_t in[], size_t n)
+{
+  _XCORE_C_TRACE(trace_port_out, spi->p_mosi);
+  _XCORE_C_TRACK_USE(spi->p_mosi);
+  RETURN_EXCEPTION_OR_ERROR( _XCORE_C_STATS_TRANSFER(spi->p_mosi, n, \
+                               _spi_transfer(spi->p_sclk, spi->p_mosi, spi->p_miso, out, in, n, 8)) );
+}
+
+/** Initialise an SPI slave.
+ *
+ *  The slave uses SPI mode 3, as spi_master_init(). The clock block's source is
+ *  set to the bit clock port, so the clock block must not be running. It is
+ *  started by this function.
+ *
+ *  The ports must already be allocated.
+ *
+ *  \param spi     The slave to initialise
+ *  \param clk     The clock block to clock the data ports from the bit clock
+ *  \param p_sclk  A 1-bit port to input the bit clock from
+ *  \param p_mosi  A 1-bit port to input data from
+ *  \param p_miso  A 1-bit port to output data on
+ *
+ *  \return     error_none (or exception type if policy is XCORE_C_NO_EXCEPTION).
+ *
+ *  \exception  ET_ILLEGAL_RESOURCE   not a valid port or clock,
+ *                                    or the clock is running.
+ *  \exception  ET_RESOURCE_DEP       another core is actively changing a port or clock.
+ *  \exception  ET_LOAD_STORE         invalid *\*spi* argument.
+ */
+inline xcore_c_error_t spi_slave_init(spi_slave_t *spi, clock clk, port p_sclk, port p_mosi, port p_miso)
+{
+  RETURN_EXCEPTION_OR_ERROR(  do { \
+                                spi->p_miso = p_miso; \
+                                spi->p_mosi = p_mosi; \
+                                _clock_set_source_port(clk, p_sclk); \
+                                _spi_configure_port(p_mosi, clk); \
+                                _spi_configure_port(p_miso, clk); \
+                                _clock_start(clk); \
+                              } while (0) );
+}
+
+/** Transfer words to and from an SPI master.
+ *
+ *  This must be called before the master starts the transfer, so that the
+ *  first word is ready to output on the first falling edge of the bit clock.
+ *
+ *  \param spi  The initialised slave
+ *  \param out  The words to output, or null to output all ones
+ *  \param in   The words input, or null to discard them
+ *  \param n    The number of words to transfer
+ *
+ *  \return     error_none (or exception type if policy is XCORE_C_NO_EXCEPTION).
+ *
+ *  \exception  ET_ILLEGAL_RESOURCE   not a valid port.
+ *  \exception  ET_RESOURCE_DEP       another core is actively using a port.
+ *  \exception  ET_LOAD_STORE         invalid *\*spi*, *out[]* or *in[]* argument.
+ */
+inline xcore_c_error_t spi_slave_transfer_words(const spi_slave_t *spi, const uint32_t out[], uint32_t in[], size_t n)
+{
+  _XCORE_C_TRACE(trace_port_in, spi->p_mosi);
+  _XCORE_C_TRACK_USE(spi->p_mosi);
+  RETURN_EXCEPTION_OR_ERROR( _XCORE_C_STATS_TRANSFER(spi->p_mosi, n, \
+                               _spi_transfer(0, spi->p_miso, spi->p_mosi, out, in, n, 32)) );
+}
+
+/** Transfer bytes to and from an SPI master.
+ *
+ *  As spi_slave_transfer_words(), but transferring bytes.
+ *
+ *  \param spi  The initialised slave
+ *  \param out  The bytes to output, or null to output all ones
+ *  \param in   The bytes input, or null to discard them
+ *  \param n    The number of bytes to transfer
+ *
+ *  \return     error_none (or exception type if policy is XCORE_C_NO_EXCEPTION).
+ *
+ *  \exception  ET_ILLEGAL_RESOURCE   not a valid port.
+ *  \exception  ET_RESOURCE_DEP       another core is actively using a port.
+ *  \exception  ET_LOAD_STORE         invalid *\*spi*, *out[]* or *in[]* argument.
+ */
+inline xcore_c_error_t spi_slave_transfer_bytes(const spi_slave_t *spi, const uint8_t out[], uint8_t in[], size_t n)
+{
+  _XCORE_C_TRACE(trace_port_in, spi->p_mosi);
+  _XCORE_C_TRACK_USE(spi->p_mosi);
+  RETURN_EXCEPTION_OR_ERROR( _XCORE_C_STATS_TRANSFER(spi->p_mosi, n, \
+                               _spi_transfer(0, spi->p_miso, spi->p_mosi, out, in, n, 8)) );
+}
+
+#endif // !defined(__XC__)
+
+#endif // __xcore_c_spi_h__
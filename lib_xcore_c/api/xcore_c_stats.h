@@ -0,0 +1,128 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+
+#ifndef __xcore_c_stats_h__
+#define __xcore_c_stats_h__
+
+#include "xcore_c_stats_impl.h"
+
+#ifndef XCORE_C_STATS
+/** Enable the library's resource usage statistics.
+ *
+ *  The user may enable statistics by setting the XCORE_C_STATS define to 1
+ *  in their Makefile. When it is 0 (the default) the library's statistics
+ *  hooks are compiled out.
+ */
+#define XCORE_C_STATS 0
+#endif
+
+#ifndef XCORE_C_STATS_RESOURCES
+/** The number of resources which may be recorded in each stats_table_t.
+ *
+ *  The user may change the size of the statistics tables by setting the
+ *  XCORE_C_STATS_RESOURCES define in their Makefile.
+ */
+#define XCORE_C_STATS_RESOURCES 16
+#endif
+
+#if !defined(__XC__) || defined(__DOXYGEN__)
+
+#include <stddef.h>
+#include "xcore_c_resource_impl.h"
+#include "xcore_c_error_codes.h"
+
+/** Start collecting resource usage statistics for this logical core.
+ *
+ *  The table is emptied and will be updated by this logical core until
+ *  stats_stop() is called. A resource is added to the table the first time
+ *  that it is used, or has its select or interrupt event set up.
+ *  Events are counted against the resource they came from, for up to
+ *  XCORE_C_STATS_RESOURCES resources' events on each logical core.
+ *
+ *  \param t    The table to record into
+ *
+ *  \return     error_none
+ */
+inline xcore_c_error_t stats_start(stats_table_t *t)
+{
+  unsigned id = _stats_core_id();
+  t->count = 0;
+  t->last = 0;
+  t->untracked = 0;
+  t->waiting = 0;
+  _xcore_c_stats_tables[id] = t;
+  return error_none;
+}
+
+/** Stop collecting resource usage statistics for this logical core.
+ *
+ *  The contents of the table passed to stats_start() are left intact
+ *  so that they may be read.
+ *
+ *  \return     error_none
+ */
+inline xcore_c_error_t stats_stop(void)
+{
+  _xcore_c_stats_tables[_stats_core_id()] = 0;
+  return error_none;
+}
+
+/** Get the number of resources held in a statistics table.
+ *
+ *  \param t          The statistics table
+ *  \param count      The number of entries that may be read using stats_get_entry()
+ *  \param untracked  The number of operations not recorded because the table was full
+ *
+ *  \return     error_none
+ */
+inline xcore_c_error_t stats_get_count(const stats_table_t *t, size_t *count, size_t *untracked)
+{
+  *count = t->count;
+  *untracked = t->untracked;
+  return error_none;
+}
+
+/** Read an entry from a statistics table.
+ *
+ *  Entries are held in the order that the resources were first used.
+ *
+ *  \param t      The statistics table
+ *  \param n      The index of the entry, less than the count returned by stats_get_count()
+ *  \param entry  The statistics of the resource
+ *
+ *  \return     error_none
+ */
+inline xcore_c_error_t stats_get_entry(const stats_table_t *t, size_t n, stats_entry_t *entry)
+{
+  *entry = t->entry[n];
+  return error_none;
+}
+
+/** Read the statistics of a resource from a statistics table.
+ *
+ *  If the resource is not held in the table, an entry with all the
+ *  counts set to zero is returned.
+ *
+ *  \param t      The statistics table
+ *  \param r      The resource
+ *  \param entry  The statistics of the resource
+ *
+ *  \return     error_none
+ */
+inline xcore_c_error_t stats_get_resource(const stats_table_t *t, resource_t r, stats_entry_t *entry)
+{
+  entry->resource = r;
+  entry->events = 0;
+  entry->transfers = 0;
+  entry->blocked = 0;
+  for (size_t i = 0; i < t->count; i++) {
+    if (t->entry[i].resource == r) {
+      *entry = t->entry[i];
+      break;
+    }
+  }
+  return error_none;
+}
+
+#endif // !defined(__XC__)
+
+#endif // __xcore_c_stats_h__
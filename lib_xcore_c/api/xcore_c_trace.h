@@ -0,0 +1,130 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+
+#ifndef __xcore_c_trace_h__
+#define __xcore_c_trace_h__
+
+#include "xcore_c_trace_impl.h"
+
+#ifndef XCORE_C_TRACE
+/** Enable the library's event tracing.
+ *
+ *  The user may enable tracing by setting the XCORE_C_TRACE define to 1
+ *  in their Makefile. When it is 0 (the default) the library's trace hooks
+ *  and trace_record() are compiled out.
+ */
+#define XCORE_C_TRACE 0
+#endif
+
+#ifndef XCORE_C_TRACE_ENTRIES
+/** The number of records held by each trace_buffer_t.
+ *
+ *  The user may change the size of the trace buffers by setting the
+ *  XCORE_C_TRACE_ENTRIES define in their Makefile. It must be a power of two.
+ *  Each record is three words.
+ */
+#define XCORE_C_TRACE_ENTRIES 64
+#endif
+
+#if !defined(__XC__) || defined(__DOXYGEN__)
+
+#include <stdint.h>
+#include <stddef.h>
+#include "xcore_c_error_codes.h"
+
+/** Start tracing this logical core into a trace buffer.
+ *
+ *  The buffer is emptied and will receive the records made by this logical core
+ *  until trace_stop() is called. Once full, the oldest records are overwritten.
+ *  Each logical core which is to be traced must call trace_start() with its
+ *  own buffer.
+ *
+ *  The records are timestamped using the logical core's xC timer
+ *  (see hwtimer_core_get_time()).
+ *
+ *  \param buf  The trace buffer to record into
+ *
+ *  \return     error_none
+ */
+inline xcore_c_error_t trace_start(trace_buffer_t *buf)
+{
+  unsigned id = _trace_core_id();
+  buf->magic = _XCORE_C_TRACE_MAGIC;
+  buf->core_id = id;
+  buf->size = XCORE_C_TRACE_ENTRIES;
+  buf->count = 0;
+  _xcore_c_trace_buffers[id] = buf;
+  return error_none;
+}
+
+/** Stop tracing this logical core.
+ *
+ *  The contents of the trace buffer passed to trace_start() are left intact
+ *  so that they may be read back or dumped.
+ *
+ *  \return     error_none
+ */
+inline xcore_c_error_t trace_stop(void)
+{
+  _xcore_c_trace_buffers[_trace_core_id()] = 0;
+  return error_none;
+}
+
+/** Record an application event in this logical core's trace buffer.
+ *
+ *  Nothing is recorded if XCORE_C_TRACE is 0, or if trace_start() has not
+ *  been called on this logical core.
+ *
+ *  \param event  The event identifier, which should be trace_user or greater
+ *  \param arg    An event specific argument
+ *
+ *  \return     error_none
+ */
+inline xcore_c_error_t trace_record(uint32_t event, uint32_t arg)
+{
+  _XCORE_C_TRACE(event, arg);
+  return error_none;
+}
+
+/** Get the number of records held in a trace buffer.
+ *
+ *  \param buf    The trace buffer
+ *  \param count  The number of records that may be read using trace_get_entry()
+ *  \param lost   The number of older records which have been overwritten
+ *
+ *  \return     error_none
+ */
+inline xcore_c_error_t trace_get_count(const trace_buffer_t *buf, size_t *count, size_t *lost)
+{
+  if (buf->count > XCORE_C_TRACE_ENTRIES) {
+    *count = XCORE_C_TRACE_ENTRIES;
+    *lost = buf->count - XCORE_C_TRACE_ENTRIES;
+  }
+  else {
+    *count = buf->count;
+    *lost = 0;
+  }
+  return error_none;
+}
+
+/** Read a record from a trace buffer.
+ *
+ *  Records are indexed from the oldest record held, at index 0, to the newest,
+ *  at the count returned by trace_get_count() less one.
+ *
+ *  \param buf    The trace buffer
+ *  \param n      The index of the record to read
+ *  \param entry  The record
+ *
+ *  \return     error_none
+ */
+inline xcore_c_error_t trace_get_entry(const trace_buffer_t *buf, size_t n, trace_entry_t *entry)
+{
+  uint32_t first = buf->count > XCORE_C_TRACE_ENTRIES ?
+                   buf->count - XCORE_C_TRACE_ENTRIES : 0;
+  *entry = buf->entry[(first + n) & (XCORE_C_TRACE_ENTRIES - 1)];
+  return error_none;
+}
+
+#endif // !defined(__XC__)
+
+#endif // __xcore_c_trace_h__
@@ -0,0 +1,106 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+
+#ifndef __xcore_c_track_h__
+#define __xcore_c_track_h__
+
+#include "xcore_c_track_impl.h"
+
+#ifndef XCORE_C_TRACK
+/** Enable the library's resource tracker.
+ *
+ *  The user may enable the tracker in debug builds by setting the
+ *  XCORE_C_TRACK define to 1 in their Makefile. Every chan-end, timer, lock
+ *  and port allocated and freed by the library is then tracked in a table
+ *  for the tile. Freeing a resource twice, using a chan-end, timer, lock or
+ *  port after it has been freed, or using a resource whose allocation failed,
+ *  raises ET_ECALL at the library call which did so. When it is 0 (the
+ *  default) the tracking hooks are compiled out.
+ */
+#define XCORE_C_TRACK 0
+#endif
+
+#if !defined(__XC__) || defined(__DOXYGEN__)
+
+#include <stdint.h>
+#include <string.h>
+#include "xcore_c_resource_impl.h"
+#include "xcore_c_error_codes.h"
+
+// Returns the resource tracked in a slot.
+extern uint32_t _track_resource(int slot);  // Implemented in xcore_c_track.c
+
+/** Take a snapshot of the resources allocated on the tile.
+ *
+ *  Leaks can be found by taking a snapshot before some work, and checking
+ *  for resources left allocated afterwards using track_get_leak().
+ *
+ *  \param m    The snapshot
+ *
+ *  \return     error_none
+ */
+inline xcore_c_error_t track_mark(track_mark_t *m)
+{
+  memcpy(m->state, _xcore_c_track_state, sizeof(m->state));
+  return error_none;
+}
+
+/** Find a resource leaked since a snapshot.
+ *
+ *  \param m    The snapshot taken by track_mark()
+ *  \param r    A resource allocated now but not when the snapshot was taken,
+ *              or 0 if there is none
+ *
+ *  \return     error_none
+ */
+inline xcore_c_error_t track_get_leak(const track_mark_t *m, resource_t *r)
+{
+  *r = 0;
+  for (int i = 0; i < _XCORE_C_TRACK_SLOTS; i++) {
+    if (_xcore_c_track_state[i] == _XCORE_C_TRACK_ALLOCATED &&
+        m->state[i] != _XCORE_C_TRACK_ALLOCATED) {
+      *r = _track_resource(i);
+      break;
+    }
+  }
+  return error_none;
+}
+
+/** Get the last fault found by the tracker on this logical core.
+ *
+ *  \param fault  The fault, or track_fault_none if there has been none
+ *  \param r      The resource misused
+ *
+ *  \return     error_none
+ */
+inline xcore_c_error_t track_get_fault(track_fault_t *fault, resource_t *r)
+{
+  const _xcore_c_track_fault_t *f = &_xcore_c_track_faults[_error_core_id()];
+  *fault = f->fault;
+  *r = f->resource;
+  return error_none;
+}
+
+/** Get the number of failed allocations of a type of resource on the tile.
+ *
+ *  An allocation fails when all the resources of its type are in use.
+ *
+ *  \param type   The resource type: XS1_RES_TYPE_CHANEND, XS1_RES_TYPE_TIMER
+ *                or XS1_RES_TYPE_LOCK
+ *  \param count  The number of allocations which returned 0
+ *
+ *  \return     error_none
+ */
+inline xcore_c_error_t track_get_exhausted(uint32_t type, uint32_t *count)
+{
+  *count = 0;
+  if (type < _XCORE_C_TRACK_TYPES) {
+    for (int i = 0; i < _XCORE_C_TRACK_MAX_CORES; i++) {
+      *count += _xcore_c_track_exhausted[i][type];
+    }
+  }
+  return error_none;
+}
+
+#endif // !defined(__XC__)
+
+#endif // __xcore_c_track_h__
@@ -0,0 +1,141 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+
+#ifndef __xcore_c_uart_h__
+#define __xcore_c_uart_h__
+
+#if !defined(__XC__) || defined(__DOXYGEN__)
+
+#include <stdint.h>
+#include <stddef.h>
+#include "xcore_c_uart_impl.h"
+#include "xcore_c_resource_impl.h"
+#include "xcore_c_exception_impl.h"
+
+/** Initialise a UART receiver.
+ *
+ *  The receiver inputs 8 data bits, no parity and one stop bit. It is driven
+ *  by select events on its port, so one logical core can service many
+ *  receivers. Each bit is sampled in its middle using a port timestamp, so the
+ *  port must be an unbuffered 1-bit port clocked by the 100MHz reference clock
+ *  (the default). The bit time must fit the 16-bit port timestamp, so the baud
+ *  rate must be at least 3052.
+ *
+ *  The bytes received are held in *buf[]* until they are read using
+ *  uart_rx_get_byte(), which may be called from another logical core.
+ *
+ *  \param u     The receiver to initialise
+ *  \param p     The allocated port to receive on
+ *  \param baud  The baud rate
+ *  \param buf   The buffer for bytes received
+ *  \param size  The number of bytes *buf[]* holds
+ *
+ *  \return     error_none (or exception type if policy is XCORE_C_NO_EXCEPTION).
+ *
+ *  \exception  ET_LOAD_STORE         invalid *\*u* argument.
+ *  \exception  ET_ECALL              when xassert enabled, the baud rate is zero
+ *                                    or too low, or *size* is zero.
+ */
+inline xcore_c_error_t uart_rx_init(uart_rx_t *u, port p, uint32_t baud, uint8_t buf[], size_t size)
+{
+  xassert(baud && msg("Baud rate must be non-zero"));
+  xassert(_UART_PORT_CLOCK_HZ / baud < 0x8000 && msg("Baud rate too low for the port timestamp"));
+  xassert(size && msg("Receive buffer must hold at least one byte"));
+  RETURN_EXCEPTION_OR_ERROR(  do { \
+                                u->p = p; \
+                                u->bit_time = _UART_PORT_CLOCK_HZ / baud; \
+                                u->state = _UART_RX_IDLE; \
+                                u->buf = buf; \
+                                u->size = size; \
+                                u->written = 0; \
+                                u->read = 0; \
+                                u->overruns = 0; \
+                                u->framing_errors = 0; \
+                              } while (0) );
+}
+
+/** Setup select events on a UART receiver's port.
+ *
+ *  The port raises its event each time the receiver has a bit to sample.
+ *  When select_wait() (or one of its variants) returns *enum_id*,
+ *  uart_rx_handle_event() must be called. The event is enabled by this function,
+ *  and the receiver waits for a start bit.
+ *
+ *  \param u        The initialised receiver
+ *  \param enum_id  The value to be returned by select_wait() et al when the
+ *                  receiver's port event is triggered.
+ *                  On XS1 bit 16 must be set (see ENUM_ID_BASE)
+ *
+ *  \return     error_none (or exception type if policy is XCORE_C_NO_EXCEPTION).
+ *
+ *  \exception  ET_ILLEGAL_RESOURCE   not a valid port.
+ *  \exception  ET_RESOURCE_DEP       another core is actively changing the port.
+ *  \exception  ET_LOAD_STORE         invalid *\*u* argument.
+ *  \exception  ET_ECALL              when xassert enabled, on XS1 bit 16 not set in enum_id.
+ */
+inline xcore_c_error_t uart_rx_setup_select(uart_rx_t *u, uint32_t enum_id)
+{
+  RETURN_EXCEPTION_OR_ERROR(  do { \
+                                _resource_setup_select(u->p, enum_id); \
+                                _uart_rx_wait_start(u); \
+                                _resource_enable_trigger(u->p); \
+                              } while (0) );
+}
+
+/** Handle a select event from a UART receiver's port.
+ *
+ *  This samples the bit and sets the port up for the next one. It takes a few
+ *  instructions, so many receivers can be serviced by one logical core.
+ *  Each event must be handled within half a bit time to sample the bits
+ *  correctly.
+ *
+ *  When a complete byte has been received it is added to the receiver's
+ *  buffer. If the buffer is full the byte is discarded and counted as an overrun.
+ *  If the stop bit is not high the byte is discarded and counted as a framing
+ *  error.
+ *
+ *  \param u    The receiver whose port event was triggered
+ *
+ *  \return     error_none (or exception type if policy is XCORE_C_NO_EXCEPTION).
+ *
+ *  \exception  ET_ILLEGAL_RESOURCE   not a valid port.
+ *  \exception  ET_RESOURCE_DEP       another core is actively changing the port.
+ *  \exception  ET_LOAD_STORE         invalid *\*u* argument.
+ */
+inline xcore_c_error_t uart_rx_handle_event(uart_rx_t *u)
+{
+  RETURN_EXCEPTION_OR_ERROR( _uart_rx_event(u) );
+}
+
+/** Read the oldest byte received by a UART receiver, if there is one.
+ *
+ *  \param u         The receiver
+ *  \param data      The byte read
+ *  \param received  1 if a byte was read, or 0 if none had been received
+ *
+ *  \return     error_none (or exception type if policy is XCORE_C_NO_EXCEPTION).
+ *
+ *  \exception  ET_LOAD_STORE         invalid *\*u*, *\*data* or *\*received* argument.
+ */
+inline xcore_c_error_t uart_rx_get_byte(uart_rx_t *u, uint8_t *data, size_t *received)
+{
+  RETURN_EXCEPTION_OR_ERROR( *received = _uart_rx_get_byte(u, data) );
+}
+
+/** Get the number of errors seen by a UART receiver.
+ *
+ *  \param u               The receiver
+ *  \param overruns        The number of bytes discarded because the buffer was full
+ *  \param framing_errors  The number of bytes discarded because the stop bit was low
+ *
+ *  \return     error_none
+ */
+inline xcore_c_error_t uart_rx_get_errors(const uart_rx_t *u, uint32_t *overruns, uint32_t *framing_errors)
+{
+  *overruns = u->overruns;
+  *framing_errors = u->framing_errors;
+  return error_none;
+}
+
+#endif // !defined(__XC__)
+
+#endif // __xcore_c_uart_h__
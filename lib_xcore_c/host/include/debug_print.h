@@ -0,0 +1,24 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+
+#ifndef __debug_print_h__
+#define __debug_print_h__
+
+// The debug_printf interface of lib_logging, for building the library with
+// XCORE_C_HOST.
+
+#include <stdio.h>
+
+#ifndef DEBUG_PRINT_ENABLE
+#define DEBUG_PRINT_ENABLE 0
+#endif
+
+#if DEBUG_PRINT_ENABLE
+// Printing takes XCORE_C_HOST_PRINT_TICKS of the logical core's time.
+extern void _host_debug_printf(const char *fmt, ...)
+  __attribute__((format(printf, 1, 2)));
+#define debug_printf(...) _host_debug_printf(__VA_ARGS__)
+#else
+#define debug_printf(...) ((void)0)
+#endif
+
+#endif // __debug_print_h__
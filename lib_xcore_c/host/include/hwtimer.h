@@ -0,0 +1,11 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+
+#ifndef __hwtimer_h__
+#define __hwtimer_h__
+
+// The hwtimer_t type of the xCORE tools' hwtimer.h, for building the library
+// with XCORE_C_HOST.
+
+typedef unsigned hwtimer_t;
+
+#endif // __hwtimer_h__
@@ -0,0 +1,37 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+
+#ifndef __trycatch_h__
+#define __trycatch_h__
+
+// The TRY/CATCH interface of the xCORE tools' trycatch.h, for building the
+// library with XCORE_C_HOST. Exceptions raised by the host backend unwind to
+// the innermost TRY on the raising logical core using longjmp().
+
+#include <setjmp.h>
+
+typedef struct exception_t {
+  unsigned type;
+  unsigned data;
+} exception_t;
+
+typedef struct try_catch_t {
+  jmp_buf buf;
+  struct try_catch_t *prev;
+  exception_t exception;
+} try_catch_t;
+
+// Implemented in xcore_c_host.c
+extern void _host_try_enter(try_catch_t *tc);
+extern void _host_try_exit(try_catch_t *tc);
+extern void _host_throw(unsigned type, unsigned data);
+
+#define TRY \
+  try_catch_t _host_try; \
+  _host_try_enter(&_host_try); \
+  if (setjmp(_host_try.buf) == 0) \
+    for (int _host_try_once = 1; _host_try_once; _host_try_once = 0, _host_try_exit(&_host_try))
+
+#define CATCH(e) \
+  else if ((e = _host_try.exception), 1)
+
+#endif // __trycatch_h__
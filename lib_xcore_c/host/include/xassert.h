@@ -0,0 +1,25 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+
+#ifndef __xassert_h__
+#define __xassert_h__
+
+// The xassert interface of lib_logging, for building the library with
+// XCORE_C_HOST. A failed assertion raises ET_ECALL as it does on the xCORE.
+
+#include "trycatch.h"
+
+#ifndef XASSERT_ENABLE_ASSERTIONS
+#define XASSERT_ENABLE_ASSERTIONS 1
+#endif
+
+#define msg(m) 1
+#define fail(m) _host_throw(0x8, 0)
+#define unreachable(m) _host_throw(0x8, 0)
+
+#if XASSERT_ENABLE_ASSERTIONS
+#define xassert(e) do { if (!(e)) _host_throw(0x8, 0); } while (0)
+#else
+#define xassert(e) ((void)0)
+#endif
+
+#endif // __xassert_h__
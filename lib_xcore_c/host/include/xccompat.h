@@ -0,0 +1,15 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+
+#ifndef __xccompat_h__
+#define __xccompat_h__
+
+// The resource handle types of the xCORE tools' xccompat.h, for building the
+// library with XCORE_C_HOST.
+
+typedef unsigned chanend;
+typedef unsigned streaming_chanend_t;
+typedef unsigned timer;
+typedef unsigned port;
+typedef unsigned clock;
+
+#endif // __xccompat_h__
@@ -0,0 +1,118 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+
+#ifndef __xs1_h__
+#define __xs1_h__
+
+// The subset of the xCORE tools' xs1.h used by lib_xcore_c, for building the
+// library with XCORE_C_HOST.
+
+#define XS1_RES_TYPE_PORT           0x0
+#define XS1_RES_TYPE_TIMER          0x1
+#define XS1_RES_TYPE_CHANEND        0x2
+#define XS1_RES_TYPE_SYNC           0x3
+#define XS1_RES_TYPE_THREAD         0x4
+#define XS1_RES_TYPE_LOCK           0x5
+#define XS1_RES_TYPE_CLKBLK         0x6
+
+#define XS1_RES_ID_TYPE_SHIFT       0x0
+#define XS1_RES_ID_TYPE_MASK        0xff
+#define XS1_RES_ID_RESNUM_SHIFT     0x8
+#define XS1_RES_ID_RESNUM_MASK      0xff
+#define XS1_RES_ID_PORTWIDTH_SHIFT  0x10
+#define XS1_RES_ID_PORTWIDTH_MASK   0x3f
+
+#define XS1_SETC_INUSE_OFF          0x0
+#define XS1_SETC_INUSE_ON           0x8
+#define XS1_SETC_COND_NONE          0x1
+#define XS1_SETC_COND_AFTER         0x9
+#define XS1_SETC_COND_EQ            0x11
+#define XS1_SETC_COND_NEQ           0x19
+#define XS1_SETC_IE_MODE_EVENT      0x2
+#define XS1_SETC_IE_MODE_INTERRUPT  0xa
+#define XS1_SETC_RUN_STOPR          0x7
+#define XS1_SETC_RUN_STARTR         0xf
+#define XS1_SETC_RUN_CLRBUF         0x17
+#define XS1_SETC_MS_MASTER          0x1007
+#define XS1_SETC_MS_SLAVE           0x100f
+#define XS1_SETC_BUF_NOBUFFERS      0x2007
+#define XS1_SETC_BUF_BUFFERS        0x200f
+#define XS1_SETC_RDY_NOREADY        0x3007
+#define XS1_SETC_RDY_STROBED        0x300f
+#define XS1_SETC_RDY_HANDSHAKE      0x3017
+#define XS1_SETC_SDELAY_NOSDELAY    0x4007
+#define XS1_SETC_SDELAY_SDELAY      0x400f
+#define XS1_SETC_PORT_DATAPORT      0x5007
+#define XS1_SETC_PORT_CLOCKPORT     0x500f
+#define XS1_SETC_PORT_READYPORT     0x5017
+#define XS1_SETC_INV_NOINVERT       0x6007
+#define XS1_SETC_INV_INVERT         0x600f
+
+#define XS1_CT_END                  0x1
+#define XS1_CT_PAUSE                0x2
+#define XS1_CT_ACK                  0x3
+#define XS1_CT_NACK                 0x4
+
+#define XS1_ET_NONE                 0x0
+#define XS1_ET_LINK_ERROR           0x1
+#define XS1_ET_ILLEGAL_PC           0x2
+#define XS1_ET_ILLEGAL_INSTRUCTION  0x3
+#define XS1_ET_ILLEGAL_RESOURCE     0x4
+#define XS1_ET_LOAD_STORE           0x5
+#define XS1_ET_ILLEGAL_PS           0x6
+#define XS1_ET_ARITHMETIC           0x7
+#define XS1_ET_ECALL                0x8
+#define XS1_ET_RESOURCE_DEP         0x9
+#define XS1_ET_KCALL                0xf
+
+#define XS1_SR_EEBLE_MASK           0x1
+#define XS1_SR_IEBLE_MASK           0x2
+#define XS1_SR_INENB_MASK           0x4
+#define XS1_SR_ININT_MASK           0x8
+#define XS1_SR_INK_MASK             0x10
+#define XS1_SR_WAITING_MASK         0x40
+#define XS1_SR_FAST_MASK            0x80
+
+#define XS1_CLK_REF                 0x1
+#define XS1_CLK_XCORE               0x101
+
+#define XS1_CLKBLK_REF              0x6
+#define XS1_CLKBLK_1                0x106
+#define XS1_CLKBLK_2                0x206
+#define XS1_CLKBLK_3                0x306
+#define XS1_CLKBLK_4                0x406
+#define XS1_CLKBLK_5                0x506
+
+#define XS1_PORT_1A                 0x10000
+#define XS1_PORT_1B                 0x10100
+#define XS1_PORT_1C                 0x10200
+#define XS1_PORT_1D                 0x10300
+#define XS1_PORT_1E                 0x10400
+#define XS1_PORT_1F                 0x10500
+#define XS1_PORT_1G                 0x10600
+#define XS1_PORT_1H                 0x10700
+#define XS1_PORT_1I                 0x10800
+#define XS1_PORT_1J                 0x10900
+#define XS1_PORT_1K                 0x10a00
+#define XS1_PORT_1L                 0x10b00
+#define XS1_PORT_1M                 0x10c00
+#define XS1_PORT_1N                 0x10d00
+#define XS1_PORT_1O                 0x10e00
+#define XS1_PORT_1P                 0x10f00
+#define XS1_PORT_4A                 0x40000
+#define XS1_PORT_4B                 0x40100
+#define XS1_PORT_4C                 0x40200
+#define XS1_PORT_4D                 0x40300
+#define XS1_PORT_4E                 0x40400
+#define XS1_PORT_4F                 0x40500
+#define XS1_PORT_8A                 0x80000
+#define XS1_PORT_8B                 0x80100
+#define XS1_PORT_8C                 0x80200
+#define XS1_PORT_8D                 0x80300
+#define XS1_PORT_16A                0x100000
+#define XS1_PORT_16B                0x100100
+#define XS1_PORT_16C                0x100200
+#define XS1_PORT_16D                0x100300
+#define XS1_PORT_32A                0x200000
+#define XS1_PORT_32B                0x200100
+
+#endif // __xs1_h__
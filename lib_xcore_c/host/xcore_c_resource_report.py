@@ -0,0 +1,217 @@
+#!/usr/bin/env python
+# Copyright (c) 2016, XMOS Ltd, All rights reserved
+"""Report the resource budget of the tasks in an xCORE image.
+
+The tools, the library's assembly and its DEFINE_INTERRUPT_* macros emit
+symbols for each function giving the resources needed by it and everything it
+calls:
+
+  <function>.nstackwords   stack words
+  <function>.maxcores      logical cores
+  <function>.maxtimers     hardware timers
+  <function>.maxchanends   chan-ends
+
+For each task function this prints the stack it needs (and the part of it
+reserved as a kernel stack for interrupts, if it hosts interrupts), and its
+logical cores, timers and chan-ends. The tasks of a tile are totalled and
+compared with the tile's limits, the stack against the memory left by the
+image. The exit status is 1 if any limit is exceeded.
+
+The input is the ELF image of a tile, or an .xe file which is split into its
+tiles' images using xobjdump. By default the task is main(), which covers all
+the tasks started by it; name the tasks to see a per-task breakdown:
+
+  $ python xcore_c_resource_report.py bin/app.xe -t core0 -t core1
+"""
+import argparse
+import glob
+import os
+import shutil
+import struct
+import subprocess
+import sys
+import tempfile
+
+SHN_ABS = 0xfff1
+SHT_SYMTAB = 2
+SHF_ALLOC = 0x2
+
+RESOURCES = ('nstackwords', 'maxcores', 'maxtimers', 'maxchanends')
+
+# The name of the function wrapping a DEFINE_INTERRUPT_PERMITTED() root function.
+INTERRUPT_PERMITTED = '_xcore_c_interrupt_permitted_{}'
+
+# The resources of a tile, by architecture.
+TILE_LIMITS = {
+    'XS1': {'memory': 64 * 1024, 'cores': 8, 'timers': 10, 'chanends': 32},
+    'XS2': {'memory': 256 * 1024, 'cores': 8, 'timers': 10, 'chanends': 32},
+}
+
+
+class ImageError(Exception):
+    """An image which can't be read."""
+
+
+def stack_align(arch, words):
+    """The words of a stack frame, as _XCORE_C_STACK_ALIGN()."""
+    return (words + 1) // 2 * 2 if arch == 'XS2' else words
+
+
+def read_elf(path):
+    """Return (symbols, image_bytes) of an ELF32 image.
+
+    symbols maps the name of each absolute symbol to its value, and
+    image_bytes is the memory taken by its allocated sections.
+    """
+    with open(path, 'rb') as f:
+        data = f.read()
+    if data[:4] != b'\x7fELF' or data[4:6] != b'\x01\x01':
+        raise ImageError('{}: not a little-endian ELF32 image'.format(path))
+    try:
+        return read_sections(data)
+    except (struct.error, IndexError, ValueError, ZeroDivisionError):
+        raise ImageError('{}: truncated or corrupt ELF image'.format(path))
+
+
+def read_sections(data):
+    """Return (symbols, image_bytes) from the sections of an ELF32 image."""
+    shoff, = struct.unpack_from('<I', data, 0x20)
+    shentsize, shnum = struct.unpack_from('<HH', data, 0x2e)
+    sections = [struct.unpack_from('<10I', data, shoff + i * shentsize)
+                for i in range(shnum)]
+
+    image_bytes = 0
+    symbols = {}
+    for name, kind, flags, addr, offset, size, link, info, align, entsize in sections:
+        if flags & SHF_ALLOC:
+            image_bytes += size
+        if kind != SHT_SYMTAB:
+            continue
+        strtab = sections[link]
+        strings = data[strtab[4]:strtab[4] + strtab[5]]
+        for i in range(size // entsize):
+            st_name, value, st_size, st_info, st_other, shndx = \
+                struct.unpack_from('<IIIBBH', data, offset + i * entsize)
+            if shndx != SHN_ABS:
+                continue
+            end = strings.index(b'\0', st_name)
+            symbols[strings[st_name:end].decode()] = value
+    return symbols, image_bytes
+
+
+def task_budget(symbols, task, arch):
+    """Return the resources needed by a task, or None if it has no symbols."""
+    needs = {}
+    for resource in RESOURCES:
+        value = symbols.get('{}.{}'.format(task, resource))
+        if value is None:
+            return None
+        needs[resource] = value
+    # The kstack is carved from the stack of the wrapper of an interrupt
+    # permitted root function, after its own frame.
+    wrapper = symbols.get('{}.nstackwords'.format(INTERRUPT_PERMITTED.format(task)))
+    if wrapper is not None:
+        needs['kstackwords'] = wrapper - needs['nstackwords'] - stack_align(arch, 3)
+        needs['nstackwords'] = wrapper
+    else:
+        needs['kstackwords'] = 0
+    return needs
+
+
+def report(path, tasks, arch, memory):
+    """Print the budget of one tile's image. Returns 0 if it fits the tile."""
+    symbols, image_bytes = read_elf(path)
+    limits = dict(TILE_LIMITS[arch])
+    if memory:
+        limits['memory'] = memory * 1024
+
+    print('{}:'.format(os.path.basename(path)))
+    print('  {:<32} {:>10} {:>10} {:>6} {:>7} {:>9}'.format(
+          'task', 'stack', 'kstack', 'cores', 'timers', 'chanends'))
+    total = {'stack': 0, 'kstack': 0, 'cores': 0, 'timers': 0, 'chanends': 0}
+    status = 0
+    for task in tasks:
+        needs = task_budget(symbols, task, arch)
+        if needs is None:
+            sys.stderr.write('{}: no resource symbols for {}\n'.format(path, task))
+            status = 1
+            continue
+        row = {'stack': needs['nstackwords'] * 4,
+               'kstack': needs['kstackwords'] * 4,
+               'cores': needs['maxcores'],
+               'timers': needs['maxtimers'],
+               'chanends': needs['maxchanends']}
+        for key in total:
+            total[key] += row[key]
+        print('  {:<32} {:>10} {:>10} {:>6} {:>7} {:>9}'.format(
+              task, row['stack'], row['kstack'], row['cores'], row['timers'],
+              row['chanends']))
+
+    free = limits['memory'] - image_bytes
+    print('  {:<32} {:>10} {:>10} {:>6} {:>7} {:>9}'.format(
+          'total', total['stack'], total['kstack'], total['cores'],
+          total['timers'], total['chanends']))
+    print('  {:<32} {:>10} {:>10} {:>6} {:>7} {:>9}'.format(
+          'tile limit', free, '', limits['cores'], limits['timers'],
+          limits['chanends']))
+    print('  (stack in bytes; the image takes {} of the tile\'s {} bytes)'.format(
+          image_bytes, limits['memory']))
+
+    for name, used, limit in (('stack', total['stack'], free),
+                              ('cores', total['cores'], limits['cores']),
+                              ('timers', total['timers'], limits['timers']),
+                              ('chanends', total['chanends'], limits['chanends'])):
+        if used > limit:
+            print('  OVER BUDGET: {} needs {} of {}'.format(name, used, limit))
+            status = 1
+    return status
+
+
+def split_xe(path, directory):
+    """Split an .xe file into the ELF images of its tiles."""
+    subprocess.check_call(['xobjdump', '--split', os.path.abspath(path)],
+                          cwd=directory, stdout=subprocess.PIPE)
+    return sorted(glob.glob(os.path.join(directory, '*.elf')))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('image', help='.xe file, or ELF image of a tile')
+    parser.add_argument('-t', '--task', action='append', default=[],
+                        metavar='FUNCTION', help='a task function (default main)')
+    parser.add_argument('-a', '--arch', choices=sorted(TILE_LIMITS), default='XS2',
+                        help='the architecture of the tiles (default XS2)')
+    parser.add_argument('-m', '--memory', type=int, metavar='KB',
+                        help='the memory of each tile, if not the default')
+    args = parser.parse_args()
+    tasks = args.task or ['main']
+
+    if not args.image.endswith('.xe'):
+        sys.exit(report(args.image, tasks, args.arch, args.memory))
+
+    directory = tempfile.mkdtemp()
+    try:
+        status = 0
+        for elf in split_xe(args.image, directory):
+            symbols, _ = read_elf(elf)
+            # Report each tile's share of the tasks.
+            present = [task for task in tasks
+                       if '{}.nstackwords'.format(task) in symbols]
+            if present:
+                status |= report(elf, present, args.arch, args.memory)
+        sys.exit(status)
+    finally:
+        shutil.rmtree(directory)
+
+
+def main_or_error():
+    """Run main(), reporting an unreadable image without a traceback."""
+    try:
+        main()
+    except (ImageError, IOError, OSError, subprocess.CalledProcessError) as e:
+        sys.exit('{}: {}'.format(os.path.basename(sys.argv[0]), e))
+
+
+if __name__ == '__main__':
+    main_or_error()
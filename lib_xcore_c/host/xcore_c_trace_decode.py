@@ -0,0 +1,113 @@
+#!/usr/bin/env python
+# Copyright (c) 2016, XMOS Ltd, All rights reserved
+"""Decode lib_xcore_c trace buffers.
+
+The input is a binary image of one or more trace_buffer_t structures, as
+dumped from the target, e.g. using xgdb:
+
+  (gdb) dump binary memory trace.bin &buf ((char*)&buf)+sizeof(buf)
+
+Images of several buffers (one per logical core) may be concatenated into a
+single file. The records from all the buffers are merged and printed in time
+order.
+"""
+import argparse
+import heapq
+import os
+import re
+import struct
+import sys
+
+TRACE_MAGIC = 0x52544358
+HEADER = struct.Struct('<4I')
+ENTRY = struct.Struct('<3I')
+TICKS_PER_US = 100.0
+
+IMPL_HEADER = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                           '..', 'src', 'xcore_c_trace_impl.h')
+
+
+def read_event_names(path):
+    """Read the trace_event_t enumerators from the library header."""
+    with open(path) as f:
+        text = f.read()
+    body = re.search(r'typedef enum \{(.*?)\} trace_event_t;', text, re.S).group(1)
+    names = {}
+    value = -1
+    for item in body.split(','):
+        item = item.strip()
+        if not item:
+            continue
+        m = re.match(r'(\w+)(?:\s*=\s*(\w+))?$', item)
+        value = int(m.group(2), 0) if m.group(2) else value + 1
+        names[value] = m.group(1)
+    return names
+
+
+def read_buffers(data):
+    """Yield (core_id, lost, [(time, event, arg), ...]) for each buffer image."""
+    offset = 0
+    while offset + HEADER.size <= len(data):
+        magic, core_id, size, count = HEADER.unpack_from(data, offset)
+        if magic != TRACE_MAGIC:
+            raise ValueError('no trace buffer at offset {}'.format(offset))
+        offset += HEADER.size
+        entries = [ENTRY.unpack_from(data, offset + i * ENTRY.size)
+                   for i in range(size)]
+        offset += size * ENTRY.size
+        held = min(count, size)
+        first = count - held
+        records = [entries[(first + i) % size] for i in range(held)]
+        yield core_id, count - held, records
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('dump', help='binary image of the trace buffer(s)')
+    parser.add_argument('-u', '--user-event', action='append', default=[],
+                        metavar='ID=NAME', help='name an application event id')
+    args = parser.parse_args()
+
+    names = read_event_names(IMPL_HEADER)
+    for user in args.user_event:
+        event_id, name = user.split('=', 1)
+        names[int(event_id, 0)] = name
+
+    with open(args.dump, 'rb') as f:
+        data = f.read()
+
+    cores = []
+    for core_id, lost, entries in read_buffers(data):
+        if lost:
+            sys.stderr.write('core {}: {} older records lost\n'.format(core_id, lost))
+        if entries:
+            cores.append((core_id, entries))
+    if not cores:
+        return
+
+    # The reference clock wraps every ~43s. Each core's records are in order,
+    # so unwrap them from the core's first record, and place the cores' first
+    # records relative to the earliest of them.
+    def signed(delta):
+        return ((delta + 0x80000000) & 0xffffffff) - 0x80000000
+
+    start = min((entries[0][0] for core_id, entries in cores),
+                key=lambda t: signed(t - cores[0][1][0][0]))
+    per_core = []
+    for core_id, entries in cores:
+        offset = signed(entries[0][0] - start)
+        unwrapped = []
+        for time, event, arg in entries:
+            offset += (time - (start + offset)) & 0xffffffff
+            unwrapped.append((offset, time, core_id, event, arg))
+        per_core.append(unwrapped)
+    last = 0
+    for offset, time, core_id, event, arg in heapq.merge(*per_core):
+        name = names.get(event, 'event_0x{:x}'.format(event))
+        print('{:12.2f}us {:+10d} core {} {:<26} 0x{:08x}'.format(
+              offset / TICKS_PER_US, offset - last, core_id, name, arg))
+        last = offset
+
+if __name__ == '__main__':
+    main()
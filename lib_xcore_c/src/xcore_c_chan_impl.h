@@ -58,52 +58,88 @@ inline void _s_chanend_free(streaming_chanend_t c)
 
 inline void _s_chanend_set_dest(streaming_chanend_t c, streaming_chanend_t dst)
 {
+#if XCORE_C_HOST
+  _host_setd(c, dst);
+#else
   asm("setd res[%0], %1" :: "r" (c), "r" (dst));
+#endif
 }
 #endif // !defined(__XC__)
 
 inline void _s_chan_out_word(streaming_chanend_t c, uint32_t data)
 {
+#if XCORE_C_HOST
+  _host_out(c, data);
+#else
   asm volatile("out res[%0], %1" :: "r" (c), "r" (data));
+#endif
 }
 
 inline void _s_chan_out_byte(streaming_chanend_t c, uint8_t data)
 {
+#if XCORE_C_HOST
+  _host_outt(c, data);
+#else
   asm volatile("outt res[%0], %1" :: "r" (c), "r" (data));
+#endif
 }
 
 inline uint32_t _s_chan_in_word(streaming_chanend_t c)
 {
   uint32_t data;
+#if XCORE_C_HOST
+  data = _host_in(c);
+#else
   asm volatile("in %0, res[%1]" : "=r" (data): "r" (c));
+#endif
   return data;
 }
 
 inline uint8_t _s_chan_in_byte(streaming_chanend_t c)
 {
   uint8_t data;
+#if XCORE_C_HOST
+  data = _host_int(c);
+#else
   asm volatile("int %0, res[%1]" : "=r" (data): "r" (c));
+#endif
   return data;
 }
 
 inline void _s_chan_out_ct(streaming_chanend_t c, uint8_t ct)
 {
+#if XCORE_C_HOST
+  _host_outct(c, ct);
+#else
   asm volatile("outct res[%0], %1" :: "r" (c), "r" (ct));
+#endif
 }
 
 inline void _s_chan_out_ct_end(streaming_chanend_t c)
 {
+#if XCORE_C_HOST
+  _host_outct(c, XS1_CT_END);
+#else
   asm volatile("outct res[%0], " _XCORE_C_STR(XS1_CT_END) :: "r" (c));
+#endif
 }
 
 inline void _s_chan_check_ct(streaming_chanend_t c, uint8_t ct)
 {
+#if XCORE_C_HOST
+  _host_chkct(c, ct);
+#else
   asm volatile("chkct res[%0], %1" :: "r" (c), "r" (ct));
+#endif
 }
 
 inline void _s_chan_check_ct_end(streaming_chanend_t c)
 {
+#if XCORE_C_HOST
+  _host_chkct(c, XS1_CT_END);
+#else
   asm volatile("chkct res[%0], " _XCORE_C_STR(XS1_CT_END) :: "r" (c));
+#endif
 }
 
 #if !defined(__XC__) || defined(__DOXYGEN__)
@@ -1,6 +1,9 @@
 // Copyright (c) 2016, XMOS Ltd, All rights reserved
 
 #include "xcore_c_clock_impl.h"
+extern void _clock_start(clock clk);
+extern void _clock_stop(clock clk);
+extern void _clock_set_source_port(clock clk, port p);
 extern void _clock_set_ready_src(clock clk, port ready_source);
 
 #include "xcore_c_clock.h"
@@ -20,10 +20,35 @@
  */
 typedef unsigned clock;
 #endif
+#include <xs1.h>
+#include "xcore_c_resource_impl.h"
+
+inline void _clock_start(clock clk)
+{
+  _RESOURCE_SETCI(clk, XS1_SETC_RUN_STARTR);
+}
+
+inline void _clock_stop(clock clk)
+{
+  _RESOURCE_SETCI(clk, XS1_SETC_RUN_STOPR);
+}
+
+inline void _clock_set_source_port(clock clk, port p)
+{
+#if XCORE_C_HOST
+  _host_setclk(clk, p);
+#else
+  asm volatile("setclk res[%0], %1" :: "r" (clk), "r" (p));
+#endif
+}
 
 inline void _clock_set_ready_src(clock clk, port ready_source)
 {
+#if XCORE_C_HOST
+  _host_setrdy(clk, ready_source);
+#else
   asm volatile("setrdy res[%0], %1" :: "r" (clk), "r" (ready_source));
+#endif
 }
 
 #endif // !defined(__XC__)
@@ -0,0 +1,156 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+
+#ifndef __xcore_c_cpp_impl_h__
+#define __xcore_c_cpp_impl_h__
+
+// This file contains private implementation details and is not part of the API.
+// The contents may vary between releases.
+
+#if defined(__cplusplus) && (!defined(__XC__) || defined(__DOXYGEN__))
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+// The width of a port, from its identifier.
+#define _XCORE_C_PORT_ID_WIDTH(id) (((uint32_t)(id) >> 16) & 0xff)
+
+// The library's C API must have been included, within extern "C".
+namespace xcore_c {
+
+// The ways of transferring a T over a chan-end, chosen from its size and
+// alignment.
+enum _transfer_path {
+  _TRANSFER_BYTE,   // A single byte
+  _TRANSFER_WORD,   // A single word, copied in and out of a register
+  _TRANSFER_WORDS,  // A word aligned block of words
+  _TRANSFER_BYTES,  // Anything else, as a block of bytes
+};
+
+template <typename T>
+struct _transfer {
+  static const _transfer_path path =
+    sizeof(T) == 1 ? _TRANSFER_BYTE :
+    sizeof(T) == 4 ? _TRANSFER_WORD :
+    (sizeof(T) % 4 == 0 && alignof(T) % 4 == 0) ? _TRANSFER_WORDS :
+    _TRANSFER_BYTES;
+};
+
+// The functions used by a channel of each kind, so that the transfer paths
+// below are shared by both.
+struct _chan_ops {
+  typedef chanend end_t;
+  static xcore_c_error_t out_word(end_t c, uint32_t d) { return chan_out_word(c, d); }
+  static xcore_c_error_t out_byte(end_t c, uint8_t d) { return chan_out_byte(c, d); }
+  static xcore_c_error_t out_buf_word(end_t c, const uint32_t *b, size_t n) { return chan_out_buf_word(c, b, n); }
+  static xcore_c_error_t out_buf_byte(end_t c, const uint8_t *b, size_t n) { return chan_out_buf_byte(c, b, n); }
+  static xcore_c_error_t in_word(end_t c, uint32_t *d) { return chan_in_word(c, d); }
+  static xcore_c_error_t in_byte(end_t c, uint8_t *d) { return chan_in_byte(c, d); }
+  static xcore_c_error_t in_buf_word(end_t c, uint32_t *b, size_t n) { return chan_in_buf_word(c, b, n); }
+  static xcore_c_error_t in_buf_byte(end_t c, uint8_t *b, size_t n) { return chan_in_buf_byte(c, b, n); }
+};
+
+struct _s_chan_ops {
+  typedef streaming_chanend_t end_t;
+  static xcore_c_error_t out_word(end_t c, uint32_t d) { return s_chan_out_word(c, d); }
+  static xcore_c_error_t out_byte(end_t c, uint8_t d) { return s_chan_out_byte(c, d); }
+  static xcore_c_error_t out_buf_word(end_t c, const uint32_t *b, size_t n) { return s_chan_out_buf_word(c, b, n); }
+  static xcore_c_error_t out_buf_byte(end_t c, const uint8_t *b, size_t n) { return s_chan_out_buf_byte(c, b, n); }
+  static xcore_c_error_t in_word(end_t c, uint32_t *d) { return s_chan_in_word(c, d); }
+  static xcore_c_error_t in_byte(end_t c, uint8_t *d) { return s_chan_in_byte(c, d); }
+  static xcore_c_error_t in_buf_word(end_t c, uint32_t *b, size_t n) { return s_chan_in_buf_word(c, b, n); }
+  static xcore_c_error_t in_buf_byte(end_t c, uint8_t *b, size_t n) { return s_chan_in_buf_byte(c, b, n); }
+};
+
+template <typename Ops, typename T, _transfer_path Path = _transfer<T>::path>
+struct _chan_transfer;
+
+template <typename Ops, typename T>
+struct _chan_transfer<Ops, T, _TRANSFER_BYTE> {
+  static xcore_c_error_t out(typename Ops::end_t c, const T &v)
+  {
+    uint8_t d;
+    memcpy(&d, &v, 1);
+    return Ops::out_byte(c, d);
+  }
+  static xcore_c_error_t in(typename Ops::end_t c, T &v)
+  {
+    uint8_t d;
+    xcore_c_error_t error = Ops::in_byte(c, &d);
+    memcpy(&v, &d, 1);
+    return error;
+  }
+};
+
+template <typename Ops, typename T>
+struct _chan_transfer<Ops, T, _TRANSFER_WORD> {
+  static xcore_c_error_t out(typename Ops::end_t c, const T &v)
+  {
+    uint32_t d;
+    memcpy(&d, &v, 4);
+    return Ops::out_word(c, d);
+  }
+  static xcore_c_error_t in(typename Ops::end_t c, T &v)
+  {
+    uint32_t d;
+    xcore_c_error_t error = Ops::in_word(c, &d);
+    memcpy(&v, &d, 4);
+    return error;
+  }
+};
+
+template <typename Ops, typename T>
+struct _chan_transfer<Ops, T, _TRANSFER_WORDS> {
+  static xcore_c_error_t out(typename Ops::end_t c, const T &v)
+  {
+    return Ops::out_buf_word(c, reinterpret_cast<const uint32_t*>(&v), sizeof(T) / 4);
+  }
+  static xcore_c_error_t in(typename Ops::end_t c, T &v)
+  {
+    return Ops::in_buf_word(c, reinterpret_cast<uint32_t*>(&v), sizeof(T) / 4);
+  }
+};
+
+template <typename Ops, typename T>
+struct _chan_transfer<Ops, T, _TRANSFER_BYTES> {
+  static xcore_c_error_t out(typename Ops::end_t c, const T &v)
+  {
+    return Ops::out_buf_byte(c, reinterpret_cast<const uint8_t*>(&v), sizeof(T));
+  }
+  static xcore_c_error_t in(typename Ops::end_t c, T &v)
+  {
+    return Ops::in_buf_byte(c, reinterpret_cast<uint8_t*>(&v), sizeof(T));
+  }
+};
+
+// The smallest type holding the data of a port transfer.
+template <size_t Width>
+struct _port_data {
+  typedef uint32_t type;
+};
+
+template <>
+struct _port_data<1> {
+  typedef uint8_t type;
+};
+
+template <>
+struct _port_data<4> {
+  typedef uint8_t type;
+};
+
+template <>
+struct _port_data<8> {
+  typedef uint8_t type;
+};
+
+template <>
+struct _port_data<16> {
+  typedef uint16_t type;
+};
+
+} // namespace xcore_c
+
+#endif // defined(__cplusplus) && !defined(__XC__)
+
+#endif // __xcore_c_cpp_impl_h__
@@ -0,0 +1,27 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+
+#include "xcore_c_exception_impl.h"
+extern unsigned _error_core_id(void);
+extern void _error_scope_enter(void);
+extern void _error_scope_exit(void);
+extern void _exception_set_handler(xcore_c_error_t type, exception_handler_t handler, void *data);
+
+unsigned _xcore_c_error_scopes[_XCORE_C_ERROR_MAX_CORES];
+
+_xcore_c_exception_handler_t _xcore_c_exception_handlers[_XCORE_C_ERROR_MAX_CORES][_XCORE_C_EXCEPTION_TYPES];
+
+int _exception_dispatch(exception_t exception)
+{
+  if (exception.type >= _XCORE_C_EXCEPTION_TYPES) {
+    return 0;
+  }
+  _xcore_c_exception_handler_t *h = &_xcore_c_exception_handlers[_error_core_id()][exception.type];
+  if (!h->handler) {
+    return 0;
+  }
+  return h->handler(exception, h->data);
+}
+
+#include "xcore_c_exception.h"
+extern xcore_c_error_t exception_set_handler(xcore_c_error_t type, exception_handler_t handler, void *data);
+extern xcore_c_error_t exception_clear_handler(xcore_c_error_t type);
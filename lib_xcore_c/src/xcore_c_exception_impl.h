@@ -10,6 +10,7 @@
 
 #include "trycatch.h"
 #include "xcore_c_error_codes.h"
+#include "xcore_c_host_impl.h"
 
 #ifndef XCORE_C_NO_EXCEPTION
 /** The exception policy for the library.
@@ -30,14 +31,72 @@
 #define XCORE_C_NO_EXCEPTION 0
 #endif
 
+// The number of logical cores on a tile.
+#define _XCORE_C_ERROR_MAX_CORES 8
+
+// The depth of ERROR_SCOPE()s entered on each logical core.
+extern unsigned _xcore_c_error_scopes[_XCORE_C_ERROR_MAX_CORES];
+
+inline unsigned _error_core_id(void)
+{
+#if XCORE_C_HOST
+  return _host_get_id();
+#else
+  unsigned id;
+  asm volatile("get r11, id\n"
+               "\tadd %0, r11, 0"
+               : "=r" (id) : : /* clobbers */ "r11");
+  return id;
+#endif
+}
+
+inline void _error_scope_enter(void)
+{
+  _xcore_c_error_scopes[_error_core_id()]++;
+}
+
+inline void _error_scope_exit(void)
+{
+  _xcore_c_error_scopes[_error_core_id()]--;
+}
+
+// The exception types which may have a handler, indexed by type.
+#define _XCORE_C_EXCEPTION_TYPES (error_resource_dep + 1)
+
+/** The type of an exception handler.
+ *
+ *  It is passed the exception caught and the user data registered with it, and
+ *  returns non-zero to resume at the recovery point.
+ */
+typedef int (*exception_handler_t)(exception_t exception, void *data);
+
+typedef struct {
+  exception_handler_t handler;
+  void *data;
+} _xcore_c_exception_handler_t;
+
+// The exception handlers registered by each logical core.
+extern _xcore_c_exception_handler_t _xcore_c_exception_handlers[_XCORE_C_ERROR_MAX_CORES][_XCORE_C_EXCEPTION_TYPES];
+
+inline void _exception_set_handler(xcore_c_error_t type, exception_handler_t handler, void *data)
+{
+  _xcore_c_exception_handler_t *h = &_xcore_c_exception_handlers[_error_core_id()][type];
+  h->handler = handler;
+  h->data = data;
+}
+
+// Returns non-zero if the handler for the exception chose to resume.
+extern int _exception_dispatch(exception_t exception);  // Implemented in xcore_c_exception.c
+
+// Exceptions are left to the enclosing ERROR_SCOPE(), if there is one.
 #define RETURN_EXCEPTION_OR_ERROR(expr) \
-  if (XCORE_C_NO_EXCEPTION) { \
+  if (XCORE_C_NO_EXCEPTION && !_xcore_c_error_scopes[_error_core_id()]) { \
     exception_t e; \
     TRY { \
       expr ; \
     } \
     CATCH(e) { \
-      return e.type; \
+      return (xcore_c_error_t)e.type; \
     } \
   } \
   else { \
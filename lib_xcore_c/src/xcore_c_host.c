@@ -0,0 +1,2129 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+
+// The host backend, selected by building the library with XCORE_C_HOST.
+//
+// Each logical core is a pthread and each xCORE instruction used by the library
+// is a function operating on an emulated resource. All resource state is guarded
+// by one mutex. A core which cannot proceed waits on a condition variable, and is
+// woken to re-evaluate whenever another core changes the state.
+//
+// Time is virtual, measured in nanoseconds. It only advances when every logical
+// core is waiting, to the earliest time one of them is waiting for, so the code
+// between instructions takes no time and timing is independent of the host's
+// speed. Reference clock ticks (hwtimers, port timestamps) and port clock edges
+// are derived from it, and port data is modelled as pin changes at the clock
+// edge they occur on.
+//
+// With XCORE_C_HOST_SIM the logical cores are instead fibers, all run by the
+// thread which called host_par(), so only one runs at a time. After each
+// instruction a pseudo-random number generator picks the core to run next,
+// and how long each channel token takes to arrive, so an interleaving is
+// exactly reproduced by running with the same seed.
+
+#include "xcore_c_host_impl.h"
+
+#if XCORE_C_HOST
+
+// The xCORE resource types from xccompat.h are not used here, as 'clock'
+// conflicts with the C library's clock(). They are all uint32_t.
+
+#include <ctype.h>
+#include <pthread.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#if XCORE_C_HOST_SIM
+#include <ucontext.h>
+#endif
+#include <xs1.h>
+#include "trycatch.h"
+#include "xcore_c_exception_impl.h"
+#include "xcore_c_resource_impl.h"
+
+#define _HOST_MAX_CORES 8
+#define _HOST_CHANENDS 32
+#define _HOST_TIMERS 10
+#define _HOST_LOCKS 4
+#define _HOST_CLKBLKS 6
+#define _HOST_PIN_LOG 256
+
+// The tokens which may be output to a chanend before the sender blocks. This
+// includes those buffered in the switch as well as by the chanend itself.
+#define _HOST_CHAN_TOKENS 16
+
+// The stack of each logical core run as a fiber.
+#define _HOST_SIM_STACK (256 * 1024)
+
+// The most core clock cycles a channel token takes to arrive when simulating.
+#define _HOST_SIM_CHAN_LATENCY 8
+
+// The 100MHz reference clock and 500MHz core clock.
+#define _HOST_REF_PERIOD_NS 10
+#define _HOST_XCORE_PERIOD_NS 2
+
+#define _HOST_RES_TYPE(r) ((r) & XS1_RES_ID_TYPE_MASK)
+#define _HOST_RES_NUM(r) (((r) >> XS1_RES_ID_RESNUM_SHIFT) & XS1_RES_ID_RESNUM_MASK)
+#define _HOST_PORT_WIDTH(r) (((r) >> XS1_RES_ID_PORTWIDTH_SHIFT) & XS1_RES_ID_PORTWIDTH_MASK)
+#define _HOST_MASK(width) ((width) >= 32 ? 0xffffffff : ((uint32_t)1 << (width)) - 1)
+
+typedef struct host_pin_change_t {
+  int64_t t;
+  uint32_t value;
+} host_pin_change_t;
+
+// Every kind of resource uses the same record, with the fields it needs.
+typedef struct host_res_t {
+  uint32_t id;
+  int inuse;
+
+  // Events and interrupts.
+  int owner;                  // The core which enabled the event.
+  int enabled;
+  uint32_t seq;               // Enabling order, lowest first when selecting.
+  int interrupt;
+  void (*vector)(void);
+  void *ev;
+
+  // Timer and port conditions.
+  uint32_t cond;
+  uint32_t data;
+  int64_t cond_set_at;
+
+  // Chanends.
+  uint32_t dest;
+  uint8_t tokens[_HOST_CHAN_TOKENS];
+  uint8_t is_ct[_HOST_CHAN_TOKENS];
+  int64_t at[_HOST_CHAN_TOKENS];  // When each token arrives.
+  unsigned head;
+  unsigned count;
+
+  // Locks.
+  int held;
+
+  // Clock blocks.
+  uint32_t source;
+  uint32_t divide;
+  int running;
+  int64_t start;
+
+  // Ports.
+  uint32_t clk;
+  uint32_t width;
+  uint32_t transfer_width;
+  int buffered;
+  int inverted;
+  int has_time;
+  uint16_t time;
+  int64_t time_set_at;
+  int driving;
+  host_pin_change_t log[_HOST_PIN_LOG];
+  unsigned log_head;
+  unsigned log_count;
+  uint32_t log_base;          // The value before the oldest change logged.
+  int64_t out_next;           // The earliest edge the next output may use.
+  int64_t out_word_start;     // When the last word output starts being driven.
+  uint32_t pending[2];        // Words output while the port's clock is stopped.
+  unsigned pending_count;
+  int64_t in_next;            // The next edge sampled by a buffered input, or -1.
+  unsigned endin_slices;
+  uint16_t ts;
+  uint32_t wired;             // The port driving this port's pins, or 0.
+  host_pin_change_t *stimulus;  // Drives this port's pins instead, if not NULL.
+  size_t stimulus_count;
+  host_pin_change_t *trace;   // The changes output on the pins, if not NULL.
+  size_t trace_count;
+  size_t trace_size;
+  int64_t trace_start;
+  FILE *trace_file;
+} host_res_t;
+
+typedef struct host_thread_t {
+  int inuse;
+  int waiting;
+  int64_t deadline;           // When a waiting core is woken, if not negative.
+  uint32_t id;
+  uint32_t sr;
+  void *ed;
+  try_catch_t *try_top;
+  uint32_t timer;
+#if XCORE_C_HOST_SIM
+  ucontext_t ctx;
+  void *stack;
+  const host_core_t *task;
+  struct host_thread_t *parent;
+  unsigned joining;           // The cores started by host_par() still running.
+#endif
+} host_thread_t;
+
+static const uint32_t _host_port_ids[] = {
+  XS1_PORT_1A, XS1_PORT_1B, XS1_PORT_1C, XS1_PORT_1D,
+  XS1_PORT_1E, XS1_PORT_1F, XS1_PORT_1G, XS1_PORT_1H,
+  XS1_PORT_1I, XS1_PORT_1J, XS1_PORT_1K, XS1_PORT_1L,
+  XS1_PORT_1M, XS1_PORT_1N, XS1_PORT_1O, XS1_PORT_1P,
+  XS1_PORT_4A, XS1_PORT_4B, XS1_PORT_4C, XS1_PORT_4D, XS1_PORT_4E, XS1_PORT_4F,
+  XS1_PORT_8A, XS1_PORT_8B, XS1_PORT_8C, XS1_PORT_8D,
+  XS1_PORT_16A, XS1_PORT_16B, XS1_PORT_16C, XS1_PORT_16D,
+  XS1_PORT_32A, XS1_PORT_32B,
+};
+#define _HOST_PORTS (sizeof(_host_port_ids) / sizeof(_host_port_ids[0]))
+
+static host_res_t _host_chanends[_HOST_CHANENDS];
+static host_res_t _host_timers[_HOST_TIMERS];
+static host_res_t _host_locks[_HOST_LOCKS];
+static host_res_t _host_clkblks[_HOST_CLKBLKS];
+static host_res_t _host_ports[_HOST_PORTS];
+static host_thread_t _host_threads[_HOST_MAX_CORES];
+static uint32_t _host_next_seq;
+
+#if !XCORE_C_HOST_SIM
+static pthread_mutex_t _host_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t _host_changed = PTHREAD_COND_INITIALIZER;
+#endif
+static pthread_once_t _host_once = PTHREAD_ONCE_INIT;
+static int64_t _host_time;
+static unsigned _host_running;  // The logical cores which are not waiting.
+static __thread host_thread_t *_host_self;
+#if XCORE_C_HOST_SIM
+static uint32_t _host_seed;
+static uint32_t _host_random_state;
+#endif
+
+void _select_non_callback(void)
+{
+  // Only its address is used, to mark resources set up by _resource_setup_select().
+}
+
+//
+// Scheduling: the current time, and waiting for another core to change the state.
+//
+
+static void _host_vcd_exit(void);
+
+static void _host_init(void)
+{
+  _host_clkblks[0].id = XS1_CLKBLK_REF;
+  _host_clkblks[0].inuse = 1;
+  _host_clkblks[0].source = XS1_CLK_REF;
+  _host_clkblks[0].running = 1;
+  for (unsigned i = 1; i < _HOST_CLKBLKS; i++) {
+    _host_clkblks[i].id = (i << XS1_RES_ID_RESNUM_SHIFT) | XS1_RES_TYPE_CLKBLK;
+  }
+  for (unsigned i = 0; i < _HOST_PORTS; i++) {
+    _host_ports[i].id = _host_port_ids[i];
+    _host_ports[i].width = _HOST_PORT_WIDTH(_host_port_ids[i]);
+  }
+  atexit(_host_vcd_exit);
+}
+
+// The mutex guarding the state. Fibers only switch when they choose to,
+// so when simulating there is nothing to guard against.
+static void _host_lock(void)
+{
+#if !XCORE_C_HOST_SIM
+  pthread_mutex_lock(&_host_mutex);
+#endif
+}
+
+static void _host_unlock(void)
+{
+#if !XCORE_C_HOST_SIM
+  pthread_mutex_unlock(&_host_mutex);
+#endif
+}
+
+// Called with the mutex held. Wake the threads waiting on the state, to see
+// if they have been woken.
+static void _host_signal(void)
+{
+#if !XCORE_C_HOST_SIM
+  pthread_cond_broadcast(&_host_changed);
+#endif
+}
+
+static int64_t _host_now(void)
+{
+  return _host_time;
+}
+
+// Report an error which stops the application.
+__attribute__((noreturn)) static void _host_fail(const char *msg)
+{
+  fflush(stdout);
+#if XCORE_C_HOST_SIM
+  fprintf(stderr, "xcore_c host: %s (seed %u)\n", msg, _host_seed);
+#else
+  fprintf(stderr, "xcore_c host: %s\n", msg);
+#endif
+  exit(EXIT_FAILURE);
+}
+
+#if XCORE_C_HOST_SIM
+
+static uint32_t _host_random(void)
+{
+  _host_random_state = _host_random_state * 1664525 + 1013904223;
+  return _host_random_state >> 16;
+}
+
+// Pick one of the logical cores which are not waiting to run next, or NULL.
+static host_thread_t *_host_pick(void)
+{
+  host_thread_t *runnable[_HOST_MAX_CORES];
+  unsigned n = 0;
+  for (unsigned i = 0; i < _HOST_MAX_CORES; i++) {
+    host_thread_t *core = &_host_threads[i];
+    if (core->inuse && !core->waiting) {
+      runnable[n++] = core;
+    }
+  }
+  return n ? runnable[_host_random() % n] : NULL;
+}
+
+static void _host_switch(host_thread_t *to)
+{
+  host_thread_t *self = _host_self;
+  if (to != self) {
+    _host_self = to;
+    swapcontext(&self->ctx, &to->ctx);
+  }
+}
+
+// Let the scheduler choose whether another logical core runs first.
+static void _host_yield(void)
+{
+  _host_switch(_host_pick());
+}
+
+static int64_t _host_chan_latency(void)
+{
+  return (1 + _host_random() % _HOST_SIM_CHAN_LATENCY) * _HOST_XCORE_PERIOD_NS;
+}
+
+#else
+
+static int64_t _host_chan_latency(void)
+{
+  return 0;
+}
+
+#endif // XCORE_C_HOST_SIM
+
+static void _host_wake(host_thread_t *core)
+{
+  core->waiting = 0;
+  _host_running++;
+}
+
+// Called with the mutex held when no logical core is running.
+static void _host_advance(void)
+{
+  int64_t next = -1;
+  int waiting = 0;
+  for (unsigned i = 0; i < _HOST_MAX_CORES; i++) {
+    host_thread_t *core = &_host_threads[i];
+    if (core->inuse && core->waiting) {
+      waiting = 1;
+      if (core->deadline >= 0 && (next < 0 || core->deadline < next)) {
+        next = core->deadline;
+      }
+    }
+  }
+  if (!waiting) {
+    return;
+  }
+  if (next < 0) {
+    _host_fail("deadlock, every logical core is waiting");
+  }
+  if (next > _host_time) {
+    _host_time = next;
+  }
+  for (unsigned i = 0; i < _HOST_MAX_CORES; i++) {
+    host_thread_t *core = &_host_threads[i];
+    if (core->inuse && core->waiting && core->deadline >= 0 && core->deadline <= _host_time) {
+      _host_wake(core);
+    }
+  }
+  _host_signal();
+}
+
+// Called with the mutex held. Returns when the state may have changed,
+// or once 'deadline' has passed if it is not negative.
+static void _host_wait(int64_t deadline)
+{
+  host_thread_t *self = _host_self;
+  self->deadline = deadline;
+  self->waiting = 1;
+  if (--_host_running == 0) {
+    _host_advance();
+  }
+  while (self->waiting) {
+#if XCORE_C_HOST_SIM
+    // Some core is runnable, as otherwise _host_advance() woke one or failed.
+    _host_switch(_host_pick());
+#else
+    pthread_cond_wait(&_host_changed, &_host_mutex);
+#endif
+  }
+}
+
+// Called with the mutex held. Wake every waiting core to re-evaluate the state.
+static void _host_notify(void)
+{
+  int woken = 0;
+  for (unsigned i = 0; i < _HOST_MAX_CORES; i++) {
+    host_thread_t *core = &_host_threads[i];
+    if (core->inuse && core->waiting) {
+      _host_wake(core);
+      woken = 1;
+    }
+  }
+  if (woken) {
+    _host_signal();
+  }
+}
+
+// Called with the mutex held, as a logical core stops running other than by
+// waiting: while it runs other cores with host_par(), and when it finishes.
+static void _host_stop_running(void)
+{
+  if (--_host_running == 0) {
+    _host_advance();
+  }
+}
+
+//
+// Logical cores and exceptions.
+//
+
+// Called with the mutex held.
+static host_thread_t *_host_claim_core(void)
+{
+  for (unsigned i = 0; i < _HOST_MAX_CORES; i++) {
+    if (!_host_threads[i].inuse) {
+      memset(&_host_threads[i], 0, sizeof(_host_threads[i]));
+      _host_threads[i].inuse = 1;
+      _host_threads[i].id = i;
+      _host_running++;
+      return &_host_threads[i];
+    }
+  }
+  _host_fail("more than 8 logical cores");
+}
+
+static host_thread_t *_host_core(void)
+{
+  if (!_host_self) {
+    pthread_once(&_host_once, _host_init);
+    _host_lock();
+    _host_self = _host_claim_core();
+    _host_unlock();
+    // The xC runtime allocates each logical core a timer.
+    _host_self->timer = _host_getr(XS1_RES_TYPE_TIMER);
+  }
+  return _host_self;
+}
+
+void _host_try_enter(try_catch_t *tc)
+{
+  host_thread_t *core = _host_core();
+  tc->prev = core->try_top;
+  core->try_top = tc;
+}
+
+void _host_try_exit(try_catch_t *tc)
+{
+  _host_core()->try_top = tc->prev;
+}
+
+void _host_throw(unsigned type, unsigned data)
+{
+  host_thread_t *core = _host_core();
+  try_catch_t *tc = core->try_top;
+  if (!tc) {
+    char msg[64];
+    snprintf(msg, sizeof(msg), "unhandled exception: type %u data 0x%x on core %u",
+             type, data, (unsigned)core->id);
+    _host_fail(msg);
+  }
+  core->try_top = tc->prev;
+  tc->exception.type = type;
+  tc->exception.data = data;
+  longjmp(tc->buf, 1);
+}
+
+// Called with the mutex held, which is released.
+static void _host_raise(unsigned type, uint32_t r)
+{
+  _host_unlock();
+  _host_throw(type, r);
+}
+
+//
+// Resource lookup.
+//
+
+static host_res_t *_host_find(uint32_t r)
+{
+  unsigned num = _HOST_RES_NUM(r);
+  switch (_HOST_RES_TYPE(r)) {
+    case XS1_RES_TYPE_PORT:
+      for (unsigned i = 0; i < _HOST_PORTS; i++) {
+        if (_host_ports[i].id == r) {
+          return &_host_ports[i];
+        }
+      }
+      return NULL;
+    case XS1_RES_TYPE_TIMER:
+      return num < _HOST_TIMERS ? &_host_timers[num] : NULL;
+    case XS1_RES_TYPE_CHANEND:
+      return num < _HOST_CHANENDS ? &_host_chanends[num] : NULL;
+    case XS1_RES_TYPE_LOCK:
+      return num < _HOST_LOCKS ? &_host_locks[num] : NULL;
+    case XS1_RES_TYPE_CLKBLK:
+      return num < _HOST_CLKBLKS ? &_host_clkblks[num] : NULL;
+  }
+  return NULL;
+}
+
+// Lock the state and look up an in use resource of the given type.
+static host_res_t *_host_enter(uint32_t r, uint32_t type);
+
+// Lock the state and look up any resource of the given type, in use or not.
+static host_res_t *_host_enter_any(uint32_t r, uint32_t type)
+{
+  _host_core();
+  _host_lock();
+  host_res_t *res = _host_find(r);
+  if (!res || res->id != r || _HOST_RES_TYPE(r) != type) {
+    _host_raise(XS1_ET_ILLEGAL_RESOURCE, r);
+  }
+  return res;
+}
+
+static void _host_leave(void)
+{
+  _host_notify();
+#if XCORE_C_HOST_SIM
+  _host_yield();
+#endif
+  _host_unlock();
+}
+
+//
+// Clock blocks and port pins.
+//
+
+static host_res_t *_host_port_clock(const host_res_t *p)
+{
+  return _host_find(p->clk);
+}
+
+// Returns the clock's period in nanoseconds, or 0 if it is not ticking.
+static int64_t _host_clock_period(const host_res_t *c)
+{
+  if (!c || !c->running) {
+    return 0;
+  }
+  if (c->source == XS1_CLK_REF) {
+    return c->divide ? 2 * _HOST_REF_PERIOD_NS * c->divide : _HOST_REF_PERIOD_NS;
+  }
+  if (c->source == XS1_CLK_XCORE) {
+    return c->divide ? 2 * _HOST_XCORE_PERIOD_NS * c->divide : _HOST_XCORE_PERIOD_NS;
+  }
+  // Clock blocks sourced from a port are not modelled.
+  return 0;
+}
+
+// The first edge at or after time t.
+static int64_t _host_next_edge(const host_res_t *c, int64_t period, int64_t t)
+{
+  if (t <= c->start) {
+    return c->start;
+  }
+  return c->start + (t - c->start + period - 1) / period * period;
+}
+
+// The port counter, which counts the edges of the port's clock.
+static uint16_t _host_count(const host_res_t *c, int64_t period, int64_t t)
+{
+  return t <= c->start ? 0 : (uint16_t)((t - c->start) / period);
+}
+
+// The first edge at or after time t at which the port counter equals 'count'.
+static int64_t _host_time_of_count(const host_res_t *c, int64_t period, uint16_t count, int64_t t)
+{
+  int64_t k = (_host_next_edge(c, period, t) - c->start) / period;
+  k += (uint16_t)(count - (uint16_t)k);
+  return c->start + k * period;
+}
+
+// Record a change output on the pins of a port being traced.
+static void _host_trace_append(host_res_t *p, int64_t t, uint32_t value)
+{
+  // As in the pin log, later output replaces any scheduled from the same time on.
+  while (p->trace_count && p->trace[p->trace_count - 1].t >= t) {
+    p->trace_count--;
+  }
+  if (p->trace_count && p->trace[p->trace_count - 1].value == value) {
+    return;
+  }
+  if (p->trace_count == p->trace_size) {
+    p->trace_size *= 2;
+    p->trace = realloc(p->trace, p->trace_size * sizeof(p->trace[0]));
+    if (!p->trace) {
+      _host_fail("out of memory for port traces");
+    }
+  }
+  p->trace[p->trace_count].t = t;
+  p->trace[p->trace_count].value = value;
+  p->trace_count++;
+}
+
+static void _host_pin_append(host_res_t *p, int64_t t, uint32_t value)
+{
+  if (p->trace) {
+    _host_trace_append(p, t, value);
+  }
+  // Later output replaces any scheduled from the same time on.
+  while (p->log_count &&
+         p->log[(p->log_head + p->log_count - 1) % _HOST_PIN_LOG].t >= t) {
+    p->log_count--;
+  }
+  if (p->log_count == _HOST_PIN_LOG) {
+    p->log_base = p->log[p->log_head].value;
+    p->log_head = (p->log_head + 1) % _HOST_PIN_LOG;
+    p->log_count--;
+  }
+  host_pin_change_t *e = &p->log[(p->log_head + p->log_count) % _HOST_PIN_LOG];
+  e->t = t;
+  e->value = value;
+  p->log_count++;
+}
+
+static uint32_t _host_pin_driven(const host_res_t *p, int64_t t)
+{
+  for (unsigned i = p->log_count; i > 0; i--) {
+    const host_pin_change_t *e = &p->log[(p->log_head + i - 1) % _HOST_PIN_LOG];
+    if (e->t <= t) {
+      return e->value;
+    }
+  }
+  return p->log_base;
+}
+
+// The first change after time t, or -1 if none is scheduled.
+static int64_t _host_pin_next_change(const host_res_t *p, int64_t t)
+{
+  for (unsigned i = 0; i < p->log_count; i++) {
+    const host_pin_change_t *e = &p->log[(p->log_head + i) % _HOST_PIN_LOG];
+    if (e->t > t) {
+      return e->t;
+    }
+  }
+  return -1;
+}
+
+static const host_res_t *_host_pin_source(const host_res_t *p)
+{
+  const host_res_t *src = p->wired ? _host_find(p->wired) : NULL;
+  return src ? src : p;
+}
+
+// The index of the last stimulus change at or before time t, or -1 if none.
+static ptrdiff_t _host_stimulus_index(const host_res_t *p, int64_t t)
+{
+  ptrdiff_t lo = -1;
+  ptrdiff_t hi = p->stimulus_count;
+  while (hi - lo > 1) {
+    ptrdiff_t mid = lo + (hi - lo) / 2;
+    if (p->stimulus[mid].t <= t) {
+      lo = mid;
+    }
+    else {
+      hi = mid;
+    }
+  }
+  return lo;
+}
+
+// The value on the pins of a port at time t, before any inversion.
+static uint32_t _host_pins(const host_res_t *p, int64_t t)
+{
+  if (p->stimulus) {
+    ptrdiff_t i = _host_stimulus_index(p, t);
+    return i < 0 ? 0 : p->stimulus[i].value;
+  }
+  return _host_pin_driven(_host_pin_source(p), t);
+}
+
+// The first change of the value on the pins of a port after time t, or -1 if
+// none is scheduled.
+static int64_t _host_pins_next_change(const host_res_t *p, int64_t t)
+{
+  if (p->stimulus) {
+    size_t i = _host_stimulus_index(p, t) + 1;
+    return i < p->stimulus_count ? p->stimulus[i].t : -1;
+  }
+  return _host_pin_next_change(_host_pin_source(p), t);
+}
+
+// The data input from the pins at time t.
+static uint32_t _host_pin_in(const host_res_t *p, int64_t t)
+{
+  uint32_t mask = _HOST_MASK(p->width);
+  uint32_t v = _host_pins(p, t) & mask;
+  return p->inverted ? v ^ mask : v;
+}
+
+static unsigned _host_port_slices(const host_res_t *p)
+{
+  return p->buffered ? p->transfer_width / p->width : 1;
+}
+
+static void _host_port_schedule(host_res_t *p, const host_res_t *c, int64_t period,
+                                int64_t now, uint32_t data)
+{
+  unsigned slices = _host_port_slices(p);
+  uint32_t mask = _HOST_MASK(p->width);
+  int64_t t = _host_next_edge(c, period, now);
+  if (t < p->out_next) {
+    t = p->out_next;
+  }
+  if (p->has_time) {
+    t = _host_time_of_count(c, period, p->time, t);
+    p->has_time = 0;
+  }
+  for (unsigned i = 0; i < slices; i++) {
+    uint32_t v = (data >> (i * p->width)) & mask;
+    _host_pin_append(p, t + i * period, p->inverted ? v ^ mask : v);
+  }
+  p->out_word_start = t;
+  p->out_next = t + slices * period;
+  p->ts = _host_count(c, period, t);
+}
+
+static int _host_port_cond_met(const host_res_t *p, uint32_t v)
+{
+  uint32_t d = p->data & _HOST_MASK(p->width);
+  return p->cond == XS1_SETC_COND_EQ ? v == d : v != d;
+}
+
+// The edge at which a conditional or timed input is satisfied, or -1 if it is
+// not yet known.
+static int64_t _host_port_trigger(const host_res_t *p, const host_res_t *c, int64_t period)
+{
+  int64_t t;
+  if (p->has_time) {
+    t = _host_time_of_count(c, period, p->time, p->time_set_at);
+  }
+  else {
+    t = _host_next_edge(c, period, p->cond_set_at);
+  }
+  if (p->cond != XS1_SETC_COND_EQ && p->cond != XS1_SETC_COND_NEQ) {
+    return t;
+  }
+  if (p->has_time && p->cond_set_at > t) {
+    t = _host_next_edge(c, period, p->cond_set_at);
+  }
+  for (;;) {
+    if (_host_port_cond_met(p, _host_pin_in(p, t))) {
+      return t;
+    }
+    int64_t change = _host_pins_next_change(p, t);
+    if (change < 0) {
+      return -1;
+    }
+    t = _host_next_edge(c, period, change);
+  }
+}
+
+static int _host_port_conditional(const host_res_t *p)
+{
+  return p->has_time || p->cond == XS1_SETC_COND_EQ || p->cond == XS1_SETC_COND_NEQ;
+}
+
+// Start sampling a buffered input port, if it has not already started.
+static void _host_port_start_input(host_res_t *p, int64_t now)
+{
+  if (p->driving) {
+    p->driving = 0;
+    p->in_next = -1;
+  }
+  const host_res_t *c = _host_port_clock(p);
+  int64_t period = _host_clock_period(c);
+  if (p->in_next < 0 && period && !_host_port_conditional(p)) {
+    p->in_next = _host_next_edge(c, period, now);
+  }
+}
+
+// When the next input completes, or -1 if it is not yet known.
+static int64_t _host_port_in_time(const host_res_t *p, int64_t now)
+{
+  if (p->endin_slices) {
+    return now;
+  }
+  const host_res_t *c = _host_port_clock(p);
+  int64_t period = _host_clock_period(c);
+  if (!_host_port_conditional(p)) {
+    if (!p->buffered) {
+      return now;
+    }
+    if (!period || p->in_next < 0) {
+      return -1;
+    }
+    return p->in_next + (_host_port_slices(p) - 1) * period;
+  }
+  if (!period) {
+    return -1;
+  }
+  int64_t t = _host_port_trigger(p, c, period);
+  if (t >= 0 && p->buffered) {
+    t += (_host_port_slices(p) - 1) * period;
+  }
+  return t;
+}
+
+// Complete an input which _host_port_in_time() reported ready.
+static uint32_t _host_port_take(host_res_t *p, int64_t now)
+{
+  const host_res_t *c = _host_port_clock(p);
+  int64_t period = _host_clock_period(c);
+  unsigned slices = _host_port_slices(p);
+  uint32_t data = 0;
+
+  if (p->endin_slices) {
+    // The partial word is aligned to the top of the transfer register.
+    unsigned shift = p->transfer_width - p->endin_slices * p->width;
+    for (unsigned i = 0; i < p->endin_slices; i++) {
+      data |= _host_pin_in(p, p->in_next + i * period) << (shift + i * p->width);
+    }
+    p->in_next += p->endin_slices * period;
+    p->endin_slices = 0;
+    p->ts = _host_count(c, period, p->in_next - period);
+    return data;
+  }
+
+  int64_t t;
+  if (_host_port_conditional(p)) {
+    t = _host_port_trigger(p, c, period);
+    p->has_time = 0;
+    p->cond = XS1_SETC_COND_NONE;
+  }
+  else if (!p->buffered) {
+    t = now;
+  }
+  else {
+    t = p->in_next;
+    // The words not input in time have been overwritten.
+    int64_t word = slices * period;
+    if (now - t >= 2 * word) {
+      t += ((now - t) / word - 1) * word;
+    }
+  }
+
+  for (unsigned i = 0; i < slices; i++) {
+    data |= _host_pin_in(p, t + i * period) << (i * p->width);
+  }
+  if (period) {
+    p->ts = _host_count(c, period, t);
+  }
+  if (p->buffered) {
+    p->in_next = t + slices * period;
+  }
+  return data;
+}
+
+static void _host_port_reset(host_res_t *p)
+{
+  host_res_t keep = *p;
+  memset(p, 0, sizeof(*p));
+  // The pins' wiring and stimulus, and tracing, are not part of the port.
+  p->id = keep.id;
+  p->wired = keep.wired;
+  p->stimulus = keep.stimulus;
+  p->stimulus_count = keep.stimulus_count;
+  p->trace = keep.trace;
+  p->trace_count = keep.trace_count;
+  p->trace_size = keep.trace_size;
+  p->trace_start = keep.trace_start;
+  p->trace_file = keep.trace_file;
+  if (p->trace) {
+    _host_trace_append(p, _host_now(), 0);
+  }
+  p->inuse = 1;
+  p->owner = -1;
+  p->cond = XS1_SETC_COND_NONE;
+  p->clk = XS1_CLKBLK_REF;
+  p->width = _HOST_PORT_WIDTH(p->id);
+  p->transfer_width = p->width;
+  p->in_next = -1;
+}
+
+//
+// Readiness of resources to be input from (or output to, for ports which are
+// driving their pins), for events and blocking instructions.
+//
+
+// The tokens which have arrived at a chanend by 'now'. If some have not,
+// lowers *deadline to when the next arrives.
+static unsigned _host_chan_arrived(const host_res_t *c, int64_t now, int64_t *deadline)
+{
+  unsigned n = 0;
+  while (n < c->count) {
+    int64_t t = c->at[(c->head + n) % _HOST_CHAN_TOKENS];
+    if (t > now) {
+      if (*deadline < 0 || t < *deadline) {
+        *deadline = t;
+      }
+      break;
+    }
+    n++;
+  }
+  return n;
+}
+
+static int64_t _host_ticks_deadline(uint32_t target, int64_t now)
+{
+  int32_t ticks = (int32_t)(target - (uint32_t)(now / _HOST_REF_PERIOD_NS));
+  return ticks <= 0 ? now : (now / _HOST_REF_PERIOD_NS + ticks) * _HOST_REF_PERIOD_NS;
+}
+
+// Returns whether the resource is ready now, otherwise lowers *deadline to when
+// it will become ready if that is known.
+static int _host_ready(const host_res_t *r, int64_t now, int64_t *deadline)
+{
+  int64_t t;
+  switch (_HOST_RES_TYPE(r->id)) {
+    case XS1_RES_TYPE_CHANEND:
+      return _host_chan_arrived(r, now, deadline) != 0;
+    case XS1_RES_TYPE_TIMER:
+      if (r->cond != XS1_SETC_COND_AFTER) {
+        return 1;
+      }
+      t = _host_ticks_deadline(r->data, now);
+      break;
+    case XS1_RES_TYPE_PORT:
+      if (r->driving) {
+        t = r->pending_count == 2 ? -1 : r->out_word_start;
+      }
+      else {
+        t = _host_port_in_time(r, now);
+      }
+      break;
+    default:
+      return 1;
+  }
+  if (t >= 0 && t <= now) {
+    return 1;
+  }
+  if (t >= 0 && (*deadline < 0 || t < *deadline)) {
+    *deadline = t;
+  }
+  return 0;
+}
+
+// The ready resource with the lowest enabling order which raises events or
+// interrupts on the current core.
+static host_res_t *_host_ready_event(int interrupt, int64_t now, int64_t *deadline)
+{
+  static host_res_t * const tables[] = {
+    _host_chanends, _host_timers, _host_ports,
+  };
+  static const unsigned sizes[] = {
+    _HOST_CHANENDS, _HOST_TIMERS, _HOST_PORTS,
+  };
+  int self = _host_self->id;
+  host_res_t *best = NULL;
+  for (unsigned i = 0; i < sizeof(tables) / sizeof(tables[0]); i++) {
+    for (unsigned j = 0; j < sizes[i]; j++) {
+      host_res_t *r = &tables[i][j];
+      if (r->inuse && r->enabled && r->owner == self && r->interrupt == interrupt &&
+          (!best || r->seq < best->seq) && _host_ready(r, now, deadline)) {
+        best = r;
+      }
+    }
+  }
+  return best;
+}
+
+// Called with the mutex held. Take any interrupts pending on this core.
+static void _host_poll_interrupts(void)
+{
+  host_thread_t *core = _host_self;
+  while (core->sr & XS1_SR_IEBLE_MASK) {
+    int64_t deadline = -1;
+    host_res_t *r = _host_ready_event(1, _host_now(), &deadline);
+    if (!r) {
+      return;
+    }
+    void (*vector)(void) = r->vector;
+    // As on the xCORE, the callback is outside any ERROR_SCOPE() interrupted.
+    unsigned scopes = _xcore_c_error_scopes[core->id];
+    _xcore_c_error_scopes[core->id] = 0;
+    core->ed = r->ev;
+    core->sr &= ~XS1_SR_IEBLE_MASK;
+    _host_unlock();
+    vector();
+    _host_lock();
+    _xcore_c_error_scopes[core->id] = scopes;
+    core->sr |= XS1_SR_IEBLE_MASK;
+  }
+}
+
+// Called with the mutex held. Wait as _host_wait(), waking to take interrupts.
+static void _host_block(int64_t deadline)
+{
+  if (_host_self->sr & XS1_SR_IEBLE_MASK) {
+    _host_ready_event(1, _host_now(), &deadline);
+  }
+  _host_wait(deadline);
+  _host_poll_interrupts();
+}
+
+static host_res_t *_host_enter(uint32_t r, uint32_t type)
+{
+  host_res_t *res = _host_enter_any(r, type);
+  if (!res->inuse) {
+    _host_raise(XS1_ET_ILLEGAL_RESOURCE, r);
+  }
+  _host_poll_interrupts();
+  return res;
+}
+
+static host_res_t *_host_enter_resource(uint32_t r)
+{
+  return _host_enter(r, _HOST_RES_TYPE(r));
+}
+
+//
+// Resource allocation and control.
+//
+
+uint32_t _host_getr(uint32_t type)
+{
+  host_res_t *table;
+  unsigned size;
+  switch (type) {
+    case XS1_RES_TYPE_TIMER: table = _host_timers; size = _HOST_TIMERS; break;
+    case XS1_RES_TYPE_CHANEND: table = _host_chanends; size = _HOST_CHANENDS; break;
+    case XS1_RES_TYPE_LOCK: table = _host_locks; size = _HOST_LOCKS; break;
+    default: return 0;
+  }
+  _host_core();
+  _host_lock();
+  for (unsigned i = 0; i < size; i++) {
+    host_res_t *r = &table[i];
+    if (!r->inuse) {
+      memset(r, 0, sizeof(*r));
+      r->id = (i << XS1_RES_ID_RESNUM_SHIFT) | type;
+      r->inuse = 1;
+      r->owner = -1;
+      r->cond = XS1_SETC_COND_NONE;
+      _host_unlock();
+      return r->id;
+    }
+  }
+  _host_unlock();
+  return 0;
+}
+
+void _host_freer(uint32_t r)
+{
+  host_res_t *res = _host_enter_resource(r);
+  if (res->count || res->held) {
+    _host_raise(XS1_ET_ILLEGAL_RESOURCE, r);
+  }
+  res->inuse = 0;
+  res->enabled = 0;
+  _host_leave();
+}
+
+static void _host_setc_clock(host_res_t *c, uint32_t ctrl)
+{
+  int64_t now = _host_now();
+  switch (ctrl) {
+    case XS1_SETC_INUSE_ON:
+      if (c->id != XS1_CLKBLK_REF) {
+        c->inuse = 1;
+        c->source = XS1_CLK_REF;
+        c->divide = 0;
+        c->running = 0;
+      }
+      return;
+    case XS1_SETC_INUSE_OFF:
+      if (c->id != XS1_CLKBLK_REF) {
+        c->inuse = 0;
+        c->running = 0;
+      }
+      return;
+    case XS1_SETC_RUN_STARTR:
+      c->running = 1;
+      c->start = now;
+      break;
+    case XS1_SETC_RUN_STOPR:
+      c->running = 0;
+      break;
+    default:
+      _host_raise(XS1_ET_ILLEGAL_RESOURCE, c->id);
+  }
+  // Restart the ports clocked by the clock block, outputting any words
+  // output while it was stopped.
+  int64_t period = _host_clock_period(c);
+  for (unsigned i = 0; i < _HOST_PORTS; i++) {
+    host_res_t *p = &_host_ports[i];
+    if (!p->inuse || p->clk != c->id) {
+      continue;
+    }
+    p->in_next = -1;
+    p->out_next = 0;
+    p->out_word_start = 0;
+    if (period) {
+      for (unsigned j = 0; j < p->pending_count; j++) {
+        _host_port_schedule(p, c, period, now, p->pending[j]);
+      }
+      p->pending_count = 0;
+    }
+  }
+}
+
+static void _host_setc_port(host_res_t *p, uint32_t ctrl)
+{
+  switch (ctrl) {
+    case XS1_SETC_INUSE_ON:
+      _host_port_reset(p);
+      return;
+    case XS1_SETC_INUSE_OFF:
+      p->inuse = 0;
+      p->enabled = 0;
+      return;
+    case XS1_SETC_BUF_BUFFERS:
+      p->buffered = 1;
+      break;
+    case XS1_SETC_BUF_NOBUFFERS:
+      p->buffered = 0;
+      p->transfer_width = p->width;
+      break;
+    case XS1_SETC_INV_INVERT:
+      p->inverted = 1;
+      break;
+    case XS1_SETC_INV_NOINVERT:
+      p->inverted = 0;
+      break;
+    case XS1_SETC_RUN_CLRBUF:
+      p->pending_count = 0;
+      p->endin_slices = 0;
+      p->in_next = -1;
+      break;
+    case XS1_SETC_MS_MASTER:
+    case XS1_SETC_MS_SLAVE:
+    case XS1_SETC_RDY_NOREADY:
+    case XS1_SETC_RDY_STROBED:
+    case XS1_SETC_RDY_HANDSHAKE:
+    case XS1_SETC_SDELAY_NOSDELAY:
+    case XS1_SETC_SDELAY_SDELAY:
+    case XS1_SETC_PORT_DATAPORT:
+    case XS1_SETC_PORT_CLOCKPORT:
+    case XS1_SETC_PORT_READYPORT:
+      // Accepted, but not modelled.
+      break;
+    default:
+      _host_raise(XS1_ET_ILLEGAL_RESOURCE, p->id);
+  }
+}
+
+void _host_setc(uint32_t r, uint32_t c)
+{
+  host_res_t *res = _host_enter_any(r, _HOST_RES_TYPE(r));
+  if (!res->inuse && c != XS1_SETC_INUSE_ON) {
+    _host_raise(XS1_ET_ILLEGAL_RESOURCE, r);
+  }
+  switch (c) {
+    case XS1_SETC_IE_MODE_EVENT:
+      res->interrupt = 0;
+      break;
+    case XS1_SETC_IE_MODE_INTERRUPT:
+      res->interrupt = 1;
+      break;
+    case XS1_SETC_COND_NONE:
+    case XS1_SETC_COND_AFTER:
+    case XS1_SETC_COND_EQ:
+    case XS1_SETC_COND_NEQ:
+      if (_HOST_RES_TYPE(r) == XS1_RES_TYPE_PORT) {
+        res->cond_set_at = _host_now();
+        res->in_next = -1;
+      }
+      else if (_HOST_RES_TYPE(r) != XS1_RES_TYPE_TIMER) {
+        _host_raise(XS1_ET_ILLEGAL_RESOURCE, r);
+      }
+      res->cond = c;
+      break;
+    default:
+      if (_HOST_RES_TYPE(r) == XS1_RES_TYPE_CLKBLK) {
+        _host_setc_clock(res, c);
+      }
+      else if (_HOST_RES_TYPE(r) == XS1_RES_TYPE_PORT) {
+        _host_setc_port(res, c);
+      }
+      else if (c == XS1_SETC_INUSE_OFF) {
+        res->inuse = 0;
+        res->enabled = 0;
+      }
+      else if (c != XS1_SETC_INUSE_ON) {
+        _host_raise(XS1_ET_ILLEGAL_RESOURCE, r);
+      }
+  }
+  _host_leave();
+}
+
+void _host_setd(uint32_t r, uint32_t d)
+{
+  host_res_t *res = _host_enter_resource(r);
+  switch (_HOST_RES_TYPE(r)) {
+    case XS1_RES_TYPE_CHANEND:
+      res->dest = d;
+      break;
+    case XS1_RES_TYPE_CLKBLK:
+      if (res->running) {
+        _host_raise(XS1_ET_ILLEGAL_RESOURCE, r);
+      }
+      res->divide = d;
+      break;
+    case XS1_RES_TYPE_TIMER:
+    case XS1_RES_TYPE_PORT:
+      res->data = d;
+      break;
+    default:
+      _host_raise(XS1_ET_ILLEGAL_RESOURCE, r);
+  }
+  _host_leave();
+}
+
+void _host_setclk(uint32_t r, uint32_t source)
+{
+  host_res_t *res = _host_enter_resource(r);
+  if (_HOST_RES_TYPE(r) == XS1_RES_TYPE_PORT) {
+    host_res_t *c = _host_find(source);
+    if (!c || c->id != source || !c->inuse) {
+      _host_raise(XS1_ET_ILLEGAL_RESOURCE, r);
+    }
+    res->clk = source;
+    res->in_next = -1;
+    res->out_next = 0;
+  }
+  else if (_HOST_RES_TYPE(r) == XS1_RES_TYPE_CLKBLK && r != XS1_CLKBLK_REF) {
+    if (res->running) {
+      _host_raise(XS1_ET_ILLEGAL_RESOURCE, r);
+    }
+    res->source = source;
+  }
+  else {
+    _host_raise(XS1_ET_ILLEGAL_RESOURCE, r);
+  }
+  _host_leave();
+}
+
+void _host_setrdy(uint32_t r, uint32_t ready_source)
+{
+  // Ready signals are not modelled.
+  (void)ready_source;
+  _host_enter_resource(r);
+  _host_leave();
+}
+
+void _host_settw(uint32_t r, uint32_t width)
+{
+  host_res_t *p = _host_enter(r, XS1_RES_TYPE_PORT);
+  if (!p->buffered || width < p->width || width > 32 || width % p->width) {
+    _host_raise(XS1_ET_ILLEGAL_RESOURCE, r);
+  }
+  p->transfer_width = width;
+  _host_leave();
+}
+
+void _host_setpt(uint32_t r, uint32_t t)
+{
+  host_res_t *p = _host_enter(r, XS1_RES_TYPE_PORT);
+  p->has_time = 1;
+  p->time = (uint16_t)t;
+  p->time_set_at = _host_now();
+  p->in_next = -1;
+  _host_leave();
+}
+
+void _host_clrpt(uint32_t r)
+{
+  host_res_t *p = _host_enter(r, XS1_RES_TYPE_PORT);
+  p->has_time = 0;
+  _host_leave();
+}
+
+uint32_t _host_getts(uint32_t r)
+{
+  host_res_t *p = _host_enter(r, XS1_RES_TYPE_PORT);
+  uint32_t ts = p->ts;
+  _host_leave();
+  return ts;
+}
+
+//
+// Output.
+//
+
+static void _host_chan_put(host_res_t *c, uint8_t token, int is_ct)
+{
+  for (;;) {
+    host_res_t *dst = _host_find(c->dest);
+    if (!c->dest || !dst || dst->id != c->dest || !dst->inuse) {
+      _host_raise(XS1_ET_ILLEGAL_RESOURCE, c->id);
+    }
+    if (dst->count < _HOST_CHAN_TOKENS) {
+      unsigned i = (dst->head + dst->count) % _HOST_CHAN_TOKENS;
+      int64_t at = _host_now() + _host_chan_latency();
+      if (dst->count) {
+        // Tokens arrive in the order they were output.
+        int64_t prev = dst->at[(i + _HOST_CHAN_TOKENS - 1) % _HOST_CHAN_TOKENS];
+        at = at < prev ? prev : at;
+      }
+      dst->tokens[i] = token;
+      dst->is_ct[i] = is_ct;
+      dst->at[i] = at;
+      dst->count++;
+      _host_notify();
+      return;
+    }
+    _host_block(-1);
+  }
+}
+
+static void _host_port_out(host_res_t *p, uint32_t data)
+{
+  if (!p->driving) {
+    p->driving = 1;
+    p->out_next = 0;
+    p->out_word_start = 0;
+  }
+  for (;;) {
+    const host_res_t *c = _host_port_clock(p);
+    int64_t period = _host_clock_period(c);
+    int64_t now = _host_now();
+    if (!period) {
+      if (p->pending_count < 2) {
+        p->pending[p->pending_count++] = data;
+        return;
+      }
+      _host_block(-1);
+    }
+    else if (p->out_word_start > now) {
+      // Wait for the previous word to move into the shift register.
+      _host_block(p->out_word_start);
+    }
+    else {
+      _host_port_schedule(p, c, period, now, data);
+      return;
+    }
+  }
+}
+
+void _host_out(uint32_t r, uint32_t data)
+{
+  host_res_t *res = _host_enter_resource(r);
+  switch (_HOST_RES_TYPE(r)) {
+    case XS1_RES_TYPE_CHANEND:
+      for (int i = 3; i >= 0; i--) {
+        _host_chan_put(res, (uint8_t)(data >> (8 * i)), 0);
+      }
+      break;
+    case XS1_RES_TYPE_PORT:
+      _host_port_out(res, data);
+      break;
+    case XS1_RES_TYPE_LOCK:
+      res->held = 0;
+      break;
+    default:
+      _host_raise(XS1_ET_ILLEGAL_RESOURCE, r);
+  }
+  _host_leave();
+}
+
+void _host_outt(uint32_t r, uint32_t data)
+{
+  host_res_t *c = _host_enter(r, XS1_RES_TYPE_CHANEND);
+  _host_chan_put(c, (uint8_t)data, 0);
+  _host_leave();
+}
+
+void _host_outct(uint32_t r, uint32_t ct)
+{
+  host_res_t *c = _host_enter(r, XS1_RES_TYPE_CHANEND);
+  _host_chan_put(c, (uint8_t)ct, 1);
+  _host_leave();
+}
+
+uint32_t _host_outshr(uint32_t r, uint32_t data)
+{
+  host_res_t *p = _host_enter(r, XS1_RES_TYPE_PORT);
+  unsigned shift = p->transfer_width;
+  _host_port_out(p, data);
+  _host_leave();
+  return shift >= 32 ? 0 : data >> shift;
+}
+
+//
+// Input.
+//
+
+// Wait for at least n tokens, none of which but the last may be a control token.
+static void _host_chan_wait(host_res_t *c, unsigned n)
+{
+  for (;;) {
+    int64_t deadline = -1;
+    unsigned arrived = _host_chan_arrived(c, _host_now(), &deadline);
+    if (arrived >= n) {
+      return;
+    }
+    for (unsigned i = 0; i < arrived; i++) {
+      if (c->is_ct[(c->head + i) % _HOST_CHAN_TOKENS]) {
+        _host_raise(XS1_ET_ILLEGAL_RESOURCE, c->id);
+      }
+    }
+    _host_block(deadline);
+  }
+}
+
+static uint8_t _host_chan_take(host_res_t *c, int is_ct)
+{
+  if (c->is_ct[c->head] != is_ct) {
+    _host_raise(XS1_ET_ILLEGAL_RESOURCE, c->id);
+  }
+  uint8_t token = c->tokens[c->head];
+  c->head = (c->head + 1) % _HOST_CHAN_TOKENS;
+  c->count--;
+  return token;
+}
+
+static uint32_t _host_port_in(host_res_t *p)
+{
+  for (;;) {
+    int64_t now = _host_now();
+    _host_port_start_input(p, now);
+    int64_t t = _host_port_in_time(p, now);
+    if (t >= 0 && t <= now) {
+      return _host_port_take(p, now);
+    }
+    _host_block(t);
+  }
+}
+
+uint32_t _host_in(uint32_t r)
+{
+  host_res_t *res = _host_enter_resource(r);
+  uint32_t data = 0;
+  switch (_HOST_RES_TYPE(r)) {
+    case XS1_RES_TYPE_CHANEND:
+      _host_chan_wait(res, 4);
+      for (int i = 0; i < 4; i++) {
+        data = (data << 8) | _host_chan_take(res, 0);
+      }
+      break;
+    case XS1_RES_TYPE_TIMER:
+      if (res->cond != XS1_SETC_COND_AFTER) {
+        // Let other cores run until the next tick, so that polling the time advances it.
+        _host_block((_host_now() / _HOST_REF_PERIOD_NS + 1) * _HOST_REF_PERIOD_NS);
+      }
+      for (;;) {
+        int64_t now = _host_now();
+        int64_t deadline = -1;
+        if (_host_ready(res, now, &deadline)) {
+          data = (uint32_t)(now / _HOST_REF_PERIOD_NS);
+          break;
+        }
+        _host_block(deadline);
+      }
+      break;
+    case XS1_RES_TYPE_PORT:
+      data = _host_port_in(res);
+      break;
+    case XS1_RES_TYPE_LOCK:
+      while (res->held) {
+        _host_block(-1);
+      }
+      res->held = 1;
+      data = r;
+      break;
+    default:
+      _host_raise(XS1_ET_ILLEGAL_RESOURCE, r);
+  }
+  _host_leave();
+  return data;
+}
+
+uint32_t _host_int(uint32_t r)
+{
+  host_res_t *c = _host_enter(r, XS1_RES_TYPE_CHANEND);
+  _host_chan_wait(c, 1);
+  uint32_t token = _host_chan_take(c, 0);
+  _host_leave();
+  return token;
+}
+
+void _host_chkct(uint32_t r, uint32_t ct)
+{
+  host_res_t *c = _host_enter(r, XS1_RES_TYPE_CHANEND);
+  _host_chan_wait(c, 1);
+  if (_host_chan_take(c, 1) != ct) {
+    _host_raise(XS1_ET_ILLEGAL_RESOURCE, r);
+  }
+  _host_leave();
+}
+
+uint32_t _host_inshr(uint32_t r, uint32_t data)
+{
+  host_res_t *p = _host_enter(r, XS1_RES_TYPE_PORT);
+  unsigned shift = p->transfer_width;
+  uint32_t in = _host_port_in(p);
+  _host_leave();
+  return shift >= 32 ? in : (data >> shift) | (in << (32 - shift));
+}
+
+uint32_t _host_peek(uint32_t r)
+{
+  host_res_t *p = _host_enter(r, XS1_RES_TYPE_PORT);
+  uint32_t data = _host_pin_in(p, _host_now());
+  _host_leave();
+  return data;
+}
+
+uint32_t _host_endin(uint32_t r)
+{
+  host_res_t *p = _host_enter(r, XS1_RES_TYPE_PORT);
+  int64_t now = _host_now();
+  _host_port_start_input(p, now);
+  const host_res_t *c = _host_port_clock(p);
+  int64_t period = _host_clock_period(c);
+  unsigned slices = 0;
+  if (p->buffered && period && p->in_next >= 0 && now >= p->in_next) {
+    slices = (now - p->in_next) / period + 1;
+    if (slices > _host_port_slices(p)) {
+      slices = _host_port_slices(p);
+    }
+  }
+  p->endin_slices = slices == _host_port_slices(p) ? 0 : slices;
+  _host_leave();
+  return slices * p->width;
+}
+
+//
+// Events and interrupts.
+//
+
+void _host_setv(uint32_t r, void (*vector)(void))
+{
+  host_res_t *res = _host_enter_resource(r);
+  res->vector = vector;
+  _host_leave();
+}
+
+void _host_setev(uint32_t r, void *ev)
+{
+  host_res_t *res = _host_enter_resource(r);
+  res->ev = ev;
+  _host_leave();
+}
+
+void _host_eeu(uint32_t r)
+{
+  host_res_t *res = _host_enter_resource(r);
+  if (!res->enabled || res->owner != (int)_host_self->id) {
+    res->enabled = 1;
+    res->owner = _host_self->id;
+    res->seq = _host_next_seq++;
+  }
+  if (_HOST_RES_TYPE(r) == XS1_RES_TYPE_PORT && !res->driving) {
+    _host_port_start_input(res, _host_now());
+  }
+  _host_leave();
+}
+
+void _host_edu(uint32_t r)
+{
+  host_res_t *res = _host_enter_resource(r);
+  res->enabled = 0;
+  _host_leave();
+}
+
+void _host_clre(void)
+{
+  static host_res_t * const tables[] = {
+    _host_chanends, _host_timers, _host_ports,
+  };
+  static const unsigned sizes[] = {
+    _HOST_CHANENDS, _HOST_TIMERS, _HOST_PORTS,
+  };
+  int self = _host_core()->id;
+  _host_lock();
+  for (unsigned i = 0; i < sizeof(tables) / sizeof(tables[0]); i++) {
+    for (unsigned j = 0; j < sizes[i]; j++) {
+      if (tables[i][j].owner == self) {
+        tables[i][j].enabled = 0;
+      }
+    }
+  }
+  _host_unlock();
+}
+
+void *_host_get_ed(void)
+{
+  return _host_core()->ed;
+}
+
+uint32_t _host_getsr(uint32_t mask)
+{
+  return _host_core()->sr & mask;
+}
+
+void _host_setsr(uint32_t mask)
+{
+  host_thread_t *core = _host_core();
+  _host_lock();
+  core->sr |= mask;
+  _host_poll_interrupts();
+  _host_unlock();
+}
+
+void _host_clrsr(uint32_t mask)
+{
+  _host_core()->sr &= ~mask;
+}
+
+uint32_t _host_get_id(void)
+{
+  return _host_core()->id;
+}
+
+// Wait for an event, taking select callbacks until an event set up by
+// _resource_setup_select() is ready. If 'wait' is 0 and no event is ready
+// 'no_wait_id' is returned instead.
+static uint32_t _host_select(int wait, uint32_t no_wait_id)
+{
+  host_thread_t *core = _host_core();
+  _host_lock();
+  _host_poll_interrupts();
+  for (;;) {
+    int64_t deadline = -1;
+    host_res_t *r = _host_ready_event(0, _host_now(), &deadline);
+    if (r && r->vector == _select_non_callback) {
+      uint32_t id = (uint32_t)(uintptr_t)r->ev;
+      _host_unlock();
+      return id;
+    }
+    if (r) {
+      void (*vector)(void) = r->vector;
+      core->ed = r->ev;
+      _host_unlock();
+      vector();
+      _host_lock();
+      // As on the xCORE, a callback returns to waiting for the next event.
+      wait = 1;
+      continue;
+    }
+    if (!wait) {
+      // Polling takes a core clock cycle, so that other cores can run, the
+      // tokens in flight arrive and a polling loop lets time pass.
+      _host_block(_host_now() + _HOST_XCORE_PERIOD_NS);
+      _host_unlock();
+      return no_wait_id;
+    }
+    _host_block(deadline);
+  }
+}
+
+static void _host_enable_ordered(const resource_t ids[])
+{
+  _host_clre();
+  for (unsigned i = 0; ids[i]; i++) {
+    _host_eeu(ids[i]);
+  }
+}
+
+uint32_t select_wait(void)
+{
+  return _host_select(1, 0);
+}
+
+uint32_t select_no_wait(uint32_t no_wait_id)
+{
+  return _host_select(0, no_wait_id);
+}
+
+uint32_t select_wait_ordered(const resource_t ids[])
+{
+  _host_enable_ordered(ids);
+  return _host_select(1, 0);
+}
+
+uint32_t select_no_wait_ordered(uint32_t no_wait_id, const resource_t ids[])
+{
+  _host_enable_ordered(ids);
+  return _host_select(0, no_wait_id);
+}
+
+//
+// Timers.
+//
+
+uint32_t _host_gettime(void)
+{
+  _host_core();
+  _host_lock();
+  // Wait for the next tick, rather than just for another core to change the
+  // state, so that cores polling the time and each other let the clock advance.
+  int64_t tick = (_host_now() / _HOST_REF_PERIOD_NS + 1) * _HOST_REF_PERIOD_NS;
+  while (_host_now() < tick) {
+    _host_block(tick);
+  }
+  uint32_t now = (uint32_t)(_host_now() / _HOST_REF_PERIOD_NS);
+  _host_unlock();
+  return now;
+}
+
+void _host_debug_printf(const char *fmt, ...)
+{
+  // As lib_logging, which prints hexadecimal in upper case.
+  char f[256];
+  size_t n = 0;
+  for (int conv = 0; *fmt && n < sizeof(f) - 1; fmt++) {
+    char ch = *fmt;
+    if (conv && ch == 'x') {
+      ch = 'X';
+    }
+    if (ch == '%') {
+      conv = !conv;
+    } else if (conv && isalpha((unsigned char)ch) && ch != 'l' && ch != 'h') {
+      conv = 0;
+    }
+    f[n++] = ch;
+  }
+  f[n] = 0;
+
+  va_list args;
+  va_start(args, fmt);
+  vprintf(f, args);
+  va_end(args);
+
+  // Printing is slow compared with the code around it.
+  _host_core();
+  _host_lock();
+  int64_t until = _host_now() + (int64_t)XCORE_C_HOST_PRINT_TICKS * _HOST_REF_PERIOD_NS;
+  while (_host_now() < until) {
+    _host_block(until);
+  }
+  _host_unlock();
+}
+
+uint32_t _host_core_timer(void)
+{
+  return _host_core()->timer;
+}
+
+void _host_core_timer_realloc(void)
+{
+  host_thread_t *core = _host_core();
+  core->timer = _host_getr(XS1_RES_TYPE_TIMER);
+  if (!core->timer) {
+    _host_throw(XS1_ET_ECALL, 0);
+  }
+}
+
+void _host_core_timer_free(void)
+{
+  host_thread_t *core = _host_core();
+  if (!core->timer) {
+    _host_throw(XS1_ET_ILLEGAL_RESOURCE, 0);
+  }
+  _host_freer(core->timer);
+  core->timer = 0;
+}
+
+//
+// Running logical cores, and wiring ports together.
+//
+
+#if XCORE_C_HOST_SIM
+
+void host_sim_seed(uint32_t seed)
+{
+  _host_core();
+  _host_seed = seed;
+  _host_random_state = seed;
+  _host_time = 0;
+}
+
+// Each fiber starts here, with _host_self set to its logical core.
+static void _host_core_main(void)
+{
+  host_thread_t *self = _host_self;
+  self->timer = _host_getr(XS1_RES_TYPE_TIMER);
+  self->task->func(self->task->arg);
+  if (self->timer) {
+    _host_freer(self->timer);
+  }
+  self->inuse = 0;
+  self->parent->joining--;
+  _host_notify();
+  _host_stop_running();
+  // The parent is runnable, having been notified. It frees this stack.
+  host_thread_t *next = _host_pick();
+  _host_self = next;
+  setcontext(&next->ctx);
+}
+
+void host_par(const host_core_t cores[], size_t n)
+{
+  host_thread_t *self = _host_core();
+  void *stacks[_HOST_MAX_CORES];
+  if (n > _HOST_MAX_CORES) {
+    _host_throw(XS1_ET_ECALL, 0);
+  }
+  for (size_t i = 0; i < n; i++) {
+    host_thread_t *core = _host_claim_core();
+    core->task = &cores[i];
+    core->parent = self;
+    core->stack = malloc(_HOST_SIM_STACK);
+    if (!core->stack) {
+      _host_fail("out of memory for logical core stacks");
+    }
+    getcontext(&core->ctx);
+    core->ctx.uc_stack.ss_sp = core->stack;
+    core->ctx.uc_stack.ss_size = _HOST_SIM_STACK;
+    core->ctx.uc_link = NULL;
+    makecontext(&core->ctx, _host_core_main, 0);
+    stacks[i] = core->stack;
+  }
+  self->joining = n;
+  while (self->joining) {
+    _host_wait(-1);
+  }
+  for (size_t i = 0; i < n; i++) {
+    free(stacks[i]);
+  }
+}
+
+#else
+
+typedef struct host_start_t {
+  const host_core_t *task;
+  host_thread_t *core;
+} host_start_t;
+
+static void *_host_core_main(void *arg)
+{
+  const host_start_t *start = arg;
+  _host_self = start->core;
+  _host_self->timer = _host_getr(XS1_RES_TYPE_TIMER);
+  start->task->func(start->task->arg);
+  if (_host_self->timer) {
+    _host_freer(_host_self->timer);
+  }
+  _host_lock();
+  _host_self->inuse = 0;
+  _host_stop_running();
+  _host_unlock();
+  return NULL;
+}
+
+void host_par(const host_core_t cores[], size_t n)
+{
+  pthread_t threads[_HOST_MAX_CORES];
+  host_start_t starts[_HOST_MAX_CORES];
+  _host_core();
+  if (n > _HOST_MAX_CORES) {
+    _host_throw(XS1_ET_ECALL, 0);
+  }
+  // The cores are running from the start, so time cannot advance until they wait.
+  _host_lock();
+  for (size_t i = 0; i < n; i++) {
+    starts[i].task = &cores[i];
+    starts[i].core = _host_claim_core();
+  }
+  _host_stop_running();
+  _host_unlock();
+  for (size_t i = 0; i < n; i++) {
+    pthread_create(&threads[i], NULL, _host_core_main, &starts[i]);
+  }
+  for (size_t i = 0; i < n; i++) {
+    pthread_join(threads[i], NULL);
+  }
+  _host_lock();
+  _host_running++;
+  _host_unlock();
+}
+
+#endif // XCORE_C_HOST_SIM
+
+void _host_port_connect(uint32_t from, uint32_t to)
+{
+  _host_enter_any(from, XS1_RES_TYPE_PORT);
+  host_res_t *p = _host_find(to);
+  if (!p || p->id != to || _HOST_RES_TYPE(to) != XS1_RES_TYPE_PORT) {
+    _host_raise(XS1_ET_ILLEGAL_RESOURCE, to);
+  }
+  p->wired = from;
+  free(p->stimulus);
+  p->stimulus = NULL;
+  _host_leave();
+}
+
+//
+// Stimulus and trace files, in a subset of the Value Change Dump format.
+//
+
+// Read the next whitespace separated word of a file. Returns 0 at its end.
+static int _host_vcd_word(FILE *f, char *word, size_t size, unsigned *line)
+{
+  int c;
+  size_t n = 0;
+  while ((c = fgetc(f)) != EOF && isspace(c)) {
+    *line += c == '\n';
+  }
+  while (c != EOF && !isspace(c)) {
+    if (n + 1 < size) {
+      word[n++] = c;
+    }
+    c = fgetc(f);
+  }
+  *line += c == '\n';
+  word[n] = '\0';
+  return n != 0;
+}
+
+__attribute__((noreturn)) static void _host_vcd_fail(const char *filename, unsigned line,
+                                                     const char *msg)
+{
+  char text[256];
+  if (line) {
+    snprintf(text, sizeof(text), "%s:%u: %s", filename, line, msg);
+  }
+  else {
+    snprintf(text, sizeof(text), "%s: %s", filename, msg);
+  }
+  _host_fail(text);
+}
+
+// Skip the rest of a declaration, returning its words joined together.
+static void _host_vcd_skip(FILE *f, const char *filename, unsigned *line,
+                           char *text, size_t size)
+{
+  char word[64];
+  text[0] = '\0';
+  for (;;) {
+    if (!_host_vcd_word(f, word, sizeof(word), line)) {
+      _host_vcd_fail(filename, *line, "declaration has no $end");
+    }
+    if (!strcmp(word, "$end")) {
+      return;
+    }
+    strncat(text, word, size - strlen(text) - 1);
+    strncat(text, " ", size - strlen(text) - 1);
+  }
+}
+
+// Load the value changes of the first variable declared in a file, with their
+// times in nanoseconds from the start of the file.
+static host_pin_change_t *_host_vcd_read(const char *filename, size_t *count)
+{
+  static const struct { const char *unit; int64_t mul; int64_t div; } units[] = {
+    { "s", 1000000000, 1 }, { "ms", 1000000, 1 }, { "us", 1000, 1 },
+    { "ns", 1, 1 }, { "ps", 1, 1000 }, { "fs", 1, 1000000 },
+  };
+  FILE *f = fopen(filename, "r");
+  if (!f) {
+    _host_vcd_fail(filename, 0, "cannot open stimulus file");
+  }
+  char word[64], text[256], id[64] = "";
+  unsigned line = 1;
+  int64_t mul = 1, div = 1, t = 0;
+  size_t n = 0, size = 64;
+  host_pin_change_t *changes = malloc(size * sizeof(changes[0]));
+  while (changes && _host_vcd_word(f, word, sizeof(word), &line)) {
+    const char *change_id;
+    uint32_t value = 0;
+    if (!strcmp(word, "$timescale")) {
+      _host_vcd_skip(f, filename, &line, text, sizeof(text));
+      char *unit;
+      long number = strtol(text, &unit, 10);
+      unsigned i;
+      while (isspace((unsigned char)*unit)) {
+        unit++;
+      }
+      for (i = 0; i < sizeof(units) / sizeof(units[0]); i++) {
+        if (!strncmp(unit, units[i].unit, strlen(units[i].unit)) &&
+            isspace((unsigned char)unit[strlen(units[i].unit)])) {
+          break;
+        }
+      }
+      if (number <= 0 || i == sizeof(units) / sizeof(units[0])) {
+        _host_vcd_fail(filename, line, "invalid $timescale");
+      }
+      mul = number * units[i].mul;
+      div = units[i].div;
+      continue;
+    }
+    if (!strcmp(word, "$var")) {
+      _host_vcd_skip(f, filename, &line, text, sizeof(text));
+      // The type, width and identifier, then the name.
+      char var_id[64];
+      if (sscanf(text, "%*s %*s %63s", var_id) != 1) {
+        _host_vcd_fail(filename, line, "invalid $var");
+      }
+      if (!id[0]) {
+        strcpy(id, var_id);
+      }
+      continue;
+    }
+    if (word[0] == '$') {
+      // Value changes may follow these, and $end follows the changes.
+      if (strcmp(word, "$dumpvars") && strcmp(word, "$dumpall") &&
+          strcmp(word, "$dumpon") && strcmp(word, "$dumpoff") && strcmp(word, "$end")) {
+        _host_vcd_skip(f, filename, &line, text, sizeof(text));
+      }
+      continue;
+    }
+    if (word[0] == '#') {
+      int64_t next = strtoll(&word[1], NULL, 10) * mul / div;
+      if (next < t) {
+        _host_vcd_fail(filename, line, "time goes backwards");
+      }
+      t = next;
+      continue;
+    }
+    if (word[0] == 'b' || word[0] == 'B') {
+      for (const char *bit = &word[1]; *bit; bit++) {
+        if (!strchr("01xXzZ", *bit)) {
+          _host_vcd_fail(filename, line, "invalid vector value");
+        }
+        value = (value << 1) | (*bit == '1');
+      }
+      if (!_host_vcd_word(f, text, sizeof(text), &line)) {
+        _host_vcd_fail(filename, line, "vector value has no identifier");
+      }
+      change_id = text;
+    }
+    else if (strchr("01xXzZ", word[0])) {
+      value = word[0] == '1';
+      change_id = &word[1];
+    }
+    else {
+      _host_vcd_fail(filename, line, "unsupported value change");
+    }
+    if (id[0] && strcmp(change_id, id)) {
+      continue;
+    }
+    if (n && changes[n - 1].t == t) {
+      changes[n - 1].value = value;
+      continue;
+    }
+    if (n == size) {
+      size *= 2;
+      changes = realloc(changes, size * sizeof(changes[0]));
+      if (!changes) {
+        break;
+      }
+    }
+    changes[n].t = t;
+    changes[n].value = value;
+    n++;
+  }
+  fclose(f);
+  if (!changes) {
+    _host_fail("out of memory for stimulus");
+  }
+  *count = n;
+  return changes;
+}
+
+// Stop tracing a port, and write the changes captured to its trace file.
+static void _host_vcd_write(host_res_t *p)
+{
+  FILE *f = p->trace_file;
+  fprintf(f, "$timescale 1ns $end\n");
+  fprintf(f, "$scope module xcore_c $end\n");
+  fprintf(f, "$var wire %u ! port_0x%x $end\n", (unsigned)p->width, (unsigned)p->id);
+  fprintf(f, "$upscope $end\n");
+  fprintf(f, "$enddefinitions $end\n");
+  for (size_t i = 0; i < p->trace_count; i++) {
+    fprintf(f, "#%lld\nb", (long long)(p->trace[i].t - p->trace_start));
+    for (int bit = p->width - 1; bit >= 0; bit--) {
+      fputc('0' + ((p->trace[i].value >> bit) & 1), f);
+    }
+    fprintf(f, " !\n");
+  }
+  fclose(f);
+  free(p->trace);
+  p->trace = NULL;
+  p->trace_file = NULL;
+}
+
+// Traces not stopped by the application are written as it exits.
+static void _host_vcd_exit(void)
+{
+  for (unsigned i = 0; i < _HOST_PORTS; i++) {
+    if (_host_ports[i].trace) {
+      _host_vcd_write(&_host_ports[i]);
+    }
+  }
+}
+
+void _host_port_stimulus(uint32_t p, const char *filename)
+{
+  size_t n = 0;
+  host_pin_change_t *changes = filename ? _host_vcd_read(filename, &n) : NULL;
+  host_res_t *res = _host_enter_any(p, XS1_RES_TYPE_PORT);
+  for (size_t i = 0; i < n; i++) {
+    changes[i].t += _host_now();
+  }
+  free(res->stimulus);
+  res->stimulus = changes;
+  res->stimulus_count = n;
+  res->wired = 0;
+  _host_leave();
+}
+
+void _host_port_trace(uint32_t p, const char *filename)
+{
+  host_res_t *res = _host_enter_any(p, XS1_RES_TYPE_PORT);
+  if (res->trace) {
+    _host_vcd_write(res);
+  }
+  if (filename) {
+    int64_t now = _host_now();
+    res->trace_file = fopen(filename, "w");
+    res->trace_size = 64;
+    res->trace = malloc(res->trace_size * sizeof(res->trace[0]));
+    if (!res->trace_file || !res->trace) {
+      _host_vcd_fail(filename, 0, "cannot create trace file");
+    }
+    // Start with the value on the pins, and any changes already scheduled.
+    res->trace_count = 0;
+    res->trace_start = now;
+    _host_trace_append(res, now, _host_pin_driven(res, now));
+    for (unsigned i = 0; i < res->log_count; i++) {
+      const host_pin_change_t *e = &res->log[(res->log_head + i) % _HOST_PIN_LOG];
+      if (e->t > now) {
+        _host_trace_append(res, e->t, e->value);
+      }
+    }
+  }
+  _host_leave();
+}
+
+// The host version of xcore_c_port_stream.S
+void _port_stream_fill(uint32_t p, uint32_t buf[], size_t n)
+{
+  for (size_t i = 0; i < n; i++) {
+    buf[i] = _host_in(p);
+  }
+}
+
+#endif // XCORE_C_HOST
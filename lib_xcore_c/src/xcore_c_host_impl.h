@@ -0,0 +1,93 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+
+#ifndef __xcore_c_host_impl_h__
+#define __xcore_c_host_impl_h__
+
+// This file contains private implementation details and is not part of the API.
+// The contents may vary between releases.
+
+// The user may build the library for the host backend.
+#ifndef XCORE_C_HOST
+#define XCORE_C_HOST 0
+#endif
+
+// The user may run the logical cores as deterministically scheduled fibers.
+#ifndef XCORE_C_HOST_SIM
+#define XCORE_C_HOST_SIM 0
+#endif
+
+// The user may set the time a debug_printf() takes, in reference clock ticks.
+// Printing on the xCORE is slow compared with the code around it, and tests
+// rely on other logical cores running while a core prints.
+#ifndef XCORE_C_HOST_PRINT_TICKS
+#define XCORE_C_HOST_PRINT_TICKS 1000
+#endif
+
+#if (!defined(__XC__) || defined(__DOXYGEN__)) && XCORE_C_HOST
+
+#include <stdint.h>
+
+/** A logical core to be run by host_par().
+ *
+ *  The function is called with its argument on a logical core of its own.
+ */
+typedef struct host_core_t {
+  void (*func)(void *arg);
+  void *arg;
+} host_core_t;
+
+// Each xCORE instruction used by the library is emulated by a function of the
+// same name, operating on the resource identified by 'r'.
+// They are all implemented in xcore_c_host.c
+extern uint32_t _host_getr(uint32_t type);
+extern void _host_freer(uint32_t r);
+extern void _host_setc(uint32_t r, uint32_t c);
+extern void _host_setd(uint32_t r, uint32_t d);
+extern void _host_setclk(uint32_t r, uint32_t source);
+extern void _host_setrdy(uint32_t r, uint32_t ready_source);
+extern void _host_settw(uint32_t r, uint32_t width);
+extern void _host_setpt(uint32_t r, uint32_t t);
+extern void _host_clrpt(uint32_t r);
+extern uint32_t _host_getts(uint32_t r);
+extern void _host_out(uint32_t r, uint32_t data);
+extern void _host_outt(uint32_t r, uint32_t data);
+extern void _host_outct(uint32_t r, uint32_t ct);
+extern uint32_t _host_outshr(uint32_t r, uint32_t data);
+extern uint32_t _host_in(uint32_t r);
+extern uint32_t _host_int(uint32_t r);
+extern uint32_t _host_inshr(uint32_t r, uint32_t data);
+extern void _host_chkct(uint32_t r, uint32_t ct);
+extern uint32_t _host_peek(uint32_t r);
+extern uint32_t _host_endin(uint32_t r);
+
+// Events and interrupts.
+extern void _host_setv(uint32_t r, void (*vector)(void));
+extern void _host_setev(uint32_t r, void *ev);
+extern void _host_eeu(uint32_t r);
+extern void _host_edu(uint32_t r);
+extern void _host_clre(void);
+extern void *_host_get_ed(void);
+
+// The logical core's status register and identity.
+extern uint32_t _host_getsr(uint32_t mask);
+extern void _host_setsr(uint32_t mask);
+extern void _host_clrsr(uint32_t mask);
+extern uint32_t _host_get_id(void);
+
+// The reference clock, and the timer allocated to each logical core for xC use.
+extern uint32_t _host_gettime(void);
+extern uint32_t _host_core_timer(void);
+extern void _host_core_timer_realloc(void);
+extern void _host_core_timer_free(void);
+
+// Drive the pins of port 'to' from port 'from'.
+extern void _host_port_connect(uint32_t from, uint32_t to);
+
+// Drive the pins of port 'p' from a stimulus file, or trace the changes output
+// on them to a file. A NULL filename stops either.
+extern void _host_port_stimulus(uint32_t p, const char *filename);
+extern void _host_port_trace(uint32_t p, const char *filename);
+
+#endif // (!defined(__XC__) || defined(__DOXYGEN__)) && XCORE_C_HOST
+
+#endif // __xcore_c_host_impl_h__
@@ -1,6 +1,7 @@
 // Copyright (c) 2016, XMOS Ltd, All rights reserved
 
 #include "xcore_c_hwtimer_impl.h"
+volatile _hwtimer_core_wait_t _xcore_c_hwtimer_core_waits[_XCORE_C_HWTIMER_MAX_CORES];
 extern void _hwtimer_free_xc_timer(void);
 extern void _hwtimer_realloc_xc_timer(void);
 extern hwtimer_t _hwtimer_alloc(void);
@@ -9,6 +10,12 @@ extern void _hwtimer_get_time(hwtimer_t t, uint32_t *now);
 extern void _hwtimer_change_trigger_time(hwtimer_t t, uint32_t time);
 extern void _hwtimer_set_trigger_time(hwtimer_t t, uint32_t time);
 extern void _hwtimer_clear_trigger_time(hwtimer_t t);
+extern hwtimer_t _hwtimer_core_timer(void);
+extern uint32_t _hwtimer_core_get_time(void);
+extern void _hwtimer_core_wait_until(uint32_t until);
+extern void _hwtimer_core_spin_until(uint32_t until);
+extern void _hwtimer_periodic_init(hwtimer_periodic_t *pt, hwtimer_t t, uint32_t period);
+extern uint32_t _hwtimer_periodic_rearm(hwtimer_periodic_t *pt);
 
 #include "xcore_c_hwtimer.h"
 extern xcore_c_error_t hwtimer_free_xc_timer(void);
@@ -27,3 +34,47 @@ extern xcore_c_error_t hwtimer_setup_select_callback(hwtimer_t t, uint32_t time,
 extern xcore_c_error_t hwtimer_setup_interrupt_callback(hwtimer_t t, uint32_t time, void *data, interrupt_callback_t intrpt);
 extern xcore_c_error_t hwtimer_enable_trigger(hwtimer_t t);
 extern xcore_c_error_t hwtimer_disable_trigger(hwtimer_t t);
+
+extern xcore_c_error_t hwtimer_core_get_time(uint32_t *now);
+extern xcore_c_error_t hwtimer_core_wait_until(uint32_t until);
+extern xcore_c_error_t hwtimer_core_delay(uint32_t period);
+extern xcore_c_error_t hwtimer_core_spin_until(uint32_t until);
+extern xcore_c_error_t hwtimer_core_spin(uint32_t period);
+
+extern xcore_c_error_t hwtimer_periodic_init(hwtimer_periodic_t *pt, hwtimer_t t, uint32_t period);
+extern xcore_c_error_t hwtimer_periodic_setup_select(hwtimer_periodic_t *pt, uint32_t enum_id);
+extern xcore_c_error_t hwtimer_periodic_setup_select_callback(hwtimer_periodic_t *pt, void *data, select_callback_t func);
+extern xcore_c_error_t hwtimer_periodic_setup_interrupt_callback(hwtimer_periodic_t *pt, void *data, interrupt_callback_t func);
+extern xcore_c_error_t hwtimer_periodic_rearm(hwtimer_periodic_t *pt, uint32_t *missed);
+extern xcore_c_error_t hwtimer_periodic_get_overruns(const hwtimer_periodic_t *pt, uint32_t *overruns);
+
+// Number of minimum length delays timed by hwtimer_core_delay_calibrate().
+#define CALIBRATION_RUNS 8
+
+xcore_c_error_t hwtimer_core_delay_calibrate(uint32_t *delay_overhead, uint32_t *spin_overhead)
+{
+  uint32_t delay_best = UINT32_MAX;
+  uint32_t spin_best = UINT32_MAX;
+  for (int i = 0; i < CALIBRATION_RUNS; i++) {
+    // Request one tick more than the compensation so a real wait takes place.
+    uint32_t start = _hwtimer_core_get_time();
+    hwtimer_core_delay(XCORE_C_DELAY_OVERHEAD_TICKS + 1);
+    uint32_t cost = _hwtimer_core_get_time() - start;
+    if (cost < delay_best) {
+      delay_best = cost;
+    }
+    start = _hwtimer_core_get_time();
+    hwtimer_core_spin(XCORE_C_SPIN_OVERHEAD_TICKS + 1);
+    cost = _hwtimer_core_get_time() - start;
+    if (cost < spin_best) {
+      spin_best = cost;
+    }
+  }
+  // Remove the requested tick and the cost of reading the time.
+  uint32_t start = _hwtimer_core_get_time();
+  uint32_t fixed = _hwtimer_core_get_time() - start + 1;
+  RETURN_EXCEPTION_OR_ERROR(  do { \
+                                *delay_overhead = (delay_best > fixed) ? delay_best - fixed : 0; \
+                                *spin_overhead = (spin_best > fixed) ? spin_best - fixed : 0; \
+                              } while (0) );
+}
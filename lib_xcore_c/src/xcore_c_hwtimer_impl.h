@@ -28,6 +28,9 @@ typedef unsigned hwtimer_t;
 
 inline void _hwtimer_realloc_xc_timer(void)
 {
+#if XCORE_C_HOST
+  _host_core_timer_realloc();
+#else
   // __init_threadlocal_timer has resource ID in r2 and it may be zero.
   // Implement a checked version here instead.
   unsigned tmr, addr;
@@ -36,12 +39,17 @@ inline void _hwtimer_realloc_xc_timer(void)
   asm volatile( "ldaw %0, dp[__timers]" : "=r" (addr));
   asm volatile( "get r11, id" ::: /* clobbers */ "r11");
   asm volatile( "stw  %0, %1[r11]" : : "r" (tmr), "r" (addr));
+#endif
 }
 
 extern void __free_threadlocal_timer(void);
 inline void _hwtimer_free_xc_timer(void)
 {
+#if XCORE_C_HOST
+  _host_core_timer_free();
+#else
   __free_threadlocal_timer();
+#endif
 }
 
 inline hwtimer_t _hwtimer_alloc(void)
@@ -58,12 +66,20 @@ inline void _hwtimer_free(hwtimer_t t)
 
 inline void _hwtimer_get_time(hwtimer_t t, uint32_t *now)
 {
+#if XCORE_C_HOST
+  *now = _host_in(t);
+#else
   asm volatile("in %0, res[%1]" : "=r" (*now): "r" (t));
+#endif
 }
 
 inline void _hwtimer_change_trigger_time(hwtimer_t t, uint32_t time)
 {
+#if XCORE_C_HOST
+  _host_setd(t, time);
+#else
   asm volatile("setd res[%0], %1" :: "r" (t), "r" (time));
+#endif
 }
 
 inline void _hwtimer_set_trigger_time(hwtimer_t t, uint32_t time)
@@ -78,6 +94,135 @@ inline void _hwtimer_clear_trigger_time(hwtimer_t t)
   // hwtimer_get_time() will respond immediately
 }
 
+// The hardware timer allocated to this logical core for xC use.
+inline hwtimer_t _hwtimer_core_timer(void)
+{
+#if XCORE_C_HOST
+  return _host_core_timer();
+#else
+  hwtimer_t t;
+  asm volatile( "ldaw %0, dp[__timers]" : "=r" (t));
+  asm volatile( "get r11, id" ::: /* clobbers */ "r11");
+  asm volatile( "ldw %0, %0[r11]" : "+r" (t));
+  return t;
+#endif
+}
+
+// The number of logical cores on a tile.
+#define _XCORE_C_HWTIMER_MAX_CORES 8
+
+// The trigger time each logical core's xC timer is waiting for in
+// _hwtimer_core_wait_until(). The hardware can't report a timer's condition,
+// so this is what lets an interrupt handler read the timer and put the
+// condition back for the interrupted wait.
+typedef struct _hwtimer_core_wait_t {
+  uint32_t until;
+  int waiting;
+} _hwtimer_core_wait_t;
+extern volatile _hwtimer_core_wait_t _xcore_c_hwtimer_core_waits[_XCORE_C_HWTIMER_MAX_CORES];
+
+inline uint32_t _hwtimer_core_get_time(void)
+{
+  uint32_t now;
+#if defined(__XS2A__)
+  asm volatile("gettime %0" : "=r" (now));
+#else
+  hwtimer_t t = _hwtimer_core_timer();
+  volatile _hwtimer_core_wait_t *w = &_xcore_c_hwtimer_core_waits[_error_core_id()];
+  _hwtimer_clear_trigger_time(t);
+  _hwtimer_get_time(t, &now);
+  if (w->waiting) {
+    // An interrupt taken during _hwtimer_core_wait_until() restarts its IN.
+    _hwtimer_set_trigger_time(t, w->until);
+  }
+#endif
+  return now;
+}
+
+inline void _hwtimer_core_wait_until(uint32_t until)
+{
+  hwtimer_t t = _hwtimer_core_timer();
+  volatile _hwtimer_core_wait_t *w = &_xcore_c_hwtimer_core_waits[_error_core_id()];
+  // An interrupt handler may wait while the code it interrupted is waiting.
+  uint32_t outer_until = w->until;
+  int outer_waiting = w->waiting;
+  uint32_t now;
+  w->until = until;
+  w->waiting = 1;
+  _hwtimer_set_trigger_time(t, until);
+  _hwtimer_get_time(t, &now);
+  w->waiting = outer_waiting;
+  w->until = outer_until;
+  if (outer_waiting) {
+    _hwtimer_set_trigger_time(t, outer_until);
+  }
+  else {
+    _hwtimer_clear_trigger_time(t);
+  }
+}
+
+inline void _hwtimer_core_spin_until(uint32_t until)
+{
+#if defined(__XS2A__)
+  uint32_t now;
+  do {
+    asm volatile("gettime %0" : "=r" (now));
+  } while ((int32_t)(now - until) < 0);
+#else
+  hwtimer_t t = _hwtimer_core_timer();
+  uint32_t now;
+  _hwtimer_clear_trigger_time(t);
+  do {
+    _hwtimer_get_time(t, &now);
+  } while ((int32_t)(now - until) < 0);
+#endif
+}
+
+/** An opaque type for handling periodic timer events
+ *
+ *  Users must not access its raw underlying type.
+ */
+typedef struct hwtimer_periodic_t {
+#ifndef __DOXYGEN__
+  hwtimer_t t;
+  uint32_t period;
+  uint32_t next;      // Time of the currently armed event.
+  uint32_t overruns;
+#endif // __DOXYGEN__
+} hwtimer_periodic_t;
+
+inline void _hwtimer_periodic_init(hwtimer_periodic_t *pt, hwtimer_t t, uint32_t period)
+{
+  uint32_t now;
+  _hwtimer_clear_trigger_time(t);
+  _hwtimer_get_time(t, &now);
+  pt->t = t;
+  pt->period = period;
+  pt->next = now + period;
+  pt->overruns = 0;
+  _hwtimer_set_trigger_time(t, pt->next);
+}
+
+// Returns the number of events missed.
+inline uint32_t _hwtimer_periodic_rearm(hwtimer_periodic_t *pt)
+{
+  uint32_t now;
+  _hwtimer_get_time(pt->t, &now);  // Waits for, and clears, the current event.
+  // Advance from the previous deadline, not from 'now', so we do not drift.
+  uint32_t next = pt->next + pt->period;
+  uint32_t missed = 0;
+  if ((int32_t)(now - next) > 0) {
+    // Skip the deadlines already passed rather than firing back-to-back. A
+    // deadline of 'now' is armed, and fires straight away.
+    missed = (now - next - 1) / pt->period + 1;
+    next += missed * pt->period;
+    pt->overruns += missed;
+  }
+  pt->next = next;
+  _hwtimer_change_trigger_time(pt->t, next);
+  return missed;
+}
+
 #endif // !defined(__XC__)
 
 #endif // __xcore_c_hwtimer_impl_h__
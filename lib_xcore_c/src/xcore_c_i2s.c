@@ -0,0 +1,176 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+
+#include "xcore_c_i2s_impl.h"
+#include "xcore_c_hwtimer_impl.h"
+#include "xcore_c_select.h"
+extern void _i2s_configure_port(port p, clock clk);
+extern uint32_t _i2s_buffer_next(const i2s_buffer_t *b, uint32_t count);
+extern uint32_t *_i2s_buffer_frame(const i2s_buffer_t *b, uint32_t count);
+extern int _i2s_buffer_read(i2s_buffer_t *b, uint32_t frame[]);
+extern int _i2s_buffer_write(i2s_buffer_t *b, const uint32_t frame[]);
+
+// The word clock value for a slot, least significant bit first.
+static uint32_t _i2s_lrclk_word(const i2s_t *i2s, size_t slot)
+{
+  if (i2s->mode == I2S_MODE_I2S) {
+    return slot ? 0xFFFFFFFF : 0;
+  }
+  return slot ? 0 : 1;
+}
+
+static void _i2s_next_tx_frame(i2s_t *i2s, i2s_buffer_t *tx)
+{
+  if (i2s->num_out && !_i2s_buffer_read(tx, i2s->tx_frame)) {
+    // Send silence rather than repeating the last frame.
+    for (size_t i = 0; i < i2s->num_out * i2s->channels; i++) {
+      i2s->tx_frame[i] = 0;
+    }
+    i2s->underruns++;
+  }
+}
+
+static void _i2s_out_slot(const i2s_t *i2s, size_t slot)
+{
+  if (i2s->master) {
+    _port_out(i2s->p_lrclk, _i2s_lrclk_word(i2s, slot));
+  }
+  for (size_t i = 0; i < i2s->num_out; i++) {
+    _port_out(i2s->p_dout[i], _port_bitrev(i2s->tx_frame[i * i2s->channels + slot]));
+  }
+}
+
+// Returns 0 if a slave's word clock is not as expected for the slot.
+static int _i2s_in_slot(i2s_t *i2s, size_t slot)
+{
+  int in_sync = 1;
+  if (!i2s->master) {
+    in_sync = _port_in(i2s->p_lrclk) == _i2s_lrclk_word(i2s, slot);
+  }
+  for (size_t i = 0; i < i2s->num_in; i++) {
+    i2s->rx_frame[i * i2s->channels + slot] = _port_bitrev(_port_in(i2s->p_din[i]));
+  }
+  return in_sync;
+}
+
+// The events a slave waits for while finding the start of a frame.
+enum {
+  _I2S_EVENT_LRCLK = ENUM_ID_BASE,
+  _I2S_EVENT_POLL,
+};
+
+// Wait for a slave's word clock to take a value, returning 0 if the engine
+// is stopped first. The bit clock may have stopped, so the timer wakes the
+// core to look at the stop flag.
+static int _i2s_wait_lrclk(const i2s_t *i2s, hwtimer_t tmr, uint32_t value)
+{
+  uint32_t poll;
+  _hwtimer_get_time(tmr, &poll);
+  _port_set_trigger_in_equal(i2s->p_lrclk, value);
+  _resource_setup_select((resource_t)i2s->p_lrclk, _I2S_EVENT_LRCLK);
+  _resource_enable_trigger((resource_t)i2s->p_lrclk);
+  _resource_setup_select((resource_t)tmr, _I2S_EVENT_POLL);
+  int found = 0;
+  while (!found && !i2s->stop) {
+    poll += XCORE_C_I2S_STOP_POLL_TICKS;
+    _hwtimer_set_trigger_time(tmr, poll);
+    _resource_enable_trigger((resource_t)tmr);
+    found = select_wait() == _I2S_EVENT_LRCLK;
+  }
+  _resource_disable_trigger((resource_t)tmr);
+  _resource_disable_trigger((resource_t)i2s->p_lrclk);
+  if (found) {
+    (void) _port_in(i2s->p_lrclk);
+  }
+  return found;
+}
+
+// Wait for the start of a frame on a slave's word clock, setting its port
+// time. Returns 0 if the engine is stopped first.
+static int _i2s_sync(const i2s_t *i2s, hwtimer_t tmr, int16_t *frame_time)
+{
+  uint32_t first = _i2s_lrclk_word(i2s, 0) & 1;
+  int found = _i2s_wait_lrclk(i2s, tmr, !first) && _i2s_wait_lrclk(i2s, tmr, first);
+  _port_clear_trigger_in(i2s->p_lrclk);
+  *frame_time = _port_get_trigger_time(i2s->p_lrclk);
+  return found;
+}
+
+// Align all the ports to a frame starting at the given port time.
+// The data is one bit clock behind the word clock, and inputs are timed
+// by their last bit.
+static void _i2s_align(const i2s_t *i2s, int16_t frame_time)
+{
+  int16_t data_time = frame_time + 1;
+  _port_clear_buffer(i2s->p_lrclk);
+  _port_set_trigger_time(i2s->p_lrclk, i2s->master ? frame_time : frame_time + 31);
+  for (size_t i = 0; i < i2s->num_out; i++) {
+    _port_clear_buffer(i2s->p_dout[i]);
+    _port_set_trigger_time(i2s->p_dout[i], data_time);
+  }
+  for (size_t i = 0; i < i2s->num_in; i++) {
+    _port_clear_buffer(i2s->p_din[i]);
+    _port_set_trigger_time(i2s->p_din[i], data_time + 31);
+  }
+}
+
+void _i2s_run(i2s_t *i2s, i2s_buffer_t *tx, i2s_buffer_t *rx)
+{
+  hwtimer_t tmr = i2s->master ? 0 : _hwtimer_alloc();
+  while (!i2s->stop) {
+    if (i2s->master) {
+      _i2s_align(i2s, 1);
+    }
+    else {
+      int16_t frame_time;
+      if (!_i2s_sync(i2s, tmr, &frame_time)) {
+        break;
+      }
+      // Skip the frame found while syncing to allow time to set up the ports.
+      _i2s_align(i2s, frame_time + 32 * i2s->channels);
+    }
+
+    // The outputs are kept one slot ahead of the inputs.
+    _i2s_next_tx_frame(i2s, tx);
+    _i2s_out_slot(i2s, 0);
+    if (i2s->master) {
+      _clock_start(i2s->clk);
+    }
+
+    int in_sync = 1;
+    while (in_sync && !i2s->stop) {
+      for (size_t slot = 0; slot < i2s->channels; slot++) {
+        if (slot + 1 < i2s->channels) {
+          _i2s_out_slot(i2s, slot + 1);
+        }
+        else {
+          _i2s_next_tx_frame(i2s, tx);
+          _i2s_out_slot(i2s, 0);
+        }
+        in_sync &= _i2s_in_slot(i2s, slot);
+      }
+      if (i2s->num_in && !_i2s_buffer_write(rx, i2s->rx_frame)) {
+        i2s->overruns++;
+      }
+    }
+    if (!in_sync) {
+      i2s->sync_errors++;
+    }
+  }
+  if (i2s->master) {
+    _clock_stop(i2s->clk);
+  }
+  else {
+    _hwtimer_free(tmr);
+  }
+}
+
+#include "xcore_c_i2s.h"
+extern xcore_c_error_t i2s_buffer_init(i2s_buffer_t *b, uint32_t mem[], size_t frame_words, size_t num_frames);
+extern xcore_c_error_t i2s_buffer_write(i2s_buffer_t *b, const uint32_t frame[], size_t *written);
+extern xcore_c_error_t i2s_buffer_read(i2s_buffer_t *b, uint32_t frame[], size_t *read);
+extern xcore_c_error_t i2s_init_master(i2s_t *i2s, i2s_mode_t mode, size_t channels, clock clk, port p_bclk, port p_lrclk);
+extern xcore_c_error_t i2s_init_slave(i2s_t *i2s, i2s_mode_t mode, size_t channels, clock clk, port p_bclk, port p_lrclk);
+extern xcore_c_error_t i2s_set_data_ports(i2s_t *i2s, const port p_dout[], size_t num_out, const port p_din[], size_t num_in);
+extern xcore_c_error_t i2s_run(i2s_t *i2s, i2s_buffer_t *tx, i2s_buffer_t *rx);
+extern xcore_c_error_t i2s_stop(i2s_t *i2s);
+extern xcore_c_error_t i2s_get_errors(const i2s_t *i2s, uint32_t *underruns, uint32_t *overruns, uint32_t *sync_errors);
@@ -0,0 +1,156 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+
+#ifndef __xcore_c_i2s_impl_h__
+#define __xcore_c_i2s_impl_h__
+
+// This file contains private implementation details and is not part of the API.
+// The contents may vary between releases.
+
+#ifndef XCORE_C_I2S_MAX_FRAME_WORDS
+/** The largest number of words in a frame exchanged by an i2s_t engine.
+ *
+ *  This is the number of channels multiplied by the larger of the number of
+ *  output and input data ports. The user may change it by setting the
+ *  XCORE_C_I2S_MAX_FRAME_WORDS define in their Makefile.
+ */
+#define XCORE_C_I2S_MAX_FRAME_WORDS 16
+#endif
+
+#ifndef XCORE_C_I2S_STOP_POLL_TICKS
+/** How often, in reference clock ticks, a slave i2s_t engine waiting for the
+ *  start of a frame looks to see if it has been stopped.
+ *
+ *  The wait ends when i2s_stop() is called, even if the bit clock has stopped.
+ *  The user may change it by setting the XCORE_C_I2S_STOP_POLL_TICKS define in
+ *  their Makefile.
+ */
+#define XCORE_C_I2S_STOP_POLL_TICKS 10000
+#endif
+
+#if !defined(__XC__) || defined(__DOXYGEN__)
+
+#include <stdint.h>
+#include <stddef.h>
+#include "xcore_c_port_impl.h"
+#include "xcore_c_clock_impl.h"
+
+/** Enumeration to declare the frame format used by an I2S engine.
+ *
+ *  I2S_MODE_I2S frames have two channels. The word clock is low for the
+ *  left channel and high for the right channel.
+ *  I2S_MODE_TDM frames have any number of channels. The frame sync is high for
+ *  the first bit clock of the frame.
+ *  In both formats the data is one bit clock behind the word clock.
+ */
+typedef enum {
+  I2S_MODE_I2S = 0,
+  I2S_MODE_TDM = 1,
+} i2s_mode_t;
+
+/** A lock-free buffer of frames shared between an I2S engine and the application.
+ *
+ *  Users must not access its raw underlying type.
+ */
+typedef struct i2s_buffer_t {
+#ifndef __DOXYGEN__
+  uint32_t *frames;
+  size_t frame_words;
+  size_t num_frames;
+  volatile uint32_t written;
+  volatile uint32_t read;
+#endif // __DOXYGEN__
+} i2s_buffer_t;
+
+/** An opaque type for an I2S or TDM master or slave engine.
+ *
+ *  Users must not access its raw underlying type.
+ */
+typedef struct i2s_t {
+#ifndef __DOXYGEN__
+  i2s_mode_t mode;
+  uint32_t master;
+  size_t channels;
+  clock clk;
+  port p_lrclk;
+  const port *p_dout;
+  size_t num_out;
+  const port *p_din;
+  size_t num_in;
+  volatile uint32_t stop;
+  uint32_t underruns;
+  uint32_t overruns;
+  uint32_t sync_errors;
+  uint32_t tx_frame[XCORE_C_I2S_MAX_FRAME_WORDS];
+  uint32_t rx_frame[XCORE_C_I2S_MAX_FRAME_WORDS];
+#endif // __DOXYGEN__
+} i2s_t;
+
+// Stop the compiler moving frame accesses across an update of the buffer counts.
+// The logical cores of a tile see memory in program order, but the host
+// backend's logical cores are threads on processors which may reorder.
+#if XCORE_C_HOST
+#define _I2S_BARRIER() __sync_synchronize()
+#else
+#define _I2S_BARRIER() asm volatile("" ::: "memory")
+#endif
+
+inline void _i2s_configure_port(port p, clock clk)
+{
+  _port_set_buffered(p);
+  _port_set_transfer_width(p, 32);
+  _port_set_clock(p, clk);
+}
+
+// The buffer counts run from 0 to twice the number of frames, wrapping back
+// to 0. So a full buffer can be told from an empty one, and a count's frame is
+// the same before and after it wraps.
+inline uint32_t _i2s_buffer_next(const i2s_buffer_t *b, uint32_t count)
+{
+  return count + 1 == 2 * b->num_frames ? 0 : count + 1;
+}
+
+inline uint32_t *_i2s_buffer_frame(const i2s_buffer_t *b, uint32_t count)
+{
+  size_t frame = count < b->num_frames ? count : count - b->num_frames;
+  return &b->frames[frame * b->frame_words];
+}
+
+// Copy the oldest frame out of the buffer, returning 0 if it is empty.
+inline int _i2s_buffer_read(i2s_buffer_t *b, uint32_t frame[])
+{
+  uint32_t read = b->read;
+  if (b->written == read) {
+    return 0;
+  }
+  const uint32_t *src = _i2s_buffer_frame(b, read);
+  for (size_t i = 0; i < b->frame_words; i++) {
+    frame[i] = src[i];
+  }
+  _I2S_BARRIER();
+  b->read = _i2s_buffer_next(b, read);
+  return 1;
+}
+
+// Copy a frame into the buffer, returning 0 if it is full.
+inline int _i2s_buffer_write(i2s_buffer_t *b, const uint32_t frame[])
+{
+  uint32_t written = b->written;
+  uint32_t read = b->read;
+  if (written - read == b->num_frames || read - written == b->num_frames) {
+    return 0;
+  }
+  uint32_t *dst = _i2s_buffer_frame(b, written);
+  for (size_t i = 0; i < b->frame_words; i++) {
+    dst[i] = frame[i];
+  }
+  _I2S_BARRIER();
+  b->written = _i2s_buffer_next(b, written);
+  return 1;
+}
+
+// Run the engine until it is stopped.
+extern void _i2s_run(i2s_t *i2s, i2s_buffer_t *tx, i2s_buffer_t *rx);  // Implemented in xcore_c_i2s.c
+
+#endif // !defined(__XC__)
+
+#endif // __xcore_c_i2s_impl_h__
@@ -1,7 +1,13 @@
 // Copyright (c) 2016, XMOS Ltd, All rights reserved
 
 #include "xcore_c_interrupt_impl.h"
+extern interrupt_state_t _interrupt_mask_all_save(void);
+extern void _interrupt_restore(interrupt_state_t state);
 
 #include "xcore_c_interrupt.h"
 extern xcore_c_error_t interrupt_mask_all(void);
 extern xcore_c_error_t interrupt_unmask_all(void);
+extern xcore_c_error_t interrupt_mask_all_save(interrupt_state_t *state);
+extern xcore_c_error_t interrupt_restore(interrupt_state_t state);
+extern xcore_c_error_t interrupt_mask_resource(resource_t r);
+extern xcore_c_error_t interrupt_unmask_resource(resource_t r);
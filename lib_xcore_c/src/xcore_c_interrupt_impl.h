@@ -7,19 +7,71 @@
 // The contents may vary between releases.
 
 #include "xcore_c_macros.h"
+#include "xcore_c_host_impl.h"
 #include "xcore_c_resource_impl.h"
+#include <xs1.h>
 
 // The user may define a larger kstack for their own worse case use.
 #ifndef XCORE_C_KSTACK_WORDS
 #define XCORE_C_KSTACK_WORDS 0
 #endif
 
+#if !defined(__XC__) || defined(__DOXYGEN__)
+
+/** The interrupt mask state of a logical core.
+ *
+ *  This is an opaque type returned by interrupt_mask_all_save() and
+ *  passed back to interrupt_restore().
+ *
+ *  Users must not access its raw underlying type.
+ */
+typedef uint32_t interrupt_state_t;
+
+inline interrupt_state_t _interrupt_mask_all_save(void)
+{
+#if XCORE_C_HOST
+  interrupt_state_t state = _host_getsr(XS1_SR_IEBLE_MASK);
+  _host_clrsr(XS1_SR_IEBLE_MASK);
+  return state;
+#else
+  interrupt_state_t state;
+  // getsr can only target r11.
+  asm volatile("getsr r11, " _XCORE_C_STR(XS1_SR_IEBLE_MASK) "\n"
+               "\tclrsr " _XCORE_C_STR(XS1_SR_IEBLE_MASK) "\n"
+               "\tadd %0, r11, 0"
+               : "=r" (state) : : /* clobbers */ "r11", "memory");
+  return state;
+#endif
+}
+
+inline void _interrupt_restore(interrupt_state_t state)
+{
+  if (state) {
+#if XCORE_C_HOST
+    _host_setsr(XS1_SR_IEBLE_MASK);
+#else
+    asm volatile("setsr " _XCORE_C_STR(XS1_SR_IEBLE_MASK) ::: "memory");
+#endif
+  }
+}
+
+#endif // !defined(__XC__)
+
+#if XCORE_C_HOST
+// The host backend has no kernel stack to set up, so root functions are
+// called directly rather than through a wrapper.
+#define _INTERRUPT_PERMITTED(root_function) root_function
+
+#define _DECLARE_INTERRUPT_PERMITTED(ret, root_function, ...) \
+    ret root_function(__VA_ARGS__)
+#else
 #define _INTERRUPT_PERMITTED(root_function) \
     _xcore_c_interrupt_permitted_ ## root_function
 
 #define _DECLARE_INTERRUPT_PERMITTED(ret, root_function, ...) \
     void _INTERRUPT_PERMITTED(root_function) (__VA_ARGS__);\
     ret root_function(__VA_ARGS__)
+#endif
 
 #define _DEFINE_INTERRUPT_PERMITTED_DEF(grp, root_function) \
     .weak  _fptrgroup.grp.nstackwords.group; \
@@ -50,9 +102,14 @@
     .globl _INTERRUPT_PERMITTED(root_function).maxchanends; \
     .size  _INTERRUPT_PERMITTED(root_function), . - _INTERRUPT_PERMITTED(root_function); \
 
+#if XCORE_C_HOST
+#define _DEFINE_INTERRUPT_PERMITTED(grp, ret, root_function, ...) \
+    _DECLARE_INTERRUPT_PERMITTED(ret, root_function, __VA_ARGS__)
+#else
 #define _DEFINE_INTERRUPT_PERMITTED(grp, ret, root_function, ...) \
     asm(_XCORE_C_STR(_DEFINE_INTERRUPT_PERMITTED_DEF(grp, root_function))); \
     _DECLARE_INTERRUPT_PERMITTED(ret, root_function, __VA_ARGS__)
+#endif
 
 
 #define _INTERRUPT_CALLBACK(intrpt) \
@@ -72,7 +129,7 @@
     .cc_top _INTERRUPT_CALLBACK(intrpt).function,_INTERRUPT_CALLBACK(intrpt); \
     _INTERRUPT_CALLBACK(intrpt):; \
       _XCORE_C_SINGLE_ISSUE /* Do we know what KEDI is set to? */; \
-      kentsp _XCORE_C_STACK_ALIGN(7); \
+      kentsp _XCORE_C_STACK_ALIGN(8); \
       stw r11, sp[5]; \
       stw r1, sp[3]; \
       ldap r11, intrpt; \
@@ -80,7 +137,7 @@
       ldap r11, _xcore_c_interrupt_callback_common; \
       bau r11; \
     .cc_bottom _INTERRUPT_CALLBACK(intrpt).function; \
-    .set   _INTERRUPT_CALLBACK(intrpt).nstackwords, _XCORE_C_STACK_ALIGN(7) + _xcore_c_interrupt_callback_common.nstackwords + intrpt.nstackwords; \
+    .set   _INTERRUPT_CALLBACK(intrpt).nstackwords, _XCORE_C_STACK_ALIGN(8) + _xcore_c_interrupt_callback_common.nstackwords + intrpt.nstackwords; \
     .globl _INTERRUPT_CALLBACK(intrpt).nstackwords; \
     .set   _INTERRUPT_CALLBACK(intrpt).maxcores, 1 $M _xcore_c_interrupt_callback_common.maxcores $M intrpt.maxcores; \
     .globl _INTERRUPT_CALLBACK(intrpt).maxcores; \
@@ -90,9 +147,40 @@
     .globl _INTERRUPT_CALLBACK(intrpt).maxchanends; \
     .size  _INTERRUPT_CALLBACK(intrpt), . - _INTERRUPT_CALLBACK(intrpt); \
 
+#if XCORE_C_HOST
+// The host backend calls the wrapper with the interrupt's data available from _host_get_ed().
+#define _DEFINE_INTERRUPT_CALLBACK_WRAPPER(grp, intrpt) \
+    void intrpt(void*); \
+    void _INTERRUPT_CALLBACK(intrpt)(void) \
+    { \
+      intrpt(_host_get_ed()); \
+    } \
+    void _INTERRUPT_CALLBACK(intrpt)(void)
+#else
+#define _DEFINE_INTERRUPT_CALLBACK_WRAPPER(grp, intrpt) \
+    asm(_XCORE_C_STR(_DEFINE_INTERRUPT_CALLBACK_DEF(grp, intrpt)))
+#endif
+
+#if XCORE_C_TRACE || XCORE_C_STATS
+// The user's body becomes a static function, called from an instrumented 'intrpt'.
+// The hooks are defined in xcore_c_trace_impl.h and xcore_c_stats_impl.h
 #define _DEFINE_INTERRUPT_CALLBACK(grp, intrpt, data) \
-    asm(_XCORE_C_STR(_DEFINE_INTERRUPT_CALLBACK_DEF(grp, intrpt))); \
+    _DEFINE_INTERRUPT_CALLBACK_WRAPPER(grp, intrpt); \
+    _DECLARE_INTERRUPT_CALLBACK(intrpt, data); \
+    static void _xcore_c_traced_ ## intrpt(void* data); \
+    void intrpt(void* data) \
+    { \
+      _XCORE_C_STATS_CALLBACK_ENTER(data, 0); \
+      _XCORE_C_TRACE(trace_interrupt_callback, data); \
+      _xcore_c_traced_ ## intrpt(data); \
+      _XCORE_C_STATS_CALLBACK_EXIT(0); \
+    } \
+    static void _xcore_c_traced_ ## intrpt(void* data)
+#else
+#define _DEFINE_INTERRUPT_CALLBACK(grp, intrpt, data) \
+    _DEFINE_INTERRUPT_CALLBACK_WRAPPER(grp, intrpt); \
     _DECLARE_INTERRUPT_CALLBACK(intrpt, data)
+#endif
 
 #endif // __xcore_c_interrupt_impl_h__
 
@@ -2,9 +2,44 @@
 
 #include "xcore_c_lock_impl.h"
 extern lock_t _lock_alloc(void);
+extern void _lock_acquire(lock_t l);
+extern void _lock_release(lock_t l);
+extern void _lock_pause(void);
+extern void _lock_pool_alloc(lock_pool_t *pool, swlock_slot_t slots[], size_t size);
+extern void _lock_pool_free(lock_pool_t *pool);
+extern swlock_t _swlock_alloc(lock_pool_t *pool);
+extern void _swlock_free(swlock_t l);
+extern void _swlock_acquire(swlock_t l);
+extern void _swlock_release(swlock_t l);
+extern void _rwlock_init(rwlock_t *rw, lock_t guard);
+extern void _rwlock_read_acquire(rwlock_t *rw);
+extern void _rwlock_read_release(rwlock_t *rw);
+extern void _rwlock_write_acquire(rwlock_t *rw);
+extern void _rwlock_write_release(rwlock_t *rw);
+extern void _seqlock_init(seqlock_t *s, lock_t guard);
+extern void _seqlock_write_begin(seqlock_t *s);
+extern void _seqlock_write_end(seqlock_t *s);
+extern uint32_t _seqlock_read_begin(seqlock_t *s);
+extern int _seqlock_read_retry(seqlock_t *s, uint32_t seq);
 
 #include "xcore_c_lock.h"
 extern xcore_c_error_t lock_alloc(lock_t *l);
 extern xcore_c_error_t lock_free(lock_t *l);
 extern xcore_c_error_t lock_acquire(lock_t l);
 extern xcore_c_error_t lock_release(lock_t l);
+extern xcore_c_error_t lock_pool_alloc(lock_pool_t *pool, swlock_slot_t slots[], size_t size);
+extern xcore_c_error_t lock_pool_free(lock_pool_t *pool);
+extern xcore_c_error_t swlock_alloc(lock_pool_t *pool, swlock_t *l);
+extern xcore_c_error_t swlock_free(swlock_t *l);
+extern xcore_c_error_t swlock_acquire(swlock_t l);
+extern xcore_c_error_t swlock_release(swlock_t l);
+extern xcore_c_error_t rwlock_init(rwlock_t *rw, lock_t guard);
+extern xcore_c_error_t rwlock_read_acquire(rwlock_t *rw);
+extern xcore_c_error_t rwlock_read_release(rwlock_t *rw);
+extern xcore_c_error_t rwlock_write_acquire(rwlock_t *rw);
+extern xcore_c_error_t rwlock_write_release(rwlock_t *rw);
+extern xcore_c_error_t seqlock_init(seqlock_t *s, lock_t guard);
+extern xcore_c_error_t seqlock_write_begin(seqlock_t *s);
+extern xcore_c_error_t seqlock_write_end(seqlock_t *s);
+extern xcore_c_error_t seqlock_read_begin(seqlock_t *s, uint32_t *seq);
+extern xcore_c_error_t seqlock_read_retry(seqlock_t *s, uint32_t seq, int *retry);
@@ -8,6 +8,7 @@
 
 #if !defined(__XC__) || defined(__DOXYGEN__)
 
+#include <stddef.h>
 #include "xcore_c_resource_impl.h"
 #include <xs1.h>
 
@@ -25,6 +26,270 @@ inline lock_t _lock_alloc(void)
   return l;
 }
 
+inline void _lock_acquire(lock_t l)
+{
+#if XCORE_C_HOST
+  _host_in(l);
+#else
+  unsigned dummy;
+  asm volatile("in %0, res[%1]" : "=r" (dummy): "r" (l) : "memory");
+#endif
+}
+
+inline void _lock_release(lock_t l)
+{
+#if XCORE_C_HOST
+  _host_out(l, l);
+#else
+  asm volatile("out res[%0], %0" :: "r" (l) : "memory");
+#endif
+}
+
+// Stop the compiler moving accesses to shared data across a software lock's
+// counters. The logical cores of a tile see memory in program order, but the
+// host backend's logical cores are threads on processors which may reorder.
+#if XCORE_C_HOST
+#define _LOCK_BARRIER() __sync_synchronize()
+#else
+#define _LOCK_BARRIER() asm volatile("" ::: "memory")
+#endif
+
+// Wait a little before looking at a software lock again.
+// The host backend's logical cores must let the virtual clock advance.
+inline void _lock_pause(void)
+{
+#if XCORE_C_HOST
+  _host_gettime();
+#endif
+}
+
+/** The storage for a software lock in a lock pool.
+ *
+ *  Users must not access its raw underlying type.
+ */
+typedef struct swlock_slot_t {
+#ifndef __DOXYGEN__
+  struct lock_pool_t *pool;    // The pool which allocated it, or NULL if free.
+  volatile uint32_t next;      // The ticket of the next core to acquire it.
+  volatile uint32_t serving;   // The ticket of the core which owns it.
+#endif // __DOXYGEN__
+} swlock_slot_t;
+
+/** A pool of software locks guarded by one hardware lock.
+ *
+ *  Users must not access its raw underlying type.
+ */
+typedef struct lock_pool_t {
+#ifndef __DOXYGEN__
+  lock_t guard;
+  swlock_slot_t *slots;
+  size_t size;
+#endif // __DOXYGEN__
+} lock_pool_t;
+
+/**
+ * swlock is an opaque type that denotes a software lock allocated from a lock pool.
+ *
+ *  Users must not access its raw underlying type.
+ */
+typedef swlock_slot_t *swlock_t;
+
+inline void _lock_pool_alloc(lock_pool_t *pool, swlock_slot_t slots[], size_t size)
+{
+  pool->guard = _lock_alloc();
+  pool->slots = slots;
+  pool->size = size;
+  for (size_t i = 0; i < size; i++) {
+    slots[i].pool = NULL;
+  }
+}
+
+inline void _lock_pool_free(lock_pool_t *pool)
+{
+  for (size_t i = 0; i < pool->size; i++) {
+    xassert(!pool->slots[i].pool && msg("Software lock not freed"));
+  }
+  if (pool->guard) {
+    _resource_free((resource_t)pool->guard);
+    pool->guard = 0;
+  }
+}
+
+inline swlock_t _swlock_alloc(lock_pool_t *pool)
+{
+  swlock_t l = NULL;
+  if (!pool->guard) {
+    return l;
+  }
+  _lock_acquire(pool->guard);
+  for (size_t i = 0; i < pool->size; i++) {
+    if (!pool->slots[i].pool) {
+      l = &pool->slots[i];
+      l->pool = pool;
+      l->next = 0;
+      l->serving = 0;
+      break;
+    }
+  }
+  _lock_release(pool->guard);
+  return l;
+}
+
+inline void _swlock_free(swlock_t l)
+{
+  xassert(l && msg("Software lock not allocated"));
+  xassert(l->next == l->serving && msg("Software lock not released"));
+  lock_t guard = l->pool->guard;
+  _lock_acquire(guard);
+  l->pool = NULL;
+  _lock_release(guard);
+}
+
+// The hardware lock makes taking a ticket atomic. The owner is the only core
+// to write 'serving', so releasing needs no lock. The cores waiting acquire
+// the lock in the order they took their tickets.
+inline void _swlock_acquire(swlock_t l)
+{
+  xassert(l && msg("Software lock not allocated"));
+  lock_t guard = l->pool->guard;
+  _lock_acquire(guard);
+  uint32_t ticket = l->next;
+  l->next = ticket + 1;
+  _lock_release(guard);
+  while (l->serving != ticket) {
+    _lock_pause();
+  }
+  _LOCK_BARRIER();
+}
+
+inline void _swlock_release(swlock_t l)
+{
+  xassert(l && msg("Software lock not allocated"));
+  _LOCK_BARRIER();
+  l->serving = l->serving + 1;
+}
+
+/** A reader-writer lock guarded by a hardware lock.
+ *
+ *  Users must not access its raw underlying type.
+ */
+typedef struct rwlock_t {
+#ifndef __DOXYGEN__
+  lock_t guard;
+  volatile uint32_t readers;    // The cores which own it for reading.
+  volatile uint32_t writer;     // Non-zero if a core owns it for writing.
+  volatile uint32_t waiting;    // The cores waiting to own it for writing.
+#endif // __DOXYGEN__
+} rwlock_t;
+
+inline void _rwlock_init(rwlock_t *rw, lock_t guard)
+{
+  rw->guard = guard;
+  rw->readers = 0;
+  rw->writer = 0;
+  rw->waiting = 0;
+}
+
+// Readers wait while a writer owns the lock or is waiting for it, so a stream
+// of readers can not starve the writers.
+inline void _rwlock_read_acquire(rwlock_t *rw)
+{
+  while (1) {
+    _lock_acquire(rw->guard);
+    if (!rw->writer && !rw->waiting) {
+      rw->readers = rw->readers + 1;
+      _lock_release(rw->guard);
+      break;
+    }
+    _lock_release(rw->guard);
+    _lock_pause();
+  }
+  _LOCK_BARRIER();
+}
+
+inline void _rwlock_read_release(rwlock_t *rw)
+{
+  _LOCK_BARRIER();
+  _lock_acquire(rw->guard);
+  rw->readers = rw->readers - 1;
+  _lock_release(rw->guard);
+}
+
+inline void _rwlock_write_acquire(rwlock_t *rw)
+{
+  _lock_acquire(rw->guard);
+  rw->waiting = rw->waiting + 1;
+  _lock_release(rw->guard);
+  while (1) {
+    _lock_acquire(rw->guard);
+    if (!rw->writer && !rw->readers) {
+      rw->writer = 1;
+      rw->waiting = rw->waiting - 1;
+      _lock_release(rw->guard);
+      break;
+    }
+    _lock_release(rw->guard);
+    _lock_pause();
+  }
+  _LOCK_BARRIER();
+}
+
+inline void _rwlock_write_release(rwlock_t *rw)
+{
+  _LOCK_BARRIER();
+  _lock_acquire(rw->guard);
+  rw->writer = 0;
+  _lock_release(rw->guard);
+}
+
+/** A sequence lock guarded by a hardware lock.
+ *
+ *  Users must not access its raw underlying type.
+ */
+typedef struct seqlock_t {
+#ifndef __DOXYGEN__
+  lock_t guard;
+  volatile uint32_t seq;        // Odd while a writer is updating the data.
+#endif // __DOXYGEN__
+} seqlock_t;
+
+inline void _seqlock_init(seqlock_t *s, lock_t guard)
+{
+  s->guard = guard;
+  s->seq = 0;
+}
+
+// The guard serialises the writers.
+inline void _seqlock_write_begin(seqlock_t *s)
+{
+  _lock_acquire(s->guard);
+  s->seq = s->seq + 1;
+  _LOCK_BARRIER();
+}
+
+inline void _seqlock_write_end(seqlock_t *s)
+{
+  _LOCK_BARRIER();
+  s->seq = s->seq + 1;
+  _lock_release(s->guard);
+}
+
+inline uint32_t _seqlock_read_begin(seqlock_t *s)
+{
+  uint32_t seq;
+  while ((seq = s->seq) & 1) {
+    _lock_pause();
+  }
+  _LOCK_BARRIER();
+  return seq;
+}
+
+inline int _seqlock_read_retry(seqlock_t *s, uint32_t seq)
+{
+  _LOCK_BARRIER();
+  return s->seq != seq;
+}
+
 #endif // !defined(__XC__)
 
 #endif // __xcore_c_lock_impl_h__
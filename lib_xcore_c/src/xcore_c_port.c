@@ -21,6 +21,7 @@ extern void _port_set_slave(port p);
 extern void _port_set_no_ready(port p);
 extern void _port_set_ready_strobed(port p);
 extern void _port_set_ready_handshake(port p);
+extern void _port_configure(port p, const port_config_t *config);
 extern int16_t _port_get_trigger_time(port p);
 extern void _port_set_trigger_time(port p, int16_t t);
 extern void _port_clear_trigger_time(port p);
@@ -32,6 +33,11 @@ extern void _port_out(port p, uint32_t data);
 extern uint32_t _port_in(port p);
 extern void _port_out_shift_right(port p, uint32_t *data);
 extern void _port_in_shift_right(port p, uint32_t *data);
+extern uint32_t _port_bitrev(uint32_t data);
+extern uint32_t _port_spread_4(uint32_t x);
+extern uint32_t _port_compact_4(uint32_t x);
+extern uint32_t _port_spread_8(uint32_t x);
+extern uint32_t _port_compact_8(uint32_t x);
 extern size_t _port_endin(port p);
 extern void _port_clear_buffer(port p);
 
@@ -56,6 +62,8 @@ extern xcore_c_error_t port_set_slave(port p);
 extern xcore_c_error_t port_set_no_ready(port p);
 extern xcore_c_error_t port_set_ready_strobed(port p);
 extern xcore_c_error_t port_set_ready_handshake(port p);
+extern xcore_c_error_t port_configure(port p, const port_config_t *config);
+extern xcore_c_error_t port_configure_group(const port p[], const port_config_t config[], size_t n);
 extern xcore_c_error_t port_get_trigger_time(port p, int16_t *ts);
 extern xcore_c_error_t port_set_trigger_time(port p, int16_t count);
 extern xcore_c_error_t port_clear_trigger_time(port p);
@@ -67,12 +75,25 @@ extern xcore_c_error_t port_out(port p, uint32_t data);
 extern xcore_c_error_t port_in(port p, uint32_t *data);
 extern xcore_c_error_t port_out_shift_right(port p, uint32_t *data);
 extern xcore_c_error_t port_in_shift_right(port p, uint32_t *data);
+extern xcore_c_error_t port_out_buf(port p, const uint32_t buf[], size_t n);
+extern xcore_c_error_t port_in_buf(port p, uint32_t buf[], size_t n);
+extern xcore_c_error_t port_out_buf_timestamped(port p, const uint32_t buf[], int16_t ts[], size_t n);
+extern xcore_c_error_t port_in_buf_timestamped(port p, uint32_t buf[], int16_t ts[], size_t n);
+extern xcore_c_error_t port_out_shift_right_buf(port p, uint32_t buf[], size_t n);
+extern xcore_c_error_t port_in_shift_right_buf(port p, uint32_t buf[], size_t n);
+extern xcore_c_error_t port_data_bitrev(uint32_t *data);
+extern xcore_c_error_t port_data_zip_4(const uint32_t lanes[4], uint32_t data[4]);
+extern xcore_c_error_t port_data_unzip_4(const uint32_t data[4], uint32_t lanes[4]);
+extern xcore_c_error_t port_data_zip_8(const uint32_t lanes[8], uint32_t data[8]);
+extern xcore_c_error_t port_data_unzip_8(const uint32_t data[8], uint32_t lanes[8]);
 extern xcore_c_error_t port_out_at_time(port p, int16_t t, uint32_t data);
 extern xcore_c_error_t port_in_at_time(port p, int16_t t, uint32_t *data);
 extern xcore_c_error_t port_out_shift_right_at_time(port p, int16_t t, uint32_t *data);
 extern xcore_c_error_t port_in_shift_right_at_time(port p, int16_t t, uint32_t *data);
+extern xcore_c_error_t port_out_buf_at_time(port p, const uint32_t buf[], const int16_t ts[], size_t n, size_t *missed);
 extern xcore_c_error_t port_in_when_pinseq(port p, port_type_t pt, uint32_t value, uint32_t *data);
 extern xcore_c_error_t port_in_when_pinsneq(port p, port_type_t pt, uint32_t value, uint32_t *data);
+extern xcore_c_error_t port_capture_edges(port p, uint32_t *value, port_edge_t buf[], size_t n);
 extern xcore_c_error_t port_in_shift_right_when_pinseq(port p, port_type_t pt, uint32_t value, uint32_t *data);
 extern xcore_c_error_t port_in_shift_right_when_pinsneq(port p, port_type_t pt, uint32_t value, uint32_t *data);
 extern xcore_c_error_t port_clear_buffer(port p);
@@ -91,3 +112,23 @@ extern xcore_c_error_t port_protocol_in_strobed_master(port p, port readyout, cl
 extern xcore_c_error_t port_protocol_out_strobed_master(port p, port readyout, clock clk, uint32_t initial);
 extern xcore_c_error_t port_protocol_in_strobed_slave(port p, port readyin, clock clk);
 extern xcore_c_error_t port_protocol_out_strobed_slave(port p, port readyin, clock clk, uint32_t initial);
+extern xcore_c_error_t port_protocol_group_setup(const port p[], size_t n, clock clk);
+extern xcore_c_error_t port_protocol_group_start(const port p[], const uint32_t data[], size_t n, clock clk);
+extern xcore_c_error_t port_protocol_group_start_at_time(const port p[], const uint32_t data[], size_t n, clock clk, int16_t t);
+
+#include "xcore_c_port_stream_impl.h"
+extern void _port_stream_out_buffer(streaming_chanend_t c, uint32_t *buf);
+extern uint32_t *_port_stream_in_buffer(streaming_chanend_t c);
+
+#include "xcore_c_port_stream.h"
+extern xcore_c_error_t port_stream_init(port_stream_t *s, port p, uint32_t buf[], size_t words, size_t num_bufs, streaming_chanend_t c);
+extern xcore_c_error_t port_stream_in(port_stream_t *s);
+extern xcore_c_error_t port_stream_stop(port_stream_t *s);
+extern xcore_c_error_t port_stream_get_buffer(streaming_chanend_t c, uint32_t **buf);
+
+#include "xcore_c_host.h"
+#if XCORE_C_HOST
+extern xcore_c_error_t host_port_connect(port from, port to);
+extern xcore_c_error_t host_port_stimulus(port p, const char *filename);
+extern xcore_c_error_t host_port_trace(port p, const char *filename);
+#endif
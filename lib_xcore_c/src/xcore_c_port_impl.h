@@ -24,15 +24,80 @@ typedef unsigned port;
 #endif
 #include <xs1.h>
 #include "xcore_c_resource_impl.h"
+#include "xcore_c_clock_impl.h"
+
+/** A pin change recorded by port_capture_edges().
+ *
+ *  time is the port timestamp at which the pins changed and value is the
+ *  new value of the pins. ref_time is the 32-bit reference time read as the
+ *  change was recorded, a few instructions after it happened. It places
+ *  changes which are 65536 or more port clock ticks apart, until it wraps
+ *  after 2^32 reference clock ticks (about 43 seconds at 100MHz).
+ */
+typedef struct port_edge_t {
+  uint32_t value;
+  uint32_t ref_time;
+  int16_t time;
+} port_edge_t;
+
+// The word fields come first, so only the end of each edge is padded.
+#ifdef __cplusplus
+static_assert(sizeof(port_edge_t) == 12, "port_edge_t is three words");
+#else
+_Static_assert(sizeof(port_edge_t) == 12, "port_edge_t is three words");
+#endif
+
+/** Flags selecting the settings applied by port_configure().
+ *
+ *  Each flag selects a setting which differs from the state of a newly
+ *  allocated port. The flags may be combined using bitwise or.
+ */
+typedef enum {
+  PORT_CONFIG_BUFFERED = 0x1,
+  PORT_CONFIG_INVERT = 0x2,
+  PORT_CONFIG_SAMPLE_FALLING_EDGE = 0x4,
+  PORT_CONFIG_READY_STROBED = 0x8,
+  PORT_CONFIG_READY_HANDSHAKE = 0x10,
+  PORT_CONFIG_SLAVE = 0x20,
+  PORT_CONFIG_OUT_CLOCK = 0x40,
+  PORT_CONFIG_OUT_READY = 0x80,
+} port_config_flags_t;
+
+/** A description of a port's configuration, applied by port_configure().
+ *
+ *  flags is a combination of port_config_flags_t values.
+ *  transfer_width is the transfer width of a buffered port, or 0 to leave it as
+ *  the width of the port.
+ *  clk is the clock block to clock the port from, or 0 to leave the port
+ *  clocked by the reference clock.
+ *  ready_source is the port whose ready signal is output when
+ *  PORT_CONFIG_OUT_READY is set.
+ *  ready_in is the 1-bit port read as the ready input of a port set to
+ *  PORT_CONFIG_READY_HANDSHAKE, or to PORT_CONFIG_READY_STROBED with
+ *  PORT_CONFIG_SLAVE. It is the ready source of the clock block clk, so it
+ *  needs clk to be set, and is 0 when there is no ready input.
+ */
+typedef struct port_config_t {
+  uint32_t flags;
+  size_t transfer_width;
+  clock clk;
+  port ready_source;
+  port ready_in;
+} port_config_t;
 
 inline void _port_set_transfer_width(port p, size_t width)
 {
+#if XCORE_C_HOST
+  _host_settw(p, width);
+#else
   asm volatile("settw res[%0], %1" :: "r" (p), "r" (width));
+#endif
 }
 
 inline port _port_alloc(unsigned id)
 {
   _RESOURCE_SETCI((resource_t)id, XS1_SETC_INUSE_ON);
+  _XCORE_C_TRACK_ALLOC(id, XS1_RES_TYPE_PORT);
   return id;
 }
 
@@ -43,6 +108,7 @@ inline void _port_reset(port p)
 
 inline void _port_free(port p)
 {
+  _XCORE_C_TRACK_FREE(p);
   _RESOURCE_SETCI(p, XS1_SETC_INUSE_OFF);
 }
 
@@ -58,7 +124,11 @@ inline void _port_set_unbuffered(port p)
 
 inline void _port_set_clock(port p, clock clk)
 {
+#if XCORE_C_HOST
+  _host_setclk(p, clk);
+#else
   asm volatile("setclk res[%0], %1" :: "r" (p), "r" (clk));
+#endif
 }
 
 inline void _port_set_inout_data(port p)
@@ -74,7 +144,11 @@ inline void _port_set_out_clock(port p)
 inline void _port_set_out_ready(port p, port ready_source)
 {
   _RESOURCE_SETCI(p, XS1_SETC_PORT_READYPORT);
+#if XCORE_C_HOST
+  _host_setrdy(p, ready_source);
+#else
   asm volatile("setrdy res[%0], %1" :: "r" (p), "r" (ready_source));
+#endif
 }
 
 inline void _port_set_invert(port p)
@@ -122,33 +196,96 @@ inline void _port_set_ready_handshake(port p)
   _RESOURCE_SETCI(p, XS1_SETC_RDY_HANDSHAKE);
 }
 
+// Apply each setting in the order required by the port, skipping those left
+// at their reset state: buffering and transfer width, then the clock (with its
+// ready input), then the rest. A constant configuration folds to just its
+// settings.
+inline void _port_configure(port p, const port_config_t *config)
+{
+  uint32_t flags = config->flags;
+  if (flags & PORT_CONFIG_BUFFERED) {
+    _port_set_buffered(p);
+    if (config->transfer_width) {
+      _port_set_transfer_width(p, config->transfer_width);
+    }
+  }
+  if (config->ready_in) {
+    xassert(config->clk && msg("A ready input needs a clock block"));
+    _clock_set_ready_src(config->clk, config->ready_in);
+  }
+  if (config->clk) {
+    _port_set_clock(p, config->clk);
+  }
+  if (flags & PORT_CONFIG_INVERT) {
+    _port_set_invert(p);
+  }
+  if (flags & PORT_CONFIG_SAMPLE_FALLING_EDGE) {
+    _port_set_sample_falling_edge(p);
+  }
+  if (flags & PORT_CONFIG_READY_STROBED) {
+    _port_set_ready_strobed(p);
+  }
+  if (flags & PORT_CONFIG_READY_HANDSHAKE) {
+    _port_set_ready_handshake(p);
+  }
+  if (flags & PORT_CONFIG_SLAVE) {
+    _port_set_slave(p);
+  }
+  if (flags & PORT_CONFIG_OUT_CLOCK) {
+    _port_set_out_clock(p);
+  }
+  if (flags & PORT_CONFIG_OUT_READY) {
+    _port_set_out_ready(p, config->ready_source);
+  }
+}
+
 inline int16_t _port_get_trigger_time(port p)
 {
   int16_t ts;
+#if XCORE_C_HOST
+  ts = _host_getts(p);
+#else
   asm volatile("getts %0, res[%1]" : "=r" (ts) : "r" (p));
+#endif
   return ts;
 }
 
 inline void _port_set_trigger_time(port p, int16_t t)
 {
+#if XCORE_C_HOST
+  _host_setpt(p, (uint16_t)t);
+#else
   asm volatile("setpt res[%0], %1" :: "r" (p), "r" (t));
+#endif
 }
 
 inline void _port_clear_trigger_time(port p)
 {
+#if XCORE_C_HOST
+  _host_clrpt(p);
+#else
   asm volatile("clrpt res[%0]" :: "r" (p));
+#endif
 }
 
 inline void _port_set_trigger_in_equal(port p, uint32_t d)
 {
   _RESOURCE_SETCI(p, XS1_SETC_COND_EQ);
+#if XCORE_C_HOST
+  _host_setd(p, d);
+#else
   asm volatile("setd res[%0], %1" :: "r" (p), "r" (d));
+#endif
 }
 
 inline void _port_set_trigger_in_not_equal(port p, uint32_t d)
 {
   _RESOURCE_SETCI(p, XS1_SETC_COND_NEQ);
+#if XCORE_C_HOST
+  _host_setd(p, d);
+#else
   asm volatile("setd res[%0], %1" :: "r" (p), "r" (d));
+#endif
 }
 
 inline void _port_clear_trigger_in(port p)
@@ -159,38 +296,109 @@ inline void _port_clear_trigger_in(port p)
 inline uint32_t _port_peek(port p)
 {
   uint32_t data;
+#if XCORE_C_HOST
+  data = _host_peek(p);
+#else
   asm volatile("peek %0, res[%1]" : "=r" (data): "r" (p));
+#endif
   return data;
 }
 
 inline void _port_out(port p, uint32_t data)
 {
+#if XCORE_C_HOST
+  _host_out(p, data);
+#else
   asm volatile("out res[%0], %1" :: "r" (p), "r" (data));
+#endif
 }
 
 inline uint32_t _port_in(port p)
 {
   uint32_t data;
+#if XCORE_C_HOST
+  data = _host_in(p);
+#else
   asm volatile("in %0, res[%1]" : "=r" (data): "r" (p));
+#endif
   return data;
 }
 
 inline void _port_out_shift_right(port p, uint32_t *data)
 {
   // We read-write data
+#if XCORE_C_HOST
+  *data = _host_outshr(p, *data);
+#else
   asm volatile("outshr res[%1], %0" : "+r" (*data) : "r" (p));
+#endif
 }
 
 inline void _port_in_shift_right(port p, uint32_t *data)
 {
   // We read-write data
+#if XCORE_C_HOST
+  *data = _host_inshr(p, *data);
+#else
   asm volatile("inshr %0, res[%1]" : "+r" (*data) : "r" (p));
+#endif
+}
+
+inline uint32_t _port_bitrev(uint32_t data)
+{
+#if XCORE_C_HOST
+  data = (data >> 16) | (data << 16);
+  data = ((data >> 8) & 0x00FF00FF) | ((data & 0x00FF00FF) << 8);
+  data = ((data >> 4) & 0x0F0F0F0F) | ((data & 0x0F0F0F0F) << 4);
+  data = ((data >> 2) & 0x33333333) | ((data & 0x33333333) << 2);
+  return ((data >> 1) & 0x55555555) | ((data & 0x55555555) << 1);
+#else
+  uint32_t rev;
+  asm("bitrev %0, %1" : "=r" (rev) : "r" (data));
+  return rev;
+#endif
+}
+
+// Move bit i of a byte to bit 4i.
+inline uint32_t _port_spread_4(uint32_t x)
+{
+  x = (x | x << 12) & 0x000F000F;
+  x = (x | x << 6) & 0x03030303;
+  return (x | x << 3) & 0x11111111;
+}
+
+// Move bit 4i to bit i of a byte.
+inline uint32_t _port_compact_4(uint32_t x)
+{
+  x &= 0x11111111;
+  x = (x | x >> 3) & 0x03030303;
+  x = (x | x >> 6) & 0x000F000F;
+  return (x | x >> 12) & 0xFF;
+}
+
+// Move bit i of a nibble to bit 8i.
+inline uint32_t _port_spread_8(uint32_t x)
+{
+  x = (x | x << 14) & 0x00030003;
+  return (x | x << 7) & 0x01010101;
+}
+
+// Move bit 8i to bit i of a nibble.
+inline uint32_t _port_compact_8(uint32_t x)
+{
+  x &= 0x01010101;
+  x = (x | x >> 7) & 0x00030003;
+  return (x | x >> 14) & 0xF;
 }
 
 inline size_t _port_endin(port p)
 {
   size_t num;
+#if XCORE_C_HOST
+  num = _host_endin(p);
+#else
   asm volatile("endin %0, res[%1]" : "=r" (num) : "r" (p));
+#endif
   return num;
 }
 
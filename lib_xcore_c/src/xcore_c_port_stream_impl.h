@@ -0,0 +1,58 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+
+#ifndef __xcore_c_port_stream_impl_h__
+#define __xcore_c_port_stream_impl_h__
+
+// This file contains private implementation details and is not part of the API.
+// The contents may vary between releases.
+
+#if !defined(__XC__) || defined(__DOXYGEN__)
+
+#include <stdint.h>
+#include <stddef.h>
+#include "xcore_c_port_impl.h"
+#include "xcore_c_chan_impl.h"
+
+/** An opaque type for streaming data from a buffered port into memory
+ *
+ *  Users must not access its raw underlying type.
+ */
+typedef struct port_stream_t {
+#ifndef __DOXYGEN__
+  port p;
+  uint32_t *buf;
+  size_t words;
+  size_t bufs;
+  streaming_chanend_t c;
+  volatile uint32_t stop;
+#endif // __DOXYGEN__
+} port_stream_t;
+
+// Input n words from port p into buf[].
+extern void _port_stream_fill(port p, uint32_t buf[], size_t n);  // Implemented in xcore_c_port_stream.S
+
+// Addresses may be wider than a channel word on the host, so send them as two.
+inline void _port_stream_out_buffer(streaming_chanend_t c, uint32_t *buf)
+{
+#if XCORE_C_HOST
+  _s_chan_out_word(c, (uint32_t)(uintptr_t)buf);
+  _s_chan_out_word(c, (uint32_t)((uint64_t)(uintptr_t)buf >> 32));
+#else
+  _s_chan_out_word(c, (uint32_t)buf);
+#endif
+}
+
+inline uint32_t *_port_stream_in_buffer(streaming_chanend_t c)
+{
+#if XCORE_C_HOST
+  uint64_t addr = _s_chan_in_word(c);
+  addr |= (uint64_t)_s_chan_in_word(c) << 32;
+  return (uint32_t*)(uintptr_t)addr;
+#else
+  return (uint32_t*)_s_chan_in_word(c);
+#endif
+}
+
+#endif // !defined(__XC__)
+
+#endif // __xcore_c_port_stream_impl_h__
@@ -1,6 +1,7 @@
 // Copyright (c) 2016, XMOS Ltd, All rights reserved
 
 #include "xcore_c_resource_impl.h"
+#include "xcore_c_stats_impl.h"
 extern void _resource_enable_trigger(resource_t r);
 extern void _resource_disable_trigger(resource_t r);
 extern void _resource_setup_interrupt_callback(resource_t r, void *data, interrupt_callback_t intrpt);
@@ -10,12 +11,19 @@ extern void _resource_free(resource_t r);
 
 void _resource_setup_callback(resource_t r, void *data, callback_function func, uint32_t type)
 {
-#if !defined(__XS2A__)
+#if !XCORE_C_HOST && !defined(__XS2A__)
   xassert( ((uint32_t)data >> 16) == 0x1 && msg("On XS1 bit 16 will always be set in the data returned from an event"));
 #endif
+  _XCORE_C_STATS_SETUP_EVENT(r, data);
+#if XCORE_C_HOST
+  _host_setv(r, func);
+  _host_setev(r, data);
+  _host_setc(r, type); // Raise interrupts or events
+#else
   asm volatile("add r11, %0, 0" : : "r" (func) : /* clobbers */ "r11");
   asm volatile("setv res[%0], r11" : : "r" (r));
   asm volatile("add r11, %0, 0" : : "r" (data) : /* clobbers */ "r11");
   asm volatile("setev res[%0], r11" : : "r" (r));
   asm volatile("setc res[%0], %1" : : "r" (r), "r" (type)); // Raise interrupts or events
+#endif
 }
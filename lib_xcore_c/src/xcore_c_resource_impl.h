@@ -11,6 +11,8 @@
 #include <stdint.h>
 #include "xassert.h"
 #include "xcore_c_macros.h"
+#include "xcore_c_host_impl.h"
+#include "xcore_c_track_impl.h"
 
 /** generic resource handle
  *
@@ -44,12 +46,20 @@ extern void _select_non_callback(void);  // Implemented in xcore_c_select.S
 
 inline void _resource_enable_trigger(resource_t r)
 {
+#if XCORE_C_HOST
+  _host_eeu(r);
+#else
   asm volatile("eeu res[%0]" :: "r" (r));
+#endif
 }
 
 inline void _resource_disable_trigger(resource_t r)
 {
+#if XCORE_C_HOST
+  _host_edu(r);
+#else
   asm volatile("edu res[%0]" :: "r" (r));
+#endif
 }
 
 extern void _resource_setup_callback(resource_t r, void *data, callback_function func, uint32_t type);
@@ -66,17 +76,44 @@ inline void _resource_setup_select_callback(resource_t r, void *data, select_cal
 
 inline void _resource_setup_select(resource_t r, uint32_t value)
 {
-  _resource_setup_select_callback(r, (void*)value, _select_non_callback);
+  _resource_setup_select_callback(r, (void*)(uintptr_t)value, _select_non_callback);
 }
 
-#define _RESOURCE_ALLOC(res, id) asm volatile( "getr %0, " _XCORE_C_STR(id) : "=r" (res))
+#if XCORE_C_HOST
+#define _RESOURCE_GETR(res, id) ((res) = _host_getr(id))
+#else
+#define _RESOURCE_GETR(res, id) asm volatile( "getr %0, " _XCORE_C_STR(id) : "=r" (res))
+#endif
+
+#define _RESOURCE_ALLOC(res, id) \
+  do { \
+    _RESOURCE_GETR(res, id); \
+    _XCORE_C_TRACK_ALLOC(res, id); \
+  } while (0)
+
+#if XCORE_C_STATS
+extern void _stats_free(resource_t r);  // Implemented in xcore_c_stats.c
+#define _XCORE_C_STATS_FREE(r) _stats_free(r)
+#else
+#define _XCORE_C_STATS_FREE(r) ((void)0)
+#endif
 
 inline void _resource_free(resource_t r)
 {
+  _XCORE_C_TRACK_FREE(r);
+  _XCORE_C_STATS_FREE(r);
+#if XCORE_C_HOST
+  _host_freer(r);
+#else
   asm volatile("freer res[%0]" :: "r" (r));
+#endif
 }
 
+#if XCORE_C_HOST
+#define _RESOURCE_SETCI(res, c) _host_setc((res), (c))
+#else
 #define _RESOURCE_SETCI(res, c) asm volatile( "setc res[%0], " _XCORE_C_STR(c) :: "r" (res))
+#endif
 
 #endif // !defined(__XC__)
 
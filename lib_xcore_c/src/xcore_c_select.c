@@ -1,4 +1,9 @@
 // Copyright (c) 2016, XMOS Ltd, All rights reserved
 
+#include "xcore_c_select_impl.h"
+extern void _select_wait_begin(void);
+extern uint32_t _select_wait_end(uint32_t enum_id);
+extern uint32_t _select_no_wait_end(uint32_t enum_id);
+
 #include "xcore_c_select.h"
 extern xcore_c_error_t select_disable_trigger_all(void);
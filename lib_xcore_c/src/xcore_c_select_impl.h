@@ -10,6 +10,8 @@
 
 #include "xcore_c_macros.h"
 #include "xcore_c_resource_impl.h"
+#include "xcore_c_trace_impl.h"
+#include "xcore_c_stats_impl.h"
 
 // _SELECT_CALLBACK_STACK_SIZE also defined in xcore_c_select.S
 #ifdef __XS2A__
@@ -48,9 +50,57 @@
     .globl _SELECT_CALLBACK(callback).maxchanends; \
     .size  _SELECT_CALLBACK(callback), . - _SELECT_CALLBACK(callback); \
 
+#if XCORE_C_HOST
+// The host backend calls the wrapper with the event's data available from _host_get_ed().
+#define _DEFINE_SELECT_CALLBACK_WRAPPER(callback) \
+    void callback(void*); \
+    void _SELECT_CALLBACK(callback)(void) \
+    { \
+      callback(_host_get_ed()); \
+    } \
+    void _SELECT_CALLBACK(callback)(void)
+#else
+#define _DEFINE_SELECT_CALLBACK_WRAPPER(callback) \
+    asm(_XCORE_C_STR(_DEFINE_SELECT_CALLBACK_DEF(callback)))
+#endif
+
+#if XCORE_C_TRACE || XCORE_C_STATS
+// The user's body becomes a static function, called from an instrumented 'callback'.
+#define _DEFINE_SELECT_CALLBACK(callback, data) \
+    _DEFINE_SELECT_CALLBACK_WRAPPER(callback); \
+    _DECLARE_SELECT_CALLBACK(callback, data); \
+    static void _xcore_c_traced_ ## callback(void* data); \
+    void callback(void* data) \
+    { \
+      _XCORE_C_STATS_CALLBACK_ENTER(data, 1); \
+      _XCORE_C_TRACE(trace_select_callback, data); \
+      _xcore_c_traced_ ## callback(data); \
+      _XCORE_C_STATS_CALLBACK_EXIT(1); \
+    } \
+    static void _xcore_c_traced_ ## callback(void* data)
+#else
 #define _DEFINE_SELECT_CALLBACK(callback, data) \
-    asm(_XCORE_C_STR(_DEFINE_SELECT_CALLBACK_DEF(callback))); \
+    _DEFINE_SELECT_CALLBACK_WRAPPER(callback); \
     _DECLARE_SELECT_CALLBACK(callback, data)
+#endif
+
+inline void _select_wait_begin(void)
+{
+  _XCORE_C_TRACE(trace_select_wait, 0);
+  _XCORE_C_STATS_WAIT_BEGIN();
+}
+
+inline uint32_t _select_wait_end(uint32_t enum_id)
+{
+  _XCORE_C_STATS_WAIT_END(enum_id);
+  _XCORE_C_TRACE(trace_select_event, enum_id);
+  return enum_id;
+}
+
+inline uint32_t _select_no_wait_end(uint32_t enum_id)
+{
+  return _XCORE_C_STATS_NO_WAIT_END(enum_id);
+}
 
 #endif // !defined(__XC__)
 
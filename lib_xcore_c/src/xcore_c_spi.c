@@ -0,0 +1,75 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+
+#include "xcore_c_spi_impl.h"
+extern void _spi_configure_port(port p, clock clk);
+
+// Ports shift least significant bit first, so reverse each value.
+static uint32_t _spi_out_value(const void *out, size_t i, size_t bits)
+{
+  if (!out) {
+    return 0xFFFFFFFF;
+  }
+  if (bits == 8) {
+    return _port_bitrev(((const uint8_t*)out)[i]) >> 24;
+  }
+  return _port_bitrev(((const uint32_t*)out)[i]);
+}
+
+static void _spi_in_value(void *in, size_t i, size_t bits, uint32_t data)
+{
+  if (!in) {
+    return;
+  }
+  if (bits == 8) {
+    ((uint8_t*)in)[i] = _port_bitrev(data) >> 24;
+  }
+  else {
+    ((uint32_t*)in)[i] = _port_bitrev(data);
+  }
+}
+
+void _spi_transfer(port p_sclk, port p_out, port p_in,
+                   const void *out, void *in, size_t n, size_t bits)
+{
+  // Each bit takes two ticks of the clock port, so each value takes two clock
+  // port transfers of the same width as the data port transfers.
+  _port_set_transfer_width(p_out, bits);
+  _port_set_transfer_width(p_in, bits);
+  _port_clear_buffer(p_out);
+  _port_clear_buffer(p_in);
+  if (p_sclk) {
+    _port_set_transfer_width(p_sclk, bits);
+  }
+
+  if (n) {
+    _port_out(p_out, _spi_out_value(out, 0, bits));
+    if (p_sclk) {
+      _port_out(p_sclk, _SPI_SCLK_PATTERN);
+      _port_out(p_sclk, _SPI_SCLK_PATTERN);
+    }
+  }
+
+  // Keep the next value and the start of its clock queued while waiting for
+  // the current value, so that the bit clock runs without gaps.
+  for (size_t i = 0; i < n; i++) {
+    int more = i + 1 < n;
+    if (more) {
+      _port_out(p_out, _spi_out_value(out, i + 1, bits));
+      if (p_sclk) {
+        _port_out(p_sclk, _SPI_SCLK_PATTERN);
+      }
+    }
+    _spi_in_value(in, i, bits, _port_in(p_in));
+    if (more && p_sclk) {
+      _port_out(p_sclk, _SPI_SCLK_PATTERN);
+    }
+  }
+}
+
+#include "xcore_c_spi.h"
+extern xcore_c_error_t spi_master_init(spi_master_t *spi, clock clk_sclk, clock clk_data, port p_sclk, port p_mosi, port p_miso);
+extern xcore_c_error_t spi_master_transfer_words(const spi_master_t *spi, const uint32_t out[], uint32_t in[], size_t n);
+extern xcore_c_error_t spi_master_transfer_bytes(const spi_master_t *spi, const uint8_t out[], uint8_t in[], size_t n);
+extern xcore_c_error_t spi_slave_init(spi_slave_t *spi, clock clk, port p_sclk, port p_mosi, port p_miso);
+extern xcore_c_error_t spi_slave_transfer_words(const spi_slave_t *spi, const uint32_t out[], uint32_t in[], size_t n);
+extern xcore_c_error_t spi_slave_transfer_bytes(const spi_slave_t *spi, const uint8_t out[], uint8_t in[], size_t n);
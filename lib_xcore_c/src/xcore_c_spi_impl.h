@@ -0,0 +1,58 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+
+#ifndef __xcore_c_spi_impl_h__
+#define __xcore_c_spi_impl_h__
+
+// This file contains private implementation details and is not part of the API.
+// The contents may vary between releases.
+
+#if !defined(__XC__) || defined(__DOXYGEN__)
+
+#include <stdint.h>
+#include <stddef.h>
+#include "xcore_c_port_impl.h"
+#include "xcore_c_clock_impl.h"
+
+/** An opaque type for an SPI master.
+ *
+ *  Users must not access its raw underlying type.
+ */
+typedef struct spi_master_t {
+#ifndef __DOXYGEN__
+  port p_sclk;
+  port p_mosi;
+  port p_miso;
+#endif // __DOXYGEN__
+} spi_master_t;
+
+/** An opaque type for an SPI slave.
+ *
+ *  Users must not access its raw underlying type.
+ */
+typedef struct spi_slave_t {
+#ifndef __DOXYGEN__
+  port p_miso;
+  port p_mosi;
+#endif // __DOXYGEN__
+} spi_slave_t;
+
+// Each bit clock period is two ticks of the clock port: low, then high.
+#define _SPI_SCLK_PATTERN 0xAAAAAAAA
+#define _SPI_SCLK_IDLE 0xFFFFFFFF
+
+inline void _spi_configure_port(port p, clock clk)
+{
+  _port_set_buffered(p);
+  _port_set_transfer_width(p, 32);
+  _port_set_clock(p, clk);
+}
+
+// Transfer n words (bits == 32) or bytes (bits == 8), most significant bit first.
+// A master passes its clock port, which is 0 for a slave.
+// Implemented in xcore_c_spi.c
+extern void _spi_transfer(port p_sclk, port p_out, port p_in,
+                          const void *out, void *in, size_t n, size_t bits);
+
+#endif // !defined(__XC__)
+
+#endif // __xcore_c_spi_impl_h__
@@ -0,0 +1,37 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+
+#include "xcore_c_stats_impl.h"
+extern unsigned _stats_core_id(void);
+extern stats_table_t *_stats_core_table(void);
+extern stats_entry_t *_stats_find(stats_table_t *t, resource_t r);
+extern void *_stats_setup_event(resource_t r, void *data);
+extern stats_slot_t *_stats_slot(uint32_t ed);
+extern void *_stats_event(void *ed, uint32_t blocked);
+extern void _stats_wait_begin(void);
+extern uint32_t _stats_wait_end(uint32_t enum_id);
+extern uint32_t _stats_callback_enter(void **data, int select);
+extern void _stats_callback_exit(uint32_t enter, int select);
+extern void _stats_transfer(resource_t r, uint32_t n, uint32_t start);
+
+stats_table_t *_xcore_c_stats_tables[_XCORE_C_STATS_MAX_CORES];
+stats_slot_t _xcore_c_stats_slots[_XCORE_C_STATS_MAX_CORES][XCORE_C_STATS_RESOURCES];
+
+// A freed resource's slots may be used by other resources. It may be freed by
+// any logical core, so the slots of every core are searched.
+void _stats_free(resource_t r)
+{
+  for (uint32_t i = 0; i < _XCORE_C_STATS_MAX_CORES; i++) {
+    for (uint32_t j = 0; j < XCORE_C_STATS_RESOURCES; j++) {
+      if (_xcore_c_stats_slots[i][j].resource == r) {
+        _xcore_c_stats_slots[i][j].resource = 0;
+      }
+    }
+  }
+}
+
+#include "xcore_c_stats.h"
+extern xcore_c_error_t stats_start(stats_table_t *t);
+extern xcore_c_error_t stats_stop(void);
+extern xcore_c_error_t stats_get_count(const stats_table_t *t, size_t *count, size_t *untracked);
+extern xcore_c_error_t stats_get_entry(const stats_table_t *t, size_t n, stats_entry_t *entry);
+extern xcore_c_error_t stats_get_resource(const stats_table_t *t, resource_t r, stats_entry_t *entry);
@@ -0,0 +1,264 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+
+#ifndef __xcore_c_stats_impl_h__
+#define __xcore_c_stats_impl_h__
+
+// This file contains private implementation details and is not part of the API.
+// The contents may vary between releases.
+
+// The user may enable statistics and change the table size in their Makefile.
+#ifndef XCORE_C_STATS
+#define XCORE_C_STATS 0
+#endif
+
+#ifndef XCORE_C_STATS_RESOURCES
+#define XCORE_C_STATS_RESOURCES 16
+#endif
+
+// The number of logical cores on a tile.
+#define _XCORE_C_STATS_MAX_CORES 8
+
+#if !defined(__XC__) || defined(__DOXYGEN__)
+
+#include <stdint.h>
+#include "xcore_c_resource_impl.h"
+#include "xcore_c_hwtimer_impl.h"
+#include "xcore_c_interrupt_impl.h"
+
+/** The usage statistics of a resource on one logical core.
+ *
+ *  events is the number of select events, select callbacks and interrupt
+ *  callbacks taken from the resource.
+ *  transfers is the number of words (or bytes) transferred over a chan-end,
+ *  or the number of transfers made on a port.
+ *  blocked is the number of reference clock ticks spent in transfers plus the
+ *  ticks spent in select_wait() until the resource's select event fired, not
+ *  counting the time spent handling other events and interrupts.
+ */
+typedef struct stats_entry_t {
+  resource_t resource;
+  uint32_t events;
+  uint32_t transfers;
+  uint32_t blocked;
+} stats_entry_t;
+
+/** A per logical core table of resource usage statistics.
+ *
+ *  Users must not access its raw underlying type.
+ */
+typedef struct stats_table_t {
+#ifndef __DOXYGEN__
+  uint32_t count;
+  uint32_t last;
+  uint32_t untracked;
+  uint32_t waiting;
+  uint32_t wait_start;
+  stats_entry_t entry[XCORE_C_STATS_RESOURCES];
+#endif // __DOXYGEN__
+} stats_table_t;
+
+extern stats_table_t *_xcore_c_stats_tables[_XCORE_C_STATS_MAX_CORES];
+
+inline unsigned _stats_core_id(void)
+{
+#if XCORE_C_HOST
+  return _host_get_id();
+#else
+  unsigned id;
+  asm volatile("get r11, id\n"
+               "\tadd %0, r11, 0"
+               : "=r" (id) : : /* clobbers */ "r11");
+  return id;
+#endif
+}
+
+inline stats_table_t *_stats_core_table(void)
+{
+  return _xcore_c_stats_tables[_stats_core_id()];
+}
+
+// Returns the resource's entry, adding it if there is room, else null.
+inline stats_entry_t *_stats_find(stats_table_t *t, resource_t r)
+{
+  if (t->count && t->entry[t->last].resource == r) {
+    return &t->entry[t->last];
+  }
+  for (uint32_t i = 0; i < t->count; i++) {
+    if (t->entry[i].resource == r) {
+      t->last = i;
+      return &t->entry[i];
+    }
+  }
+  if (t->count == XCORE_C_STATS_RESOURCES) {
+    t->untracked++;
+    return 0;
+  }
+  stats_entry_t *e = &t->entry[t->count];
+  e->resource = r;
+  e->events = 0;
+  e->transfers = 0;
+  e->blocked = 0;
+  t->last = t->count++;
+  return e;
+}
+
+// With statistics enabled, the environment vector of each event set up by the
+// library is one of these slots rather than the user's data, so that an event
+// is counted against the resource it came from even if several resources
+// share their data. The slot is translated back before the data reaches the
+// user.
+typedef struct stats_slot_t {
+  resource_t resource;
+  void *data;
+} stats_slot_t;
+
+extern stats_slot_t _xcore_c_stats_slots[_XCORE_C_STATS_MAX_CORES][XCORE_C_STATS_RESOURCES];
+
+// Returns the environment vector to set up the resource's event with.
+inline void *_stats_setup_event(resource_t r, void *data)
+{
+  stats_slot_t *slots = _xcore_c_stats_slots[_stats_core_id()];
+  stats_slot_t *s = 0;
+  interrupt_state_t state = _interrupt_mask_all_save();
+  for (uint32_t i = 0; i < XCORE_C_STATS_RESOURCES; i++) {
+    if (slots[i].resource == r) {
+      s = &slots[i];
+      break;
+    }
+    if (!s && !slots[i].resource) {
+      s = &slots[i];
+    }
+  }
+  if (s) {
+    s->resource = r;
+    s->data = data;
+    data = s;
+  }
+  stats_table_t *t = _stats_core_table();
+  if (t) {
+    _stats_find(t, r);
+  }
+  _interrupt_restore(state);
+  return data;
+}
+
+// Returns the slot of an environment vector, or null if it is not one. Only
+// the low 32 bits are compared, as select_wait() returns an enum_id.
+inline stats_slot_t *_stats_slot(uint32_t ed)
+{
+  uint32_t offset = ed - (uint32_t)(uintptr_t)_xcore_c_stats_slots;
+  if (offset >= sizeof(_xcore_c_stats_slots) || offset % sizeof(stats_slot_t)) {
+    return 0;
+  }
+  return &_xcore_c_stats_slots[0][0] + offset / sizeof(stats_slot_t);
+}
+
+// Count an event with environment vector 'ed', which spent 'blocked' ticks
+// waiting, against its resource. Returns the user's data.
+inline void *_stats_event(void *ed, uint32_t blocked)
+{
+  stats_slot_t *s = _stats_slot((uint32_t)(uintptr_t)ed);
+  if (!s) {
+    return ed;
+  }
+  stats_table_t *t = _stats_core_table();
+  if (t) {
+    interrupt_state_t state = _interrupt_mask_all_save();
+    stats_entry_t *e = _stats_find(t, s->resource);
+    if (e) {
+      e->events++;
+      e->blocked += blocked;
+    }
+    _interrupt_restore(state);
+  }
+  return s->data;
+}
+
+inline void _stats_wait_begin(void)
+{
+  stats_table_t *t = _stats_core_table();
+  if (t) {
+    t->waiting = 1;
+    t->wait_start = _hwtimer_core_get_time();
+  }
+}
+
+// The event which ended the wait fired just before select_wait() returned.
+inline uint32_t _stats_wait_end(uint32_t enum_id)
+{
+  stats_table_t *t = _stats_core_table();
+  uint32_t blocked = 0;
+  if (t && t->waiting) {
+    blocked = _hwtimer_core_get_time() - t->wait_start;
+    t->waiting = 0;
+  }
+  return (uint32_t)(uintptr_t)_stats_event((void*)(uintptr_t)enum_id, blocked);
+}
+
+// A select callback is taken while waiting, so the time waited so far is
+// counted against its resource. Returns the time the callback was entered.
+inline uint32_t _stats_callback_enter(void **data, int select)
+{
+  uint32_t now = _hwtimer_core_get_time();
+  stats_table_t *t = _stats_core_table();
+  uint32_t blocked = (select && t && t->waiting) ? now - t->wait_start : 0;
+  *data = _stats_event(*data, blocked);
+  return now;
+}
+
+// The time spent in a callback is not spent waiting. After a select callback
+// the wait for the next event starts afresh.
+inline void _stats_callback_exit(uint32_t enter, int select)
+{
+  stats_table_t *t = _stats_core_table();
+  if (t && t->waiting) {
+    interrupt_state_t state = _interrupt_mask_all_save();
+    uint32_t now = _hwtimer_core_get_time();
+    t->wait_start = select ? now : t->wait_start + (now - enter);
+    _interrupt_restore(state);
+  }
+}
+
+inline void _stats_transfer(resource_t r, uint32_t n, uint32_t start)
+{
+  stats_table_t *t = _stats_core_table();
+  if (t) {
+    uint32_t now = _hwtimer_core_get_time();
+    interrupt_state_t state = _interrupt_mask_all_save();
+    stats_entry_t *e = _stats_find(t, r);
+    if (e) {
+      e->transfers += n;
+      e->blocked += now - start;
+    }
+    _interrupt_restore(state);
+  }
+}
+
+#if XCORE_C_STATS
+#define _XCORE_C_STATS_TRANSFER(r, n, expr) \
+  do { \
+    uint32_t _stats_start = _hwtimer_core_get_time(); \
+    expr; \
+    _stats_transfer((resource_t)(r), (n), _stats_start); \
+  } while (0)
+#define _XCORE_C_STATS_SETUP_EVENT(r, data) ((data) = _stats_setup_event((r), (data)))
+#define _XCORE_C_STATS_CALLBACK_ENTER(data, select) \
+  uint32_t _stats_enter = _stats_callback_enter(&(data), (select))
+#define _XCORE_C_STATS_CALLBACK_EXIT(select) _stats_callback_exit(_stats_enter, (select))
+#define _XCORE_C_STATS_WAIT_BEGIN() _stats_wait_begin()
+#define _XCORE_C_STATS_WAIT_END(enum_id) ((enum_id) = _stats_wait_end(enum_id))
+#define _XCORE_C_STATS_NO_WAIT_END(enum_id) \
+  ((uint32_t)(uintptr_t)_stats_event((void*)(uintptr_t)(enum_id), 0))
+#else
+#define _XCORE_C_STATS_TRANSFER(r, n, expr) expr
+#define _XCORE_C_STATS_SETUP_EVENT(r, data) ((void)0)
+#define _XCORE_C_STATS_CALLBACK_ENTER(data, select) ((void)0)
+#define _XCORE_C_STATS_CALLBACK_EXIT(select) ((void)0)
+#define _XCORE_C_STATS_WAIT_BEGIN() ((void)0)
+#define _XCORE_C_STATS_WAIT_END(enum_id) ((void)(enum_id))
+#define _XCORE_C_STATS_NO_WAIT_END(enum_id) (enum_id)
+#endif
+
+#endif // !defined(__XC__)
+
+#endif // __xcore_c_stats_impl_h__
@@ -0,0 +1,14 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+
+#include "xcore_c_trace_impl.h"
+extern unsigned _trace_core_id(void);
+extern void _trace_record(uint32_t event, uint32_t arg);
+
+trace_buffer_t *_xcore_c_trace_buffers[_XCORE_C_TRACE_MAX_CORES];
+
+#include "xcore_c_trace.h"
+extern xcore_c_error_t trace_start(trace_buffer_t *buf);
+extern xcore_c_error_t trace_stop(void);
+extern xcore_c_error_t trace_record(uint32_t event, uint32_t arg);
+extern xcore_c_error_t trace_get_count(const trace_buffer_t *buf, size_t *count, size_t *lost);
+extern xcore_c_error_t trace_get_entry(const trace_buffer_t *buf, size_t n, trace_entry_t *entry);
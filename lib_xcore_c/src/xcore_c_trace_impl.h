@@ -0,0 +1,125 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+
+#ifndef __xcore_c_trace_impl_h__
+#define __xcore_c_trace_impl_h__
+
+// This file contains private implementation details and is not part of the API.
+// The contents may vary between releases.
+
+// The user may enable tracing and change the trace buffer size in their Makefile.
+#ifndef XCORE_C_TRACE
+#define XCORE_C_TRACE 0
+#endif
+
+#ifndef XCORE_C_TRACE_ENTRIES
+#define XCORE_C_TRACE_ENTRIES 64
+#endif
+
+#if (XCORE_C_TRACE_ENTRIES & (XCORE_C_TRACE_ENTRIES - 1)) != 0
+#error XCORE_C_TRACE_ENTRIES must be a power of two
+#endif
+
+// The number of logical cores on a tile.
+#define _XCORE_C_TRACE_MAX_CORES 8
+
+// 'XCTR' when read as bytes from a little endian dump.
+#define _XCORE_C_TRACE_MAGIC 0x52544358
+
+#if !defined(__XC__) || defined(__DOXYGEN__)
+
+#include <stdint.h>
+#include "xcore_c_hwtimer_impl.h"
+#include "xcore_c_interrupt_impl.h"
+
+/** The identifiers of the events recorded in the trace buffer.
+ *
+ *  The arg recorded with each library event is:
+ *    - trace_select_wait: 0, recorded when select_wait() or select_wait_ordered() is called
+ *    - trace_select_event: the enum_id returned by select_wait() or select_wait_ordered()
+ *    - trace_select_callback, trace_interrupt_callback: the callback's data
+ *    - trace_chan_out, trace_chan_in: the chan-end, recorded when a transfer starts
+ *    - trace_port_out, trace_port_in: the port, recorded when a transfer starts
+ *
+ *  Identifiers from trace_user upwards are free for use by the application
+ *  with trace_record().
+ */
+typedef enum {
+  trace_none = 0,
+  trace_select_wait,
+  trace_select_event,
+  trace_select_callback,
+  trace_interrupt_callback,
+  trace_chan_out,
+  trace_chan_in,
+  trace_port_out,
+  trace_port_in,
+  trace_user = 0x100,
+} trace_event_t;
+
+/** A single record in the trace buffer.
+ *
+ *  The time is the reference clock time (100MHz ticks) at which the event
+ *  was recorded; event is a trace_event_t or an application identifier.
+ */
+typedef struct trace_entry_t {
+  uint32_t time;
+  uint32_t event;
+  uint32_t arg;
+} trace_entry_t;
+
+/** A per logical core trace buffer.
+ *
+ *  The buffer is a ring which holds the most recent XCORE_C_TRACE_ENTRIES
+ *  records. Its memory layout may be dumped as is and decoded on the host.
+ *
+ *  Users must not access its raw underlying type.
+ */
+typedef struct trace_buffer_t {
+#ifndef __DOXYGEN__
+  uint32_t magic;
+  uint32_t core_id;
+  uint32_t size;
+  uint32_t count;
+  trace_entry_t entry[XCORE_C_TRACE_ENTRIES];
+#endif // __DOXYGEN__
+} trace_buffer_t;
+
+extern trace_buffer_t *_xcore_c_trace_buffers[_XCORE_C_TRACE_MAX_CORES];
+
+inline unsigned _trace_core_id(void)
+{
+#if XCORE_C_HOST
+  return _host_get_id();
+#else
+  unsigned id;
+  asm volatile("get r11, id\n"
+               "\tadd %0, r11, 0"
+               : "=r" (id) : : /* clobbers */ "r11");
+  return id;
+#endif
+}
+
+inline void _trace_record(uint32_t event, uint32_t arg)
+{
+  trace_buffer_t *buf = _xcore_c_trace_buffers[_trace_core_id()];
+  if (buf) {
+    // The record may be made from an interrupt_callback_t on this core.
+    interrupt_state_t state = _interrupt_mask_all_save();
+    trace_entry_t *e = &buf->entry[buf->count & (XCORE_C_TRACE_ENTRIES - 1)];
+    buf->count++;
+    e->time = _hwtimer_core_get_time();
+    e->event = event;
+    e->arg = arg;
+    _interrupt_restore(state);
+  }
+}
+
+#if XCORE_C_TRACE
+#define _XCORE_C_TRACE(event, arg) _trace_record((event), (uint32_t)(uintptr_t)(arg))
+#else
+#define _XCORE_C_TRACE(event, arg) ((void)(event), (void)(arg))
+#endif
+
+#endif // !defined(__XC__)
+
+#endif // __xcore_c_trace_impl_h__
@@ -0,0 +1,112 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+
+#include "xcore_c_track_impl.h"
+#include "xcore_c_interrupt_impl.h"
+#include "xcore_c_lock_impl.h"
+extern int _track_slot(uint32_t r);
+extern void _track_alloc(uint32_t r, uint32_t type);
+extern void _track_free(uint32_t r);
+extern void _track_use(uint32_t r);
+
+uint8_t _xcore_c_track_state[_XCORE_C_TRACK_SLOTS];
+uint32_t _xcore_c_track_node;
+uint32_t _xcore_c_track_exhausted[_XCORE_C_TRACK_MAX_CORES][_XCORE_C_TRACK_TYPES];
+_xcore_c_track_fault_t _xcore_c_track_faults[_XCORE_C_TRACK_MAX_CORES];
+
+// The tracker's lock is Lamport's bakery algorithm, as a hardware lock would
+// be one of the resources being tracked. Each logical core waits for those
+// holding a smaller ticket, or the same ticket and a smaller core id.
+static volatile uint8_t _track_choosing[_XCORE_C_TRACK_MAX_CORES];
+static volatile uint32_t _track_tickets[_XCORE_C_TRACK_MAX_CORES];
+
+static void _track_lock(unsigned self)
+{
+  _track_choosing[self] = 1;
+  _LOCK_BARRIER();
+  uint32_t ticket = 0;
+  for (unsigned i = 0; i < _XCORE_C_TRACK_MAX_CORES; i++) {
+    if (_track_tickets[i] > ticket) {
+      ticket = _track_tickets[i];
+    }
+  }
+  ticket++;
+  _track_tickets[self] = ticket;
+  _LOCK_BARRIER();
+  _track_choosing[self] = 0;
+  _LOCK_BARRIER();
+  for (unsigned i = 0; i < _XCORE_C_TRACK_MAX_CORES; i++) {
+    if (i == self) {
+      continue;
+    }
+    while (_track_choosing[i]) {
+      _lock_pause();
+    }
+    _LOCK_BARRIER();
+    for (;;) {
+      uint32_t other = _track_tickets[i];
+      if (!other || other > ticket || (other == ticket && i > self)) {
+        break;
+      }
+      _lock_pause();
+    }
+  }
+  _LOCK_BARRIER();
+}
+
+static void _track_unlock(unsigned self)
+{
+  _LOCK_BARRIER();
+  _track_tickets[self] = 0;
+}
+
+void _track_fault(track_fault_t fault, uint32_t r)
+{
+  _xcore_c_track_fault_t *f = &_xcore_c_track_faults[_error_core_id()];
+  f->fault = fault;
+  f->resource = r;
+#if XCORE_C_HOST
+  _host_throw(XS1_ET_ECALL, r);
+#else
+  asm volatile("ecallt %0" :: "r" (1));
+#endif
+}
+
+void _track_release(int slot, uint32_t r)
+{
+  // An interrupt handler freeing a resource must not wait on its own core.
+  interrupt_state_t state = _interrupt_mask_all_save();
+  unsigned self = _error_core_id();
+  _track_lock(self);
+  int freed = _xcore_c_track_state[slot] == _XCORE_C_TRACK_FREED;
+  _xcore_c_track_state[slot] = _XCORE_C_TRACK_FREED;
+  _track_unlock(self);
+  _interrupt_restore(state);
+  if (freed) {
+    _track_fault(track_fault_double_free, r);
+  }
+}
+
+uint32_t _track_resource(int slot)
+{
+  if (slot < _XCORE_C_TRACK_CHANENDS) {
+    return _xcore_c_track_node | (slot << XS1_RES_ID_RESNUM_SHIFT) | XS1_RES_TYPE_CHANEND;
+  }
+  slot -= _XCORE_C_TRACK_CHANENDS;
+  if (slot < _XCORE_C_TRACK_TIMERS) {
+    return (slot << XS1_RES_ID_RESNUM_SHIFT) | XS1_RES_TYPE_TIMER;
+  }
+  slot -= _XCORE_C_TRACK_TIMERS;
+  if (slot < _XCORE_C_TRACK_LOCKS) {
+    return (slot << XS1_RES_ID_RESNUM_SHIFT) | XS1_RES_TYPE_LOCK;
+  }
+  slot -= _XCORE_C_TRACK_LOCKS;
+  static const uint8_t widths[_XCORE_C_TRACK_PORT_WIDTHS] = {1, 4, 8, 16, 32};
+  return (widths[slot / _XCORE_C_TRACK_PORTS] << XS1_RES_ID_PORTWIDTH_SHIFT) |
+         ((slot % _XCORE_C_TRACK_PORTS) << XS1_RES_ID_RESNUM_SHIFT) | XS1_RES_TYPE_PORT;
+}
+
+#include "xcore_c_track.h"
+extern xcore_c_error_t track_mark(track_mark_t *m);
+extern xcore_c_error_t track_get_leak(const track_mark_t *m, resource_t *r);
+extern xcore_c_error_t track_get_fault(track_fault_t *fault, resource_t *r);
+extern xcore_c_error_t track_get_exhausted(uint32_t type, uint32_t *count);
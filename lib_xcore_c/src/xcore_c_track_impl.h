@@ -0,0 +1,169 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+
+#ifndef __xcore_c_track_impl_h__
+#define __xcore_c_track_impl_h__
+
+// This file contains private implementation details and is not part of the API.
+// The contents may vary between releases.
+
+// The user may enable resource tracking in their Makefile.
+#ifndef XCORE_C_TRACK
+#define XCORE_C_TRACK 0
+#endif
+
+// The number of logical cores on a tile.
+#define _XCORE_C_TRACK_MAX_CORES 8
+
+// The resources tracked on a tile: a slot for each chan-end, timer and lock,
+// and for up to 16 ports of each width.
+#define _XCORE_C_TRACK_CHANENDS 32
+#define _XCORE_C_TRACK_TIMERS 10
+#define _XCORE_C_TRACK_LOCKS 4
+#define _XCORE_C_TRACK_PORTS 16
+#define _XCORE_C_TRACK_PORT_WIDTHS 5
+#define _XCORE_C_TRACK_SLOTS (_XCORE_C_TRACK_CHANENDS + _XCORE_C_TRACK_TIMERS + \
+                              _XCORE_C_TRACK_LOCKS + \
+                              _XCORE_C_TRACK_PORTS * _XCORE_C_TRACK_PORT_WIDTHS)
+
+// The resource types whose failed allocations are counted, indexed by type.
+#define _XCORE_C_TRACK_TYPES (XS1_RES_TYPE_LOCK + 1)
+
+#if !defined(__XC__) || defined(__DOXYGEN__)
+
+#include <stdint.h>
+#include <xs1.h>
+#include "xcore_c_exception_impl.h"
+
+/** The misuse of a resource found by the resource tracker.
+ *
+ *  A resource is used after free if it is used by a library call after being
+ *  freed, and before being allocated again. A null resource is one which was
+ *  not allocated because the resources of its type were exhausted.
+ */
+typedef enum {
+  track_fault_none,
+  track_fault_double_free,
+  track_fault_use_after_free,
+  track_fault_use_of_null,
+} track_fault_t;
+
+/** A snapshot of the resources allocated on a tile.
+ *
+ *  Users must not access its raw underlying type.
+ */
+typedef struct track_mark_t {
+#ifndef __DOXYGEN__
+  uint8_t state[_XCORE_C_TRACK_SLOTS];
+#endif // __DOXYGEN__
+} track_mark_t;
+
+// The state of each slot. A slot is written by the logical core which
+// allocates its resource and by any core which frees it. The hardware hands a
+// resource to one core at a time, but two cores may free it at once, so a free
+// is checked and recorded under the tracker's lock in _track_release().
+#define _XCORE_C_TRACK_UNUSED 0
+#define _XCORE_C_TRACK_ALLOCATED 1
+#define _XCORE_C_TRACK_FREED 2
+
+extern uint8_t _xcore_c_track_state[_XCORE_C_TRACK_SLOTS];
+
+// The node bits of the tile's chan-end identifiers.
+extern uint32_t _xcore_c_track_node;
+
+// The failed allocations of each type, counted by each logical core.
+extern uint32_t _xcore_c_track_exhausted[_XCORE_C_TRACK_MAX_CORES][_XCORE_C_TRACK_TYPES];
+
+// The last fault found by each logical core.
+typedef struct {
+  track_fault_t fault;
+  uint32_t resource;
+} _xcore_c_track_fault_t;
+
+extern _xcore_c_track_fault_t _xcore_c_track_faults[_XCORE_C_TRACK_MAX_CORES];
+
+// Returns the slot of a resource, or -1 if it is not tracked.
+inline int _track_slot(uint32_t r)
+{
+  uint32_t num = (r >> XS1_RES_ID_RESNUM_SHIFT) & XS1_RES_ID_RESNUM_MASK;
+  switch (r & XS1_RES_ID_TYPE_MASK) {
+    case XS1_RES_TYPE_CHANEND:
+      return num < _XCORE_C_TRACK_CHANENDS ? (int)num : -1;
+    case XS1_RES_TYPE_TIMER:
+      return num < _XCORE_C_TRACK_TIMERS ? (int)(_XCORE_C_TRACK_CHANENDS + num) : -1;
+    case XS1_RES_TYPE_LOCK:
+      return num < _XCORE_C_TRACK_LOCKS ?
+             (int)(_XCORE_C_TRACK_CHANENDS + _XCORE_C_TRACK_TIMERS + num) : -1;
+    case XS1_RES_TYPE_PORT: {
+      int width;
+      switch ((r >> XS1_RES_ID_PORTWIDTH_SHIFT) & XS1_RES_ID_PORTWIDTH_MASK) {
+        case 1: width = 0; break;
+        case 4: width = 1; break;
+        case 8: width = 2; break;
+        case 16: width = 3; break;
+        case 32: width = 4; break;
+        default: return -1;
+      }
+      return num < _XCORE_C_TRACK_PORTS ?
+             (int)(_XCORE_C_TRACK_CHANENDS + _XCORE_C_TRACK_TIMERS + _XCORE_C_TRACK_LOCKS +
+                   width * _XCORE_C_TRACK_PORTS + num) : -1;
+    }
+    default:
+      return -1;
+  }
+}
+
+// Record the fault and raise ET_ECALL.
+extern void _track_fault(track_fault_t fault, uint32_t r);  // Implemented in xcore_c_track.c
+
+// Mark a slot freed, raising a fault if it already was.
+extern void _track_release(int slot, uint32_t r);  // Implemented in xcore_c_track.c
+
+inline void _track_alloc(uint32_t r, uint32_t type)
+{
+  if (!r) {
+    if (type < _XCORE_C_TRACK_TYPES) {
+      _xcore_c_track_exhausted[_error_core_id()][type]++;
+    }
+    return;
+  }
+  int slot = _track_slot(r);
+  if (slot >= 0) {
+    _xcore_c_track_state[slot] = _XCORE_C_TRACK_ALLOCATED;
+  }
+  if (type == XS1_RES_TYPE_CHANEND) {
+    _xcore_c_track_node = r & ~0xffff;
+  }
+}
+
+inline void _track_free(uint32_t r)
+{
+  int slot = _track_slot(r);
+  if (slot >= 0) {
+    _track_release(slot, r);
+  }
+}
+
+inline void _track_use(uint32_t r)
+{
+  if (!r) {
+    _track_fault(track_fault_use_of_null, r);
+  }
+  int slot = _track_slot(r);
+  if (slot >= 0 && _xcore_c_track_state[slot] == _XCORE_C_TRACK_FREED) {
+    _track_fault(track_fault_use_after_free, r);
+  }
+}
+
+#if XCORE_C_TRACK
+#define _XCORE_C_TRACK_ALLOC(r, type) _track_alloc((uint32_t)(r), (type))
+#define _XCORE_C_TRACK_FREE(r) _track_free((uint32_t)(r))
+#define _XCORE_C_TRACK_USE(r) _track_use((uint32_t)(r))
+#else
+#define _XCORE_C_TRACK_ALLOC(r, type) ((void)0)
+#define _XCORE_C_TRACK_FREE(r) ((void)0)
+#define _XCORE_C_TRACK_USE(r) ((void)(r))
+#endif
+
+#endif // !defined(__XC__)
+
+#endif // __xcore_c_track_impl_h__
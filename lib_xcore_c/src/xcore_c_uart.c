@@ -0,0 +1,74 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+
+#include "xcore_c_uart_impl.h"
+extern void _uart_rx_wait_start(uart_rx_t *u);
+extern uint32_t _uart_rx_next(const uart_rx_t *u, uint32_t count);
+extern uint8_t *_uart_rx_slot(const uart_rx_t *u, uint32_t count);
+extern int _uart_rx_get_byte(uart_rx_t *u, uint8_t *data);
+
+static void _uart_rx_store(uart_rx_t *u)
+{
+  uint32_t written = u->written;
+  uint32_t read = u->read;
+  if (written - read == u->size || read - written == u->size) {
+    u->overruns++;
+    return;
+  }
+  *_uart_rx_slot(u, written) = u->data;
+  _UART_BARRIER();
+  u->written = _uart_rx_next(u, written);
+}
+
+void _uart_rx_event(uart_rx_t *u)
+{
+  uint32_t bit = _port_in(u->p) & 1;
+
+  switch (u->state) {
+    case _UART_RX_IDLE:
+      // Sample the middle of each bit, starting with the start bit.
+      u->time = _port_get_trigger_time(u->p) + u->bit_time / 2;
+      _port_clear_trigger_in(u->p);
+      _port_set_trigger_time(u->p, u->time);
+      u->state = _UART_RX_START;
+      return;
+
+    case _UART_RX_START:
+      if (bit) {
+        // A glitch rather than a start bit.
+        _uart_rx_wait_start(u);
+        return;
+      }
+      u->bits = 0;
+      u->data = 0;
+      u->state = _UART_RX_DATA;
+      break;
+
+    case _UART_RX_DATA:
+      // Data bits are sent least significant bit first.
+      u->data |= bit << u->bits;
+      if (++u->bits == 8) {
+        u->state = _UART_RX_STOP;
+      }
+      break;
+
+    case _UART_RX_STOP:
+      if (bit) {
+        _uart_rx_store(u);
+      }
+      else {
+        u->framing_errors++;
+      }
+      _uart_rx_wait_start(u);
+      return;
+  }
+
+  u->time += u->bit_time;
+  _port_set_trigger_time(u->p, u->time);
+}
+
+#include "xcore_c_uart.h"
+extern xcore_c_error_t uart_rx_init(uart_rx_t *u, port p, uint32_t baud, uint8_t buf[], size_t size);
+extern xcore_c_error_t uart_rx_setup_select(uart_rx_t *u, uint32_t enum_id);
+extern xcore_c_error_t uart_rx_handle_event(uart_rx_t *u);
+extern xcore_c_error_t uart_rx_get_byte(uart_rx_t *u, uint8_t *data, size_t *received);
+extern xcore_c_error_t uart_rx_get_errors(const uart_rx_t *u, uint32_t *overruns, uint32_t *framing_errors);
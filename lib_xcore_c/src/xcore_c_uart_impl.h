@@ -0,0 +1,87 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+
+#ifndef __xcore_c_uart_impl_h__
+#define __xcore_c_uart_impl_h__
+
+// This file contains private implementation details and is not part of the API.
+// The contents may vary between releases.
+
+#if !defined(__XC__) || defined(__DOXYGEN__)
+
+#include <stdint.h>
+#include <stddef.h>
+#include "xcore_c_port_impl.h"
+
+/** An opaque type for a UART receiver.
+ *
+ *  Users must not access its raw underlying type.
+ */
+typedef struct uart_rx_t {
+#ifndef __DOXYGEN__
+  port p;
+  int16_t bit_time;
+  int16_t time;
+  uint32_t state;
+  uint32_t bits;
+  uint32_t data;
+  uint8_t *buf;
+  size_t size;
+  volatile uint32_t written;
+  volatile uint32_t read;
+  uint32_t overruns;
+  uint32_t framing_errors;
+#endif // __DOXYGEN__
+} uart_rx_t;
+
+// The ports are clocked by the 100MHz reference clock.
+#define _UART_PORT_CLOCK_HZ 100000000
+
+// The receiver states, named after the bit which the next event samples.
+#define _UART_RX_IDLE 0
+#define _UART_RX_START 1
+#define _UART_RX_DATA 2
+#define _UART_RX_STOP 3
+
+// Stop the compiler moving byte accesses across an update of the buffer counts.
+#define _UART_BARRIER() asm volatile("" ::: "memory")
+
+// Wait for the falling edge of a start bit.
+inline void _uart_rx_wait_start(uart_rx_t *u)
+{
+  u->state = _UART_RX_IDLE;
+  _port_clear_trigger_time(u->p);
+  _port_set_trigger_in_equal(u->p, 0);
+}
+
+// The buffer counts run from 0 to twice the size of the buffer, wrapping back
+// to 0. So a full buffer can be told from an empty one, and a count's byte is
+// the same before and after it wraps.
+inline uint32_t _uart_rx_next(const uart_rx_t *u, uint32_t count)
+{
+  return count + 1 == 2 * u->size ? 0 : count + 1;
+}
+
+inline uint8_t *_uart_rx_slot(const uart_rx_t *u, uint32_t count)
+{
+  return &u->buf[count < u->size ? count : count - u->size];
+}
+
+// Returns 0 if there is no byte to read.
+inline int _uart_rx_get_byte(uart_rx_t *u, uint8_t *data)
+{
+  uint32_t read = u->read;
+  if (u->written == read) {
+    return 0;
+  }
+  *data = *_uart_rx_slot(u, read);
+  _UART_BARRIER();
+  u->read = _uart_rx_next(u, read);
+  return 1;
+}
+
+// Handle an event from the receiver's port.
+extern void _uart_rx_event(uart_rx_t *u);  // Implemented in xcore_c_uart.c
+
+#endif // !defined(__XC__)
+
+#endif // __xcore_c_uart_impl_h__
@@ -0,0 +1,83 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+
+#include "xcore_c.h"
+#include "xassert.h"
+
+extern const size_t array_len;
+
+void test_int(chanend c);
+void test_char(chanend c);
+void print_array_int(const char *prefix, const uint32_t data[], size_t num_words);
+void print_array_char(const char *prefix, const uint8_t data[], size_t num_bytes);
+
+static channel_t c, d;
+
+static void run_test_int(void *arg)
+{
+  test_int(c.end_a);
+}
+
+static void run_test_char(void *arg)
+{
+  test_char(d.end_a);
+}
+
+// The xC transactions of main.xc, using the C transaction functions.
+static void xc_test_int(void *arg)
+{
+  uint32_t data[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+  chanend e = c.end_b;
+  transacting_chanend_t tc;
+
+  chan_init_transaction_master(&e, &tc);
+  for (size_t i = 0; i < array_len; i++) {
+    t_chan_out_word(&tc, data[i]);
+  }
+  chan_complete_transaction(&e, &tc);
+
+  chan_init_transaction_slave(&e, &tc);
+  for (size_t i = 0; i < array_len; i++) {
+    t_chan_in_word(&tc, &data[i]);
+  }
+  chan_complete_transaction(&e, &tc);
+
+  print_array_int("xC received: ", data, array_len);
+}
+
+static void xc_test_char(void *arg)
+{
+  uint8_t data[] = {'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h', 'i', 'j'};
+  chanend e = d.end_b;
+  transacting_chanend_t tc;
+
+  chan_init_transaction_slave(&e, &tc);
+  for (size_t i = 0; i < array_len; i++) {
+    t_chan_out_byte(&tc, data[i]);
+  }
+  chan_complete_transaction(&e, &tc);
+
+  chan_init_transaction_master(&e, &tc);
+  for (size_t i = 0; i < array_len; i++) {
+    t_chan_in_byte(&tc, &data[i]);
+  }
+  chan_complete_transaction(&e, &tc);
+
+  print_array_char("xC received: ", data, array_len);
+}
+
+int main()
+{
+  chan_alloc(&c);
+  chan_alloc(&d);
+  static const host_core_t ints[] = {
+    { run_test_int, NULL },
+    { xc_test_int, NULL },
+  };
+  host_par(ints, 2);
+  static const host_core_t chars[] = {
+    { run_test_char, NULL },
+    { xc_test_char, NULL },
+  };
+  host_par(chars, 2);
+  return 0;
+}
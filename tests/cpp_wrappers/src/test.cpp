@@ -0,0 +1,93 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+
+#include "xcore_c.hpp"
+extern "C" {
+#include "debug_print.h"
+}
+
+using namespace xcore_c;
+
+struct sample_t {
+  int32_t left;
+  int32_t right;
+};
+
+struct packed_t {
+  uint8_t header;
+  uint16_t length;
+  uint8_t crc;
+  uint8_t flags;
+};
+
+// Each type is transferred by the cheapest path.
+static_assert(_transfer<char>::path == _TRANSFER_BYTE, "");
+static_assert(_transfer<float>::path == _TRANSFER_WORD, "");
+static_assert(_transfer<sample_t>::path == _TRANSFER_WORDS, "");
+static_assert(_transfer<packed_t>::path == _TRANSFER_BYTES, "");
+
+extern "C" void sender(chanend c)
+{
+  Channel<sample_t> samples;
+  Channel<packed_t> packets;
+  StreamingChannel<float> levels;
+  xassert(samples && packets && levels);
+
+  chan_out_word(c, samples.end_b().get());
+  chan_out_word(c, packets.end_b().get());
+  chan_out_word(c, levels.end_b().get());
+
+  for (int i = 0; i < 3; i++) {
+    sample_t s = {i, -i};
+    samples.end_a().out(s);
+  }
+  packed_t p = {0xa5, 300, 0x3c, 1};
+  packets.end_a().out(p);
+  levels.end_a().out(0.5f);
+  levels.end_a().out(-2.25f);
+
+  // The channels are freed when they go out of scope, after the receiver is done.
+  uint32_t done;
+  chan_in_word(c, &done);
+}
+
+extern "C" void receiver(chanend c)
+{
+  uint32_t id;
+  chan_in_word(c, &id);
+  ChanEnd<sample_t> samples(id);
+  chan_in_word(c, &id);
+  ChanEnd<packed_t> packets(id);
+  chan_in_word(c, &id);
+  StreamingChanEnd<float> levels(id);
+
+  for (int i = 0; i < 3; i++) {
+    sample_t s;
+    samples.in(s);
+    debug_printf("Sample %d %d\n", s.left, s.right);
+  }
+  packed_t p;
+  packets.in(p);
+  debug_printf("Packet 0x%x %d 0x%x %d\n", p.header, p.length, p.crc, p.flags);
+  for (int i = 0; i < 2; i++) {
+    float level;
+    levels.in(level);
+    debug_printf("Level %d/4\n", (int)(level * 4));
+  }
+
+  // Port 1A is looped back to port 1B.
+  {
+    Port<1> out(port_1A);
+    Port<1> in(port_1B);
+    Port<1>::data_t value;
+    out.out(1);
+    hwtimer_core_delay(100);
+    in.in(value);
+    debug_printf("Port %d\n", value);
+    out.out(0);
+    hwtimer_core_delay(100);
+    in.in(value);
+    debug_printf("Port %d\n", value);
+  }
+
+  chan_out_word(c, 0);
+}
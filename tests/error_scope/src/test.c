@@ -0,0 +1,82 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+
+#include "xcore_c.h"
+#include "debug_print.h"
+#include "xassert.h"
+
+static hwtimer_t freed;
+static xcore_c_error_t interrupt_error;
+
+DEFINE_INTERRUPT_CALLBACK(error_scope_group, raising_handler, data)
+{
+  hwtimer_t tmr = *(hwtimer_t *)data;
+  uint32_t time;
+  hwtimer_disable_trigger(tmr);
+  interrupt_error = hwtimer_get_time(freed, &time);
+}
+
+DEFINE_INTERRUPT_PERMITTED(error_scope_group, void, test, void)
+{
+  xcore_c_error_t error;
+  hwtimer_t tmr = 0;
+  uint32_t time = 0;
+  volatile int reached = 0;
+
+  // A block of calls which all succeed.
+  ERROR_SCOPE(error, {
+    hwtimer_alloc(&tmr);
+    hwtimer_get_time(tmr, &time);
+    hwtimer_delay(tmr, 100);
+    reached = 1;
+  });
+  debug_printf("Scope: error %d reached %d\n", error, reached);
+
+  freed = tmr;
+  hwtimer_free(&tmr);
+
+  // The first exception skips the rest of the block.
+  reached = 0;
+  ERROR_SCOPE(error, {
+    hwtimer_get_time(freed, &time);
+    reached = 1;
+  });
+  debug_printf("Scope: error %d reached %d\n", error, reached);
+
+  // An exception is caught by the innermost scope.
+  xcore_c_error_t inner;
+  reached = 0;
+  ERROR_SCOPE(error, {
+    ERROR_SCOPE(inner, {
+      hwtimer_get_time(freed, &time);
+    });
+    reached = 1;
+  });
+  debug_printf("Nested: error %d inner %d reached %d\n", error, inner, reached);
+
+  // Outside a scope each call catches its own exception.
+  error = hwtimer_get_time(freed, &time);
+  debug_printf("Call: error %d\n", error);
+
+  // An interrupt taken inside a scope catches its own exception, and leaves
+  // the scope to catch the next one. The timer freed before may have been
+  // allocated again, so free another.
+  hwtimer_alloc(&tmr);
+  hwtimer_t other;
+  hwtimer_alloc(&other);
+  freed = other;
+  hwtimer_free(&other);
+  hwtimer_get_time(tmr, &time);
+  hwtimer_setup_interrupt_callback(tmr, time + 1000, &tmr, INTERRUPT_CALLBACK(raising_handler));
+  hwtimer_enable_trigger(tmr);
+  reached = 0;
+  ERROR_SCOPE(error, {
+    interrupt_unmask_all();
+    hwtimer_core_delay(2000);
+    interrupt_mask_all();
+    reached = 1;
+    hwtimer_get_time(freed, &time);
+    reached = 2;
+  });
+  debug_printf("Interrupted: error %d interrupt %d reached %d\n", error, interrupt_error, reached);
+  hwtimer_free(&tmr);
+}
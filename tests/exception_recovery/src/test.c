@@ -0,0 +1,69 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+
+#include "xcore_c.h"
+#include "debug_print.h"
+#include "xassert.h"
+
+typedef struct {
+  hwtimer_t tmr;
+  int resets;
+} state_t;
+
+static int reset_timer(exception_t exception, void *data)
+{
+  state_t *state = data;
+  debug_printf("Handler: type %d on the timer %d\n", exception.type,
+               exception.data == (unsigned)state->tmr);
+  if (state->resets == 2) {
+    return 0;
+  }
+  state->resets++;
+  hwtimer_alloc(&state->tmr);
+  return 1;
+}
+
+void test(void)
+{
+  xcore_c_error_t error;
+  state_t state = {0, 0};
+  volatile int runs = 0;
+
+  hwtimer_alloc(&state.tmr);
+  exception_set_handler(error_illegal_resource, reset_timer, &state);
+
+  // The block runs again after the handler has reset the timer.
+  EXCEPTION_RECOVERY_POINT(error, {
+    runs++;
+    for (int i = 0; i < 3; i++) {
+      hwtimer_delay(state.tmr, 100);
+      if (runs == 1 && i == 1) {
+        // Lose the timer, as a fault might.
+        hwtimer_t lost = state.tmr;
+        hwtimer_free(&state.tmr);
+        state.tmr = lost;
+      }
+    }
+  });
+  debug_printf("Recovered: error %d runs %d resets %d\n", error, runs, state.resets);
+
+  // The handler declines to resume.
+  hwtimer_t lost = state.tmr;
+  hwtimer_free(&state.tmr);
+  state.tmr = lost;
+  state.resets = 2;
+  runs = 0;
+  EXCEPTION_RECOVERY_POINT(error, {
+    runs++;
+    hwtimer_delay(state.tmr, 100);
+  });
+  debug_printf("Declined: error %d runs %d\n", error, runs);
+
+  // Without a handler the recovery point is left.
+  exception_clear_handler(error_illegal_resource);
+  runs = 0;
+  EXCEPTION_RECOVERY_POINT(error, {
+    runs++;
+    hwtimer_delay(state.tmr, 100);
+  });
+  debug_printf("Unhandled: error %d runs %d\n", error, runs);
+}
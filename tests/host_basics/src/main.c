@@ -0,0 +1,22 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+
+#include "xcore_c.h"
+
+void test_channel(void *arg);
+void test_select(void *arg);
+void test_lock(void *arg);
+void test_port(void *arg);
+
+int main()
+{
+  static const host_core_t tests[] = {
+    { test_channel, NULL },
+    { test_select, NULL },
+    { test_lock, NULL },
+    { test_port, NULL },
+  };
+  for (size_t i = 0; i < sizeof(tests) / sizeof(tests[0]); i++) {
+    host_par(&tests[i], 1);
+  }
+  return 0;
+}
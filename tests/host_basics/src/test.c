@@ -0,0 +1,136 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+
+#include <stdio.h>
+#include "xcore_c.h"
+#include "debug_print.h"
+#include "xassert.h"
+
+static channel_t channel;
+static lock_t counter_lock;
+static volatile uint32_t counter;
+
+static void sender(void *arg)
+{
+  const uint32_t data[3] = { 0x12345678, 0x9abcdef0, 0x0 };
+  chan_out_buf_word(channel.end_a, data, 3);
+}
+
+static void receiver(void *arg)
+{
+  uint32_t data[3];
+  chan_in_buf_word(channel.end_b, data, 3);
+  debug_printf("Received 0x%x 0x%x 0x%x\n", data[0], data[1], data[2]);
+}
+
+/*
+ * Pass words over a channel between two logical cores.
+ */
+void test_channel(void *arg)
+{
+  chan_alloc(&channel);
+  const host_core_t cores[2] = { { sender, NULL }, { receiver, NULL } };
+  host_par(cores, 2);
+  chan_free(&channel);
+}
+
+static void select_sender(void *arg)
+{
+  hwtimer_core_delay(1000);
+  chan_out_word(channel.end_a, 42);
+}
+
+static void select_receiver(void *arg)
+{
+  hwtimer_t t;
+  uint32_t now, data;
+  hwtimer_alloc(&t);
+  hwtimer_get_time(t, &now);
+  chanend_setup_select(channel.end_b, ENUM_ID_BASE + 1);
+  chanend_enable_trigger(channel.end_b);
+  hwtimer_setup_select(t, now + 100000, ENUM_ID_BASE + 2);
+  hwtimer_enable_trigger(t);
+
+  // The channel is ready first, then the timer times out.
+  for (int i = 0; i < 2; i++) {
+    switch (select_wait()) {
+      case ENUM_ID_BASE + 1:
+        chan_in_word(channel.end_b, &data);
+        debug_printf("Channel %d\n", data);
+        break;
+      case ENUM_ID_BASE + 2:
+        hwtimer_disable_trigger(t);
+        debug_printf("Timeout\n");
+        break;
+    }
+  }
+  select_disable_trigger_all();
+  hwtimer_free(&t);
+}
+
+/*
+ * Wait on a channel and a timer together.
+ */
+void test_select(void *arg)
+{
+  chan_alloc(&channel);
+  const host_core_t cores[2] = { { select_sender, NULL }, { select_receiver, NULL } };
+  host_par(cores, 2);
+  chan_free(&channel);
+}
+
+static void incrementer(void *arg)
+{
+  for (int i = 0; i < 1000; i++) {
+    lock_acquire(counter_lock);
+    counter = counter + 1;
+    lock_release(counter_lock);
+  }
+}
+
+/*
+ * Increment a counter from several logical cores under a lock.
+ */
+void test_lock(void *arg)
+{
+  lock_alloc(&counter_lock);
+  const host_core_t cores[4] = {
+    { incrementer, NULL }, { incrementer, NULL },
+    { incrementer, NULL }, { incrementer, NULL },
+  };
+  host_par(cores, 4);
+  lock_free(&counter_lock);
+  debug_printf("Counter %d\n", counter);
+}
+
+/*
+ * Output on a port looped back to another, and wait for the value on its pins.
+ */
+void test_port(void *arg)
+{
+  port p_out, p_in;
+  uint32_t data;
+  int16_t t_out, t_in;
+  host_port_connect(port_1A, port_1B);
+  port_alloc(&p_out, port_1A);
+  port_alloc(&p_in, port_1B);
+
+  port_out(p_out, 0);
+  port_in_when_pinseq(p_in, PORT_UNBUFFERED, 0, &data);
+  port_get_trigger_time(p_in, &t_in);
+  port_out_at_time(p_out, t_in + 100, 1);
+  port_get_trigger_time(p_out, &t_out);
+  port_in_when_pinseq(p_in, PORT_UNBUFFERED, 1, &data);
+  port_get_trigger_time(p_in, &t_in);
+  debug_printf("Port %d after %d\n", data, (int16_t)(t_in - t_out));
+
+  exception_t e;
+  TRY {
+    port_set_transfer_width(p_in, 8);
+  }
+  CATCH(e) {
+    debug_printf("Exception %d\n", e.type);
+  }
+
+  port_free(&p_out);
+  port_free(&p_in);
+}
@@ -0,0 +1,32 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+
+#include <stdio.h>
+#include <string.h>
+#include "xcore_c.h"
+#include "test.h"
+
+// The stimulus files are in the test's src directory, and the trace is written
+// to its bin directory, both found from the path of the test.
+static char bus_file[256], uart_file[256], trace_file[256];
+
+int main(int argc, char *argv[])
+{
+  const char *bin = argv[0];
+  int len = strrchr(bin, '/') ? (int)(strrchr(bin, '/') - bin) : 1;
+  if (!strrchr(bin, '/')) {
+    bin = ".";
+  }
+  snprintf(bus_file, sizeof(bus_file), "%.*s/../src/bus.vcd", len, bin);
+  snprintf(uart_file, sizeof(uart_file), "%.*s/../src/uart.vcd", len, bin);
+  snprintf(trace_file, sizeof(trace_file), "%.*s/trace.vcd", len, bin);
+
+  static const host_core_t tests[] = {
+    { test_bus, bus_file },
+    { test_uart, uart_file },
+    { test_trace, trace_file },
+  };
+  for (size_t i = 0; i < sizeof(tests) / sizeof(tests[0]); i++) {
+    host_par(&tests[i], 1);
+  }
+  return 0;
+}
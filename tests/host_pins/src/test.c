@@ -0,0 +1,97 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+
+#include <stdio.h>
+#include "xcore_c.h"
+#include "debug_print.h"
+#include "test.h"
+
+/*
+ * Wait for each value a stimulus file drives onto a 4-bit bus.
+ */
+void test_bus(void *filename)
+{
+  static const uint32_t values[] = { 0x1, 0x3, 0xf, 0x0 };
+  enum { n = sizeof(values) / sizeof(values[0]) };
+  port p;
+  uint32_t data[n];
+  int16_t t[n];
+  host_port_stimulus(port_4A, filename);
+  port_alloc(&p, port_4A);
+
+  // Printing is slow, so report once every value has been seen
+  for (size_t i = 0; i < n; i++) {
+    port_in_when_pinseq(p, PORT_UNBUFFERED, values[i], &data[i]);
+    port_get_trigger_time(p, &t[i]);
+  }
+  for (size_t i = 0; i < n; i++) {
+    debug_printf("Bus 0x%x at %d\n", data[i], t[i]);
+  }
+
+  port_free(&p);
+  host_port_stimulus(port_4A, NULL);
+}
+
+/*
+ * Receive the bytes of a stimulus file's serial line at 1Mbaud.
+ */
+void test_uart(void *filename)
+{
+  port p;
+  uart_rx_t u;
+  uint8_t buf[4];
+  char text[3] = "";
+  size_t received = 0;
+  host_port_stimulus(port_1D, filename);
+  port_alloc(&p, port_1D);
+  uart_rx_init(&u, p, 1000000, buf, sizeof(buf));
+  uart_rx_setup_select(&u, ENUM_ID_BASE);
+
+  while (received < 2) {
+    size_t got;
+    select_wait();
+    uart_rx_handle_event(&u);
+    uart_rx_get_byte(&u, (uint8_t *)&text[received], &got);
+    received += got;
+  }
+  debug_printf("UART received %s\n", text);
+
+  select_disable_trigger_all();
+  port_free(&p);
+  host_port_stimulus(port_1D, NULL);
+}
+
+/*
+ * Trace a pulse output on a port, then drive another port's pins with the trace.
+ */
+void test_trace(void *filename)
+{
+  port p;
+  uint32_t data;
+  int16_t t, start;
+  host_port_trace(port_1B, filename);
+  port_alloc(&p, port_1B);
+  port_out(p, 0);
+  port_get_trigger_time(p, &start);
+  port_out_at_time(p, start + 100, 1);
+  port_out_at_time(p, start + 150, 0);
+  hwtimer_core_delay(1000);
+  port_free(&p);
+  host_port_trace(port_1B, NULL);
+
+  FILE *f = fopen(filename, "r");
+  char line[80];
+  while (fgets(line, sizeof(line), f)) {
+    debug_printf("Trace: %s", line);
+  }
+  fclose(f);
+
+  host_port_stimulus(port_1C, filename);
+  port_alloc(&p, port_1C);
+  port_in_when_pinseq(p, PORT_UNBUFFERED, 1, &data);
+  port_get_trigger_time(p, &start);
+  port_in_when_pinseq(p, PORT_UNBUFFERED, 0, &data);
+  port_get_trigger_time(p, &t);
+  debug_printf("Replayed pulse of %d\n", (int16_t)(t - start));
+  port_free(&p);
+  host_port_stimulus(port_1C, NULL);
+}
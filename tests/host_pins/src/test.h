@@ -0,0 +1,11 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+
+#ifndef __test_h__
+#define __test_h__
+
+// Each test is passed the path of the file it uses.
+void test_bus(void *filename);
+void test_uart(void *filename);
+void test_trace(void *filename);
+
+#endif // __test_h__
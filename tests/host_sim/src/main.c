@@ -0,0 +1,44 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+
+#include "xcore_c.h"
+#include "debug_print.h"
+#include "test.h"
+
+#define SEEDS 1000
+#define REPLAY_SEED 42
+
+int main()
+{
+  static uint32_t signatures[SEEDS];
+  test_result_t result;
+  int ordered = 0, fair = 0, first_c = 0, first_d = 0, varied = 0;
+  int contended = 0, repeated = 0;
+
+  for (uint32_t seed = 0; seed < SEEDS; seed++) {
+    host_sim_seed(seed);
+    test_ordered(&result);
+    ordered += result.passed;
+
+    host_sim_seed(seed);
+    test_fair(&result);
+    fair += result.passed;
+    first_c += !result.first_d;
+    first_d += result.first_d;
+    contended += result.contended;
+    repeated += result.repeated;
+    signatures[seed] = result.signature;
+    varied |= result.signature != signatures[0];
+  }
+  debug_printf("Ordered priority held for %d of %d seeds\n", ordered, SEEDS);
+  debug_printf("Fair rotation held for %d of %d seeds\n", fair, SEEDS);
+  debug_printf("Both channels received first: %s\n", first_c && first_d ? "yes" : "no");
+  debug_printf("Favoured channel had a word waiting: %s\n", contended ? "yes" : "no");
+  debug_printf("A channel received from twice running: %s\n", repeated ? "yes" : "no");
+  debug_printf("Interleavings vary with the seed: %s\n", varied ? "yes" : "no");
+
+  host_sim_seed(REPLAY_SEED);
+  test_fair(&result);
+  debug_printf("Replay of seed %d identical: %s\n", REPLAY_SEED,
+               result.signature == signatures[REPLAY_SEED] ? "yes" : "no");
+  return 0;
+}
@@ -0,0 +1,158 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+
+#include <stdio.h>
+#include "xcore_c.h"
+#include "test.h"
+
+// For XS1 support all values passed to the event_setup function must have bit 16 set
+typedef enum {
+  EVENT_CHAN_C = ENUM_ID_BASE,
+  EVENT_CHAN_D,
+  EVENT_TIMER,
+  EVENT_NONE
+} event_choice_t;
+
+// Streaming, so that each sender's words can all be waiting to be received.
+static streaming_channel_t c, d;
+static int words;
+
+static void sender_c(void *arg)
+{
+  for (int i = 0; i < words; i++) {
+    s_chan_out_word(c.end_a, 555 + i);
+  }
+}
+
+static void sender_d(void *arg)
+{
+  for (int i = 0; i < words; i++) {
+    s_chan_out_word(d.end_a, 333 + i);
+  }
+}
+
+static void add_to_signature(test_result_t *result, uint32_t value)
+{
+  // FNV-1a
+  result->signature = (result->signature ^ value) * 16777619;
+}
+
+static void run(void (*receiver)(void *arg), test_result_t *result, int n)
+{
+  words = n;
+  result->passed = 1;
+  result->first_d = 0;
+  result->contended = 0;
+  result->repeated = 0;
+  result->signature = 2166136261;
+  s_chan_alloc(&c);
+  s_chan_alloc(&d);
+  const host_core_t cores[3] = {
+    { sender_c, NULL }, { sender_d, NULL }, { receiver, result },
+  };
+  host_par(cores, 3);
+  s_chan_free(&c);
+  s_chan_free(&d);
+}
+
+/*
+ * Once every word has arrived, select_wait_ordered() must take all those on c,
+ * then all those on d, and only then the timer which is always ready.
+ */
+static void ordered_receiver(void *arg)
+{
+  test_result_t *result = arg;
+  hwtimer_t tmr;
+  uint32_t now, x;
+  hwtimer_alloc(&tmr);
+  hwtimer_delay(tmr, 1000);
+  hwtimer_get_time(tmr, &now);
+
+  chanend_setup_select(c.end_b, EVENT_CHAN_C);
+  chanend_enable_trigger(c.end_b);
+  chanend_setup_select(d.end_b, EVENT_CHAN_D);
+  chanend_enable_trigger(d.end_b);
+  hwtimer_setup_select(tmr, now, EVENT_TIMER);
+  hwtimer_enable_trigger(tmr);
+
+  resource_t ids[4] = { c.end_b, d.end_b, tmr, 0 };
+  for (int i = 0; i < 2 * words + 1; i++) {
+    event_choice_t choice = select_wait_ordered(ids);
+    if (i < words) {
+      s_chan_in_word(c.end_b, &x);
+      result->passed &= choice == EVENT_CHAN_C && x == 555 + i;
+    }
+    else if (i < 2 * words) {
+      s_chan_in_word(d.end_b, &x);
+      result->passed &= choice == EVENT_CHAN_D && x == 333 + i - words;
+    }
+    else {
+      result->passed &= choice == EVENT_TIMER;
+    }
+  }
+  select_disable_trigger_all();
+  hwtimer_free(&tmr);
+}
+
+void test_ordered(test_result_t *result)
+{
+  run(ordered_receiver, result, 3);
+}
+
+/*
+ * Both channels stay enabled, and select_wait_ordered() favours the channel not
+ * received from last. If that channel has a word waiting it must be taken, so
+ * neither channel is passed over twice while the other is received from. When
+ * it has none the other channel may be received from again.
+ */
+static void fair_receiver(void *arg)
+{
+  test_result_t *result = arg;
+  hwtimer_t tmr;
+  uint32_t now, x;
+  int received_c = 0, received_d = 0;
+  hwtimer_alloc(&tmr);
+
+  chanend_setup_select(c.end_b, EVENT_CHAN_C);
+  chanend_setup_select(d.end_b, EVENT_CHAN_D);
+
+  resource_t c_first[3] = { c.end_b, d.end_b, 0 };
+  resource_t d_first[3] = { d.end_b, c.end_b, 0 };
+  resource_t c_only[2] = { c.end_b, 0 };
+  resource_t d_only[2] = { d.end_b, 0 };
+
+  event_choice_t last = EVENT_CHAN_D;
+  for (int i = 0; i < 2 * words; i++) {
+    event_choice_t favoured = last == EVENT_CHAN_C ? EVENT_CHAN_D : EVENT_CHAN_C;
+    // Nothing else takes the favoured channel's word between here and the select.
+    int waiting = select_no_wait_ordered(EVENT_NONE,
+                                         favoured == EVENT_CHAN_C ? c_only : d_only) == favoured;
+    event_choice_t choice = select_wait_ordered(favoured == EVENT_CHAN_C ? c_first : d_first);
+    if (choice == EVENT_CHAN_C) {
+      s_chan_in_word(c.end_b, &x);
+      result->passed &= x == 555 + received_c++;
+    }
+    else {
+      s_chan_in_word(d.end_b, &x);
+      result->passed &= x == 333 + received_d++;
+    }
+    if (i == 0) {
+      result->first_d = choice == EVENT_CHAN_D;
+    }
+    result->passed &= !waiting || choice == favoured;
+    result->contended += waiting;
+    result->repeated += i > 0 && choice == last;
+    last = choice;
+
+    // The interleaving is recorded by when each word was received.
+    hwtimer_get_time(tmr, &now);
+    add_to_signature(result, choice);
+    add_to_signature(result, now);
+  }
+  select_disable_trigger_all();
+  hwtimer_free(&tmr);
+}
+
+void test_fair(test_result_t *result)
+{
+  run(fair_receiver, result, 5);
+}
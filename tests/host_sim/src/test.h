@@ -0,0 +1,19 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+
+#ifndef __test_h__
+#define __test_h__
+
+#include <stdint.h>
+
+typedef struct test_result_t {
+  int passed;
+  int first_d;          // Whether the first word received was on channel d.
+  int contended;        // Selects made with the favoured channel's word waiting.
+  int repeated;         // Words received on the channel received from last.
+  uint32_t signature;   // Identifies the interleaving.
+} test_result_t;
+
+void test_ordered(test_result_t *result);
+void test_fair(test_result_t *result);
+
+#endif // __test_h__
@@ -0,0 +1,29 @@
+# Builds an xCORE test natively for the host backend, as bin/host/<test>
+# (bin/host/<test>_sim with HOST_SIM=1).
+#
+# A test which runs natively has a host/ directory holding a main.c, which
+# starts the test's tasks with host_par() as the par in its main.xc does, and a
+# Makefile which sets TEST_FLAGS to the defines of the test's FLAGS_COMMON and
+# includes this file. The library is compiled with the test's flags, as they
+# change its inline functions.
+
+LIB_XCORE_C = ../../../lib_xcore_c
+include $(LIB_XCORE_C)/host/Makefile
+
+.DEFAULT_GOAL := host_test
+
+TEST = $(notdir $(abspath ..))
+CFLAGS = -g -O2 -DDEBUG_PRINT_ENABLE=1 $(TEST_FLAGS)
+APP = ../bin/host/$(TEST)$(HOST_VARIANT)
+TEST_SOURCES = main.c $(wildcard ../src/*.c)
+
+host_test: $(APP)
+
+$(APP): $(TEST_SOURCES) $(SOURCES)
+	@mkdir -p $(dir $@)
+	$(CC) $(CFLAGS) $(HOST_CFLAGS) -I../src -o $@ $(TEST_SOURCES) $(SOURCES)
+
+clean::
+	rm -rf ../bin/host
+
+.PHONY: host_test
@@ -0,0 +1,80 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+
+#include <stdio.h>
+#include "xcore_c.h"
+#include "debug_print.h"
+#include "xassert.h"
+
+#define CHANNELS 2
+#define FRAMES 4
+
+static i2s_t i2s;
+static i2s_buffer_t tx, rx;
+static uint32_t tx_mem[CHANNELS * FRAMES];
+static uint32_t rx_mem[CHANNELS * FRAMES];
+static volatile int running = 0;
+
+static uint32_t sample(int frame, int channel)
+{
+  return 0x12345678u * (frame + 1) + channel;
+}
+
+/*
+ * Run an I2S master with its data output looped back to its data input.
+ */
+void engine(void)
+{
+  clock c;
+  clock_alloc(&c, clock_1);
+  clock_set_source_clk_ref(c);
+  clock_set_divide(c, 8);
+
+  port p_bclk, p_lrclk, p_dout, p_din;
+  port_alloc(&p_dout, port_1A);
+  port_alloc(&p_din, port_1B);
+  port_alloc(&p_bclk, port_1C);
+  port_alloc(&p_lrclk, port_1D);
+
+  i2s_init_master(&i2s, I2S_MODE_I2S, CHANNELS, c, p_bclk, p_lrclk);
+  i2s_set_data_ports(&i2s, &p_dout, 1, &p_din, 1);
+
+  i2s_buffer_init(&tx, tx_mem, CHANNELS, FRAMES);
+  i2s_buffer_init(&rx, rx_mem, CHANNELS, FRAMES);
+  for (int f = 0; f < FRAMES; f++) {
+    uint32_t frame[CHANNELS] = {sample(f, 0), sample(f, 1)};
+    size_t written;
+    i2s_buffer_write(&tx, frame, &written);
+    xassert(written);
+  }
+  running = 1;
+
+  i2s_run(&i2s, &tx, &rx);
+  debug_printf("Engine stopped\n");
+
+  port_free(&p_dout);
+  port_free(&p_din);
+  port_free(&p_bclk);
+  port_free(&p_lrclk);
+  clock_free(&c);
+}
+
+void app(void)
+{
+  while (!running);
+
+  int match = 1;
+  for (int f = 0; f < FRAMES; f++) {
+    uint32_t frame[CHANNELS];
+    size_t read = 0;
+    while (!read) {
+      i2s_buffer_read(&rx, frame, &read);
+    }
+    for (int ch = 0; ch < CHANNELS; ch++) {
+      if (frame[ch] != sample(f, ch)) {
+        match = 0;
+      }
+    }
+  }
+  i2s_stop(&i2s);
+  debug_printf("Frames %s\n", match ? "match" : "do not match");
+}
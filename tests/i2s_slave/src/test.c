@@ -0,0 +1,192 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+
+#include "xcore_c.h"
+#include "debug_print.h"
+#include "xassert.h"
+
+/*
+ * A master and a slave exchanging frames, first in I2S mode and then in TDM
+ * mode. The slave is started while the master is already running, so it must
+ * find the start of a frame on the word clock to receive the frames intact.
+ * Last, the slave is started again after the master has stopped, and must
+ * still stop with no bit clock.
+ *
+ * Loopbacks: master bit clock 1C -> slave 1E, master word clock 1D -> slave 1F,
+ * master data out 1A -> slave data in 1B, slave data out 1G -> master data in 1H.
+ */
+
+#define MAX_CHANNELS 4
+#define FRAMES 4
+#define NUM_MODES 2
+#define GOOD_FRAMES 8
+#define MAX_FRAMES 200
+
+static const i2s_mode_t modes[NUM_MODES] = {I2S_MODE_I2S, I2S_MODE_TDM};
+static const size_t mode_channels[NUM_MODES] = {2, 4};
+static const char *const mode_names[NUM_MODES] = {"I2S", "TDM"};
+
+static i2s_t master, slave;
+static i2s_buffer_t master_tx, master_rx, slave_tx, slave_rx;
+static uint32_t master_tx_mem[MAX_CHANNELS * FRAMES];
+static uint32_t master_rx_mem[MAX_CHANNELS * FRAMES];
+static uint32_t slave_tx_mem[MAX_CHANNELS * FRAMES];
+static uint32_t slave_rx_mem[MAX_CHANNELS * FRAMES];
+
+// The number of modes each engine has started, and finished.
+static volatile int master_started = 0;
+static volatile int master_done = 0;
+static volatile int slave_started = 0;
+static volatile int slave_done = 0;
+
+// Each sample carries its frame number and channel, so a frame received out
+// of alignment is found.
+static uint32_t sample(uint32_t frame, size_t channel)
+{
+  return 0xA5000000u | ((frame & 0xFFFF) << 8) | channel;
+}
+
+void master_engine(void)
+{
+  for (int m = 0; m < NUM_MODES; m++) {
+    size_t channels = mode_channels[m];
+    clock c;
+    clock_alloc(&c, clock_1);
+    clock_set_source_clk_ref(c);
+    clock_set_divide(c, 8);
+
+    port p_bclk, p_lrclk, p_dout, p_din;
+    port_alloc(&p_dout, port_1A);
+    port_alloc(&p_bclk, port_1C);
+    port_alloc(&p_lrclk, port_1D);
+    port_alloc(&p_din, port_1H);
+
+    i2s_init_master(&master, modes[m], channels, c, p_bclk, p_lrclk);
+    i2s_set_data_ports(&master, &p_dout, 1, &p_din, 1);
+    i2s_buffer_init(&master_tx, master_tx_mem, channels, FRAMES);
+    i2s_buffer_init(&master_rx, master_rx_mem, channels, FRAMES);
+    master_started = m + 1;
+
+    i2s_run(&master, &master_tx, &master_rx);
+
+    port_free(&p_dout);
+    port_free(&p_bclk);
+    port_free(&p_lrclk);
+    port_free(&p_din);
+    clock_free(&c);
+    master_done = m + 1;
+  }
+}
+
+void slave_engine(void)
+{
+  for (int m = 0; m <= NUM_MODES; m++) {
+    // Join once the master is running, or for the last pass once it is done.
+    if (m < NUM_MODES) {
+      while (master_started != m + 1);
+    } else {
+      while (master_done != NUM_MODES);
+    }
+    size_t channels = mode_channels[m % NUM_MODES];
+    clock c;
+    clock_alloc(&c, clock_2);
+
+    port p_bclk, p_lrclk, p_dout, p_din;
+    port_alloc(&p_din, port_1B);
+    port_alloc(&p_bclk, port_1E);
+    port_alloc(&p_lrclk, port_1F);
+    port_alloc(&p_dout, port_1G);
+
+    i2s_init_slave(&slave, modes[m % NUM_MODES], channels, c, p_bclk, p_lrclk);
+    i2s_set_data_ports(&slave, &p_dout, 1, &p_din, 1);
+    i2s_buffer_init(&slave_tx, slave_tx_mem, channels, FRAMES);
+    i2s_buffer_init(&slave_rx, slave_rx_mem, channels, FRAMES);
+    slave_started = m + 1;
+
+    i2s_run(&slave, &slave_tx, &slave_rx);
+
+    clock_stop(c);
+    port_free(&p_din);
+    port_free(&p_bclk);
+    port_free(&p_lrclk);
+    port_free(&p_dout);
+    clock_free(&c);
+    slave_done = m + 1;
+  }
+}
+
+// Keep a buffer of frames to output full.
+static void feed(i2s_buffer_t *tx, size_t channels, uint32_t *next)
+{
+  uint32_t frame[MAX_CHANNELS];
+  for (size_t ch = 0; ch < channels; ch++) {
+    frame[ch] = sample(*next, ch);
+  }
+  size_t written;
+  i2s_buffer_write(tx, frame, &written);
+  *next += written;
+}
+
+// Check a frame received. Silence, output before the sender had frames
+// buffered or before the slave joined, is skipped.
+static void check(i2s_buffer_t *rx, size_t channels, int *good, int *received, int *match)
+{
+  uint32_t frame[MAX_CHANNELS];
+  size_t read;
+  i2s_buffer_read(rx, frame, &read);
+  if (!read) {
+    return;
+  }
+  (*received)++;
+  int silent = 1;
+  for (size_t ch = 0; ch < channels; ch++) {
+    silent &= frame[ch] == 0;
+  }
+  if (silent) {
+    return;
+  }
+  uint32_t number = (frame[0] >> 8) & 0xFFFF;
+  for (size_t ch = 0; ch < channels; ch++) {
+    if (frame[ch] != sample(number, ch)) {
+      *match = 0;
+    }
+  }
+  (*good)++;
+}
+
+void app(void)
+{
+  for (int m = 0; m < NUM_MODES; m++) {
+    while (slave_started != m + 1);
+    size_t channels = mode_channels[m];
+    uint32_t next_master = 0, next_slave = 0;
+    int good_master = 0, good_slave = 0;
+    int received_master = 0, received_slave = 0;
+    int match_master = 1, match_slave = 1;
+
+    while ((good_master < GOOD_FRAMES || good_slave < GOOD_FRAMES) &&
+           received_master < MAX_FRAMES && received_slave < MAX_FRAMES) {
+      feed(&master_tx, channels, &next_master);
+      feed(&slave_tx, channels, &next_slave);
+      check(&slave_rx, channels, &good_slave, &received_slave, &match_slave);
+      check(&master_rx, channels, &good_master, &received_master, &match_master);
+    }
+
+    // The slave needs the master's clocks to finish its frame.
+    i2s_stop(&slave);
+    while (slave_done != m + 1);
+    i2s_stop(&master);
+    while (master_done != m + 1);
+
+    debug_printf("%s master to slave: %s\n", mode_names[m],
+                 match_slave && good_slave >= GOOD_FRAMES ? "frames match" : "frames do not match");
+    debug_printf("%s slave to master: %s\n", mode_names[m],
+                 match_master && good_master >= GOOD_FRAMES ? "frames match" : "frames do not match");
+  }
+
+  // The slave waits for the start of a frame that never comes.
+  while (slave_started != NUM_MODES + 1);
+  hwtimer_core_delay(10000);
+  i2s_stop(&slave);
+  while (slave_done != NUM_MODES + 1);
+  debug_printf("Slave stopped without a bit clock\n");
+}
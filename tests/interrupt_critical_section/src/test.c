@@ -0,0 +1,77 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+
+#include <stdio.h>
+#include "xcore_c.h"
+#include "debug_print.h"
+#include "xassert.h"
+
+// Long enough for a pending timer interrupt to have been taken if unmasked
+static const int settle = 1000;
+
+typedef struct {
+  hwtimer_t t;
+  volatile int count;
+} hwtimer_data_t;
+
+DEFINE_INTERRUPT_CALLBACK(groupA, hwtimer_handler, data)
+{
+  hwtimer_data_t *td = (hwtimer_data_t*)data;
+  uint32_t time;
+  hwtimer_get_time(td->t, &time);
+  // Fire once only
+  hwtimer_disable_trigger(td->t);
+  td->count++;
+}
+
+static void arm(hwtimer_data_t *td)
+{
+  uint32_t time;
+  hwtimer_get_time(td->t, &time);
+  hwtimer_setup_interrupt_callback(td->t, time, td, INTERRUPT_CALLBACK(hwtimer_handler));
+  hwtimer_enable_trigger(td->t);
+}
+
+DEFINE_INTERRUPT_PERMITTED(groupA, void, test, void)
+{
+  hwtimer_t tmr;
+  hwtimer_alloc(&tmr);
+  hwtimer_data_t td1 = {0, 0};
+  hwtimer_data_t td2 = {0, 0};
+  hwtimer_alloc(&td1.t);
+  hwtimer_alloc(&td2.t);
+
+  // Nested critical sections only unmask on leaving the outermost
+  interrupt_mask_all();
+  arm(&td1);
+  interrupt_unmask_all();
+  hwtimer_delay(tmr, settle);
+  debug_printf("Unmasked count %d\n", td1.count);
+
+  interrupt_state_t outer, inner;
+  interrupt_mask_all_save(&outer);
+  arm(&td1);
+  interrupt_mask_all_save(&inner);
+  interrupt_restore(inner);
+  hwtimer_delay(tmr, settle);
+  debug_printf("Inner restored count %d\n", td1.count);
+  interrupt_restore(outer);
+  hwtimer_delay(tmr, settle);
+  debug_printf("Outer restored count %d\n", td1.count);
+
+  // Masking one resource does not hold off another
+  interrupt_mask_all();
+  arm(&td1);
+  arm(&td2);
+  interrupt_mask_resource(td1.t);
+  interrupt_unmask_all();
+  hwtimer_delay(tmr, settle);
+  debug_printf("Resource masked counts %d %d\n", td1.count, td2.count);
+  interrupt_unmask_resource(td1.t);
+  hwtimer_delay(tmr, settle);
+  debug_printf("Resource unmasked counts %d %d\n", td1.count, td2.count);
+
+  interrupt_mask_all();
+  hwtimer_free(&td1.t);
+  hwtimer_free(&td2.t);
+  hwtimer_free(&tmr);
+}
@@ -0,0 +1,29 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+
+#include "xcore_c.h"
+
+void core0(chanend c);
+void core1(chanend c);
+
+static channel_t c;
+
+static void run_core0(void *arg)
+{
+  core0(c.end_a);
+}
+
+static void run_core1(void *arg)
+{
+  core1(c.end_b);
+}
+
+int main()
+{
+  chan_alloc(&c);
+  static const host_core_t cores[] = {
+    { run_core0, NULL },
+    { run_core1, NULL },
+  };
+  host_par(cores, 2);
+  return 0;
+}
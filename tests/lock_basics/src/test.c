@@ -13,9 +13,11 @@ void core0(chanend c)
   lock_t l = 0;
   lock_alloc(&l);
   xassert(l);
-  chan_out_word(c, (uint32_t)l);
 
+  // Own the lock before core1 tries to acquire it
   lock_acquire(l);
+  chan_out_word(c, (uint32_t)l);
+  hwtimer_delay(tmr, 1000);
   debug_printf("Core0 owns the lock\n");
   hwtimer_delay(tmr, 100);
   debug_printf("Core0 done work\n");
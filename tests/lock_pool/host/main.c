@@ -0,0 +1,34 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+
+#include "xcore_c.h"
+
+void master(chanend c1, chanend c2, chanend c3);
+void worker(chanend c, int id);
+
+static channel_t c[3];
+
+static void run_master(void *arg)
+{
+  master(c[0].end_a, c[1].end_a, c[2].end_a);
+}
+
+static void run_worker(void *arg)
+{
+  int id = (int)(intptr_t)arg;
+  worker(c[id - 1].end_b, id);
+}
+
+int main()
+{
+  for (int i = 0; i < 3; i++) {
+    chan_alloc(&c[i]);
+  }
+  static const host_core_t cores[] = {
+    { run_master, NULL },
+    { run_worker, (void *)1 },
+    { run_worker, (void *)2 },
+    { run_worker, (void *)3 },
+  };
+  host_par(cores, 4);
+  return 0;
+}
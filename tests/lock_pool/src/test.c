@@ -0,0 +1,80 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+
+#include "xcore_c.h"
+#include "debug_print.h"
+#include "xassert.h"
+
+// More software locks than there are hardware locks on a tile.
+#define NUM_LOCKS 8
+#define NUM_CORES 4
+#define ITERATIONS 50
+#define UPDATE_INTERVAL 10
+
+static swlock_slot_t slots[NUM_LOCKS];
+static lock_pool_t pool;
+static swlock_t locks[NUM_LOCKS];
+static volatile uint32_t counts[NUM_LOCKS];
+
+static void work(int id)
+{
+  for (int i = 0; i < ITERATIONS; i++) {
+    for (int j = 0; j < NUM_LOCKS; j++) {
+      // Each core starts on a different lock.
+      int k = (j + id) % NUM_LOCKS;
+      swlock_acquire(locks[k]);
+      // Wait between reading and writing the count, so that another core
+      // which is not kept out by the lock updates it in between.
+      uint32_t count = counts[k];
+      hwtimer_core_delay(UPDATE_INTERVAL);
+      counts[k] = count + 1;
+      swlock_release(locks[k]);
+    }
+  }
+}
+
+void master(chanend c1, chanend c2, chanend c3)
+{
+  lock_pool_alloc(&pool, slots, NUM_LOCKS);
+  for (int i = 0; i < NUM_LOCKS; i++) {
+    swlock_alloc(&pool, &locks[i]);
+    xassert(locks[i]);
+  }
+  swlock_t extra;
+  swlock_alloc(&pool, &extra);
+  debug_printf("Pool exhausted: %d\n", extra == NULL);
+
+  // A freed lock may be allocated again.
+  swlock_free(&locks[0]);
+  xassert(!locks[0]);
+  swlock_alloc(&pool, &locks[0]);
+  debug_printf("Reallocated: %d\n", locks[0] != NULL);
+
+  chan_out_word(c1, 0);
+  chan_out_word(c2, 0);
+  chan_out_word(c3, 0);
+  work(0);
+  uint32_t dummy;
+  chan_in_word(c1, &dummy);
+  chan_in_word(c2, &dummy);
+  chan_in_word(c3, &dummy);
+
+  int correct = 1;
+  for (int i = 0; i < NUM_LOCKS; i++) {
+    correct &= counts[i] == NUM_CORES * ITERATIONS;
+  }
+  debug_printf("Counts correct: %d\n", correct);
+
+  for (int i = 0; i < NUM_LOCKS; i++) {
+    swlock_free(&locks[i]);
+  }
+  lock_pool_free(&pool);
+  debug_printf("Pool freed\n");
+}
+
+void worker(chanend c, int id)
+{
+  uint32_t dummy;
+  chan_in_word(c, &dummy);
+  work(id);
+  chan_out_word(c, 0);
+}
@@ -0,0 +1,34 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+
+#include "xcore_c.h"
+
+void writer(chanend c1, chanend c2, chanend c3);
+void reader(chanend c);
+
+static channel_t c[3];
+
+static void run_writer(void *arg)
+{
+  writer(c[0].end_a, c[1].end_a, c[2].end_a);
+}
+
+static void run_reader(void *arg)
+{
+  int id = (int)(intptr_t)arg;
+  reader(c[id - 1].end_b);
+}
+
+int main()
+{
+  for (int i = 0; i < 3; i++) {
+    chan_alloc(&c[i]);
+  }
+  static const host_core_t cores[] = {
+    { run_writer, NULL },
+    { run_reader, (void *)1 },
+    { run_reader, (void *)2 },
+    { run_reader, (void *)3 },
+  };
+  host_par(cores, 4);
+  return 0;
+}
@@ -0,0 +1,135 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+
+#include "xcore_c.h"
+#include "debug_print.h"
+#include "xassert.h"
+
+#define NUM_READERS 3
+#define TABLE_SIZE 8
+#define UPDATES 50
+#define READ_INTERVAL 20
+#define ENTRY_INTERVAL 10
+
+// Each update writes the same value to every entry of a table, so a reader
+// which sees different values has seen a partial update. The writer pauses
+// between entries so that a reader which is not kept out sees one.
+static volatile uint32_t table[TABLE_SIZE];
+static rwlock_t rw;
+static seqlock_t sl;
+
+static void update(uint32_t value)
+{
+  for (int i = 0; i < TABLE_SIZE; i++) {
+    table[i] = value;
+    hwtimer_core_delay(ENTRY_INTERVAL);
+  }
+}
+
+static int consistent(const uint32_t copy[])
+{
+  for (int i = 1; i < TABLE_SIZE; i++) {
+    if (copy[i] != copy[0]) {
+      return 0;
+    }
+  }
+  return 1;
+}
+
+static void copy_table(uint32_t copy[])
+{
+  for (int i = 0; i < TABLE_SIZE; i++) {
+    copy[i] = table[i];
+  }
+}
+
+static void report(chanend c[])
+{
+  for (int i = 0; i < NUM_READERS; i++) {
+    uint32_t good;
+    chan_in_word(c[i], &good);
+    debug_printf("Reader %d consistent: %d\n", i, good);
+  }
+}
+
+void writer(chanend c1, chanend c2, chanend c3)
+{
+  chanend c[NUM_READERS] = {c1, c2, c3};
+  lock_t guard;
+  lock_alloc(&guard);
+  rwlock_init(&rw, guard);
+  seqlock_init(&sl, guard);
+
+  for (int i = 0; i < NUM_READERS; i++) {
+    chan_out_word(c[i], 0);
+  }
+  for (uint32_t v = 1; v <= UPDATES; v++) {
+    rwlock_write_acquire(&rw);
+    update(v);
+    rwlock_write_release(&rw);
+  }
+  debug_printf("Reader-writer lock\n");
+  report(c);
+
+  for (int i = 0; i < NUM_READERS; i++) {
+    chan_out_word(c[i], 0);
+  }
+  for (uint32_t v = UPDATES + 1; v <= 2 * UPDATES; v++) {
+    seqlock_write_begin(&sl);
+    update(v);
+    seqlock_write_end(&sl);
+  }
+  debug_printf("Sequence lock\n");
+  report(c);
+
+  // Every reader holds the lock when it reports it is reading. Readers which
+  // excluded each other would never all report.
+  int sharing = 0;
+  for (int i = 0; i < NUM_READERS; i++) {
+    uint32_t reading;
+    chan_in_word(c[i], &reading);
+    sharing += reading;
+  }
+  debug_printf("Readers holding the lock at once: %d\n", sharing);
+  for (int i = 0; i < NUM_READERS; i++) {
+    chan_out_word(c[i], 0);
+  }
+
+  lock_free(&guard);
+}
+
+void reader(chanend c)
+{
+  uint32_t copy[TABLE_SIZE];
+  uint32_t dummy;
+  int good = 1;
+
+  chan_in_word(c, &dummy);
+  do {
+    rwlock_read_acquire(&rw);
+    copy_table(copy);
+    rwlock_read_release(&rw);
+    good &= consistent(copy);
+    hwtimer_core_delay(READ_INTERVAL);
+  } while (copy[0] != UPDATES);
+  chan_out_word(c, good);
+
+  good = 1;
+  chan_in_word(c, &dummy);
+  do {
+    uint32_t seq;
+    int retry;
+    do {
+      seqlock_read_begin(&sl, &seq);
+      copy_table(copy);
+      seqlock_read_retry(&sl, seq, &retry);
+    } while (retry);
+    good &= consistent(copy);
+    hwtimer_core_delay(READ_INTERVAL);
+  } while (copy[0] != 2 * UPDATES);
+  chan_out_word(c, good);
+
+  rwlock_read_acquire(&rw);
+  chan_out_word(c, 1);
+  chan_in_word(c, &dummy);
+  rwlock_read_release(&rw);
+}
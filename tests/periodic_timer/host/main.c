@@ -0,0 +1,19 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+
+#include "xcore_c.h"
+
+DECLARE_INTERRUPT_PERMITTED(void, test, void);
+
+static void run_test(void *arg)
+{
+  INTERRUPT_PERMITTED(test)();
+}
+
+int main()
+{
+  static const host_core_t cores[] = {
+    { run_test, NULL },
+  };
+  host_par(cores, 1);
+  return 0;
+}
@@ -0,0 +1,122 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+
+#include <stdio.h>
+#include "xcore_c.h"
+#include "debug_print.h"
+#include "xassert.h"
+
+static const uint32_t period = 10000;
+static const int num_events = 10;
+
+typedef enum {
+  EVENT_TICK = ENUM_ID_BASE,
+  EVENT_DONE,
+} event_choice_t;
+
+// The events handled by a callback, which must rearm the timer each time.
+typedef struct {
+  hwtimer_periodic_t pt;
+  volatile int count;
+  volatile uint32_t missed;
+} periodic_data_t;
+
+DEFINE_SELECT_CALLBACK(periodic_select_handler, data)
+{
+  periodic_data_t *pd = (periodic_data_t*)data;
+  uint32_t missed;
+  hwtimer_periodic_rearm(&pd->pt, &missed);
+  pd->missed += missed;
+  pd->count++;
+}
+
+DEFINE_INTERRUPT_CALLBACK(periodic_group, periodic_interrupt_handler, data)
+{
+  periodic_data_t *pd = (periodic_data_t*)data;
+  uint32_t missed;
+  hwtimer_periodic_rearm(&pd->pt, &missed);
+  pd->missed += missed;
+  pd->count++;
+}
+
+DEFINE_INTERRUPT_PERMITTED(periodic_group, void, test, void)
+{
+  hwtimer_t tmr, work_tmr;
+  hwtimer_alloc(&tmr);
+  xassert(tmr);
+  hwtimer_alloc(&work_tmr);
+  xassert(work_tmr);
+
+  select_disable_trigger_all();
+
+  uint32_t start, end;
+  hwtimer_get_time(work_tmr, &start);
+
+  hwtimer_periodic_t pt;
+  hwtimer_periodic_init(&pt, tmr, period);
+  hwtimer_periodic_setup_select(&pt, EVENT_TICK);
+  hwtimer_enable_trigger(tmr);
+
+  // Handling latency must not accumulate.
+  for (int i = 0; i < num_events; i++) {
+    event_choice_t choice = select_wait();
+    xassert(choice == EVENT_TICK);
+    hwtimer_delay(work_tmr, period / 2);
+    uint32_t missed;
+    hwtimer_periodic_rearm(&pt, &missed);
+    xassert(missed == 0);
+  }
+  hwtimer_get_time(work_tmr, &end);
+  uint32_t elapsed = end - start;
+  if (elapsed >= num_events * period && elapsed < (num_events + 1) * period) {
+    debug_printf("No drift\n");
+  } else {
+    debug_printf("Drift: elapsed %d\n", elapsed);
+  }
+
+  // Handling an event after several more deadlines have passed.
+  (void)select_wait();
+  hwtimer_delay(work_tmr, period * 3 + period / 2);
+  uint32_t missed;
+  hwtimer_periodic_rearm(&pt, &missed);
+  debug_printf("Missed %d\n", missed);
+  (void)select_wait();
+  hwtimer_periodic_rearm(&pt, &missed);
+  debug_printf("Missed %d\n", missed);
+  uint32_t overruns;
+  hwtimer_periodic_get_overruns(&pt, &overruns);
+  debug_printf("Overruns %d\n", overruns);
+
+  hwtimer_disable_trigger(tmr);
+
+  // A select callback rearming the timer, until a plain timer ends the loop.
+  static periodic_data_t pd;
+  pd.count = 0;
+  pd.missed = 0;
+  hwtimer_periodic_init(&pd.pt, tmr, period);
+  hwtimer_periodic_setup_select_callback(&pd.pt, &pd, SELECT_CALLBACK(periodic_select_handler));
+  hwtimer_enable_trigger(tmr);
+  hwtimer_get_time(work_tmr, &start);
+  hwtimer_setup_select(work_tmr, start + num_events * period + period / 2, EVENT_DONE);
+  hwtimer_enable_trigger(work_tmr);
+  event_choice_t choice = select_wait();
+  xassert(choice == EVENT_DONE);
+  hwtimer_disable_trigger(work_tmr);
+  hwtimer_disable_trigger(tmr);
+  debug_printf("Select callback events %d, missed %d\n", pd.count, pd.missed);
+
+  // An interrupt callback rearming the timer while the core waits.
+  pd.count = 0;
+  pd.missed = 0;
+  interrupt_mask_all();
+  hwtimer_periodic_init(&pd.pt, tmr, period);
+  hwtimer_periodic_setup_interrupt_callback(&pd.pt, &pd, INTERRUPT_CALLBACK(periodic_interrupt_handler));
+  hwtimer_enable_trigger(tmr);
+  interrupt_unmask_all();
+  hwtimer_delay(work_tmr, num_events * period + period / 2);
+  interrupt_mask_all();
+  hwtimer_disable_trigger(tmr);
+  debug_printf("Interrupt callback events %d, missed %d\n", pd.count, pd.missed);
+
+  hwtimer_free(&tmr);
+  hwtimer_free(&work_tmr);
+}
@@ -0,0 +1,21 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+
+#include "xcore_c.h"
+
+void test(void);
+
+static void run_test(void *arg)
+{
+  test();
+}
+
+int main()
+{
+  // The loopback wired up on the simulator by test_port_buf.py
+  host_port_connect(XS1_PORT_1A, XS1_PORT_1B);
+  static const host_core_t cores[] = {
+    { run_test, NULL },
+  };
+  host_par(cores, 1);
+  return 0;
+}
@@ -0,0 +1,69 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+
+#include <stdio.h>
+#include "xcore_c.h"
+#include "debug_print.h"
+#include "xassert.h"
+
+void test(void)
+{
+  port p_out, p_in;
+  port_alloc(&p_out, port_1A);
+  port_alloc(&p_in, port_1B);
+
+  uint32_t out[4] = {0, 1, 0, 1};
+  int16_t ts[4];
+  port_out_buf_timestamped(p_out, out, ts, 4);
+  int increasing = 1;
+  for (int i = 1; i < 4; i++) {
+    if ((int16_t)(ts[i] - ts[i - 1]) <= 0) {
+      increasing = 0;
+    }
+  }
+  debug_printf("Timestamps %s\n", increasing ? "increasing" : "not increasing");
+
+  // Allow the last output to reach the input pin.
+  hwtimer_core_delay(100);
+  uint32_t in[2];
+  port_in_buf(p_in, in, 2);
+  debug_printf("In %d %d\n", in[0], in[1]);
+
+  uint32_t shift_out[2] = {2, 3};
+  port_out_shift_right_buf(p_out, shift_out, 2);
+  debug_printf("Shifted out %d %d\n", shift_out[0], shift_out[1]);
+
+  hwtimer_core_delay(100);
+  uint32_t shift_in[2] = {0, 2};
+  port_in_shift_right_buf(p_in, shift_in, 2);
+  debug_printf("Shifted in 0x%x 0x%x\n", shift_in[0], shift_in[1]);
+
+  int16_t t0;
+  port_out(p_out, 0);
+  port_get_trigger_time(p_out, &t0);
+  uint32_t wave[3] = {1, 0, 1};
+  int16_t wave_ts[3] = {t0 + 50, t0 + 100, t0 + 150};
+  size_t missed;
+  port_out_buf_at_time(p_out, wave, wave_ts, 3, &missed);
+  int16_t t_end;
+  port_get_trigger_time(p_out, &t_end);
+  debug_printf("Missed %d, end %d\n", missed, (int16_t)(t_end - t0));
+
+  // The second value cannot be output at the same time as the first.
+  port_out(p_out, 0);
+  port_get_trigger_time(p_out, &t0);
+  wave_ts[0] = t0 + 50;
+  wave_ts[1] = t0 + 50;
+  port_out_buf_at_time(p_out, wave, wave_ts, 2, &missed);
+  debug_printf("Missed %d\n", missed);
+
+  // A deadline after the last output, but which the port's counter has passed.
+  port_out(p_out, 0);
+  port_get_trigger_time(p_out, &t0);
+  hwtimer_core_delay(200);
+  wave_ts[0] = t0 + 100;
+  port_out_buf_at_time(p_out, wave, wave_ts, 1, &missed);
+  debug_printf("Missed %d\n", missed);
+
+  port_free(&p_out);
+  port_free(&p_in);
+}
@@ -0,0 +1,42 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+
+#include <stdio.h>
+#include "xcore_c.h"
+#include "debug_print.h"
+#include "xassert.h"
+
+/*
+ * Drive a pulse out of a slowly clocked 32-bit buffered port and capture it
+ * on the looped back input port, which shares the same clock.
+ */
+void test(void)
+{
+  clock c;
+  clock_alloc(&c, clock_1);
+  clock_set_source_clk_ref(c);
+  clock_set_divide(c, 10);
+
+  port p_out, p_in;
+  port_alloc_buffered(&p_out, port_1A, 32);
+  port_set_clock(p_out, c);
+  port_alloc(&p_in, port_1B);
+  port_set_clock(p_in, c);
+  clock_start(c);
+
+  port_out(p_out, 0);
+  port_out(p_out, 0x0000ff00);
+
+  uint32_t value = 0;
+  port_edge_t edges[2];
+  port_capture_edges(p_in, &value, edges, 2);
+  debug_printf("Edges %d %d, width %d, value %d\n",
+               edges[0].value, edges[1].value,
+               (int16_t)(edges[1].time - edges[0].time), value);
+  // Each port clock tick is 20 reference clock ticks.
+  debug_printf("Reference width %d\n", (edges[1].ref_time - edges[0].ref_time + 10) / 20);
+
+  clock_stop(c);
+  port_free(&p_out);
+  port_free(&p_in);
+  clock_free(&c);
+}
@@ -0,0 +1,36 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+
+#include <stdio.h>
+#include "xcore_c.h"
+#include "debug_print.h"
+#include "xassert.h"
+
+static const port_config_t configs[2] = {
+  { PORT_CONFIG_BUFFERED, 8, 0, 0, 0 },
+  { PORT_CONFIG_INVERT, 0, 0, 0, 0 },
+};
+
+/*
+ * Configure a buffered output port and an inverting input port together,
+ * then check the looped back values are inverted.
+ */
+void test(void)
+{
+  port p[2];
+  port_alloc_buffered(&p[0], port_1A, 8);
+  port_alloc(&p[1], port_1B);
+
+  if (port_configure_group(p, configs, 2) == error_none) {
+    debug_printf("Configured\n");
+  }
+
+  uint32_t high, low;
+  port_out(p[0], 0xff);
+  port_in_when_pinseq(p[1], PORT_UNBUFFERED, 0, &high);
+  port_out(p[0], 0);
+  port_in_when_pinseq(p[1], PORT_UNBUFFERED, 1, &low);
+  debug_printf("Inverted %d %d\n", high, low);
+
+  port_free(&p[0]);
+  port_free(&p[1]);
+}
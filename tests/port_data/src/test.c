@@ -0,0 +1,45 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+
+#include <stdio.h>
+#include "xcore_c.h"
+#include "debug_print.h"
+#include "xassert.h"
+
+void test(void)
+{
+  uint32_t data = 0x00000001;
+  port_data_bitrev(&data);
+  debug_printf("Reversed 0x%x\n", data);
+
+  // Lane k has only bit k set, so transfer k drives pin k alone.
+  uint32_t lanes_4[4] = {0x1, 0x2, 0x4, 0x8};
+  uint32_t data_4[4];
+  port_data_zip_4(lanes_4, data_4);
+  debug_printf("Zip 4: 0x%x 0x%x 0x%x 0x%x\n", data_4[0], data_4[1], data_4[2], data_4[3]);
+  uint32_t unzipped_4[4];
+  port_data_unzip_4(data_4, unzipped_4);
+  int ok = 1;
+  for (int i = 0; i < 4; i++) {
+    if (unzipped_4[i] != lanes_4[i]) {
+      ok = 0;
+    }
+  }
+  debug_printf("Unzip 4 %s\n", ok ? "matches" : "does not match");
+
+  uint32_t lanes_8[8];
+  for (int i = 0; i < 8; i++) {
+    lanes_8[i] = 0x12345678u * (i + 1);
+  }
+  uint32_t data_8[8];
+  port_data_zip_8(lanes_8, data_8);
+  debug_printf("Zip 8: 0x%x\n", data_8[0]);
+  uint32_t unzipped_8[8];
+  port_data_unzip_8(data_8, unzipped_8);
+  ok = 1;
+  for (int i = 0; i < 8; i++) {
+    if (unzipped_8[i] != lanes_8[i]) {
+      ok = 0;
+    }
+  }
+  debug_printf("Unzip 8 %s\n", ok ? "matches" : "does not match");
+}
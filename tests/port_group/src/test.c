@@ -0,0 +1,42 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+
+#include <stdio.h>
+#include "xcore_c.h"
+#include "debug_print.h"
+#include "xassert.h"
+
+/*
+ * Start two buffered output lanes together at a port timestamp and check the
+ * looped back edges are the expected number of clocks apart.
+ */
+void test(void)
+{
+  clock c;
+  clock_alloc(&c, clock_1);
+  clock_set_source_clk_ref(c);
+  clock_set_divide(c, 10);
+
+  port p[4];
+  port_alloc_buffered(&p[0], port_1A, 32);
+  port_alloc_buffered(&p[1], port_1C, 32);
+  port_alloc(&p[2], port_1B);
+  port_alloc(&p[3], port_1D);
+  port_protocol_group_setup(p, 4, c);
+
+  const uint32_t first[2] = { 0x0000ff00, 0x00ff0000 };
+  port_protocol_group_start_at_time(p, first, 2, c, 100);
+
+  uint32_t data;
+  int16_t t0, t1;
+  port_in_when_pinseq(p[2], PORT_UNBUFFERED, 1, &data);
+  port_get_trigger_time(p[2], &t0);
+  port_in_when_pinseq(p[3], PORT_UNBUFFERED, 1, &data);
+  port_get_trigger_time(p[3], &t1);
+  debug_printf("Lanes aligned, offset %d\n", (int16_t)(t1 - t0));
+
+  clock_stop(c);
+  for (size_t i = 0; i < 4; i++) {
+    port_free(&p[i]);
+  }
+  clock_free(&c);
+}
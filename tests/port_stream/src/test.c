@@ -0,0 +1,51 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+
+#include <stdio.h>
+#include "xcore_c.h"
+#include "debug_print.h"
+#include "xassert.h"
+
+#define WORDS 4
+#define BUFS 2
+
+static uint32_t buffers[WORDS * BUFS];
+
+void producer(chanend c)
+{
+  port p;
+  port_alloc_buffered(&p, port_1A, 32);
+
+  port_stream_t s;
+  port_stream_init(&s, p, buffers, WORDS, BUFS, s_chanend_convert(c));
+  chan_out_word(c, (uint32_t)&s);
+  port_stream_in(&s);
+  uint32_t ack;
+  chan_in_word(c, &ack);
+
+  port_free(&p);
+  debug_printf("Producer done\n");
+}
+
+void consumer(chanend c)
+{
+  uint32_t addr;
+  chan_in_word(c, &addr);
+  port_stream_t *s = (port_stream_t*)addr;
+
+  int count = 0;
+  int in_order = 1;
+  uint32_t *buf;
+  port_stream_get_buffer(s_chanend_convert(c), &buf);
+  while (buf) {
+    if (buf != &buffers[(count % BUFS) * WORDS]) {
+      in_order = 0;
+    }
+    if (++count == 3) {
+      port_stream_stop(s);
+    }
+    port_stream_get_buffer(s_chanend_convert(c), &buf);
+  }
+  xassert(count >= 3);
+  debug_printf("Buffers %s\n", in_order ? "in order" : "out of order");
+  chan_out_word(c, 0);
+}
@@ -0,0 +1,38 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+
+#include <stdio.h>
+#include "xcore_c.h"
+#include "debug_print.h"
+
+#define WORDS 4
+
+static volatile int received;
+
+DEFINE_INTERRUPT_CALLBACK(consumer_group, consumer_handler, data)
+{
+  uint32_t x;
+  chan_in_word(*(chanend *)data, &x);
+  received++;
+}
+
+DEFINE_INTERRUPT_PERMITTED(consumer_group, void, consumer, chanend c)
+{
+  chanend_setup_interrupt_callback(c, &c, INTERRUPT_CALLBACK(consumer_handler));
+  chanend_enable_trigger(c);
+  interrupt_unmask_all();
+  while (received < WORDS);
+  interrupt_mask_all();
+  chanend_disable_trigger(c);
+  debug_printf("Received %d words\n", received);
+}
+
+void producer(chanend c)
+{
+  hwtimer_t tmr;
+  hwtimer_alloc(&tmr);
+  for (int i = 0; i < WORDS; i++) {
+    hwtimer_delay(tmr, 1000);
+    chan_out_word(c, i);
+  }
+  hwtimer_free(&tmr);
+}
@@ -0,0 +1,29 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+
+#include "xcore_c.h"
+
+void test(chanend to_racer);
+void racer(chanend c);
+
+static channel_t c;
+
+static void run_test(void *arg)
+{
+  test(c.end_a);
+}
+
+static void run_racer(void *arg)
+{
+  racer(c.end_b);
+}
+
+int main()
+{
+  chan_alloc(&c);
+  static const host_core_t cores[] = {
+    { run_test, NULL },
+    { run_racer, NULL },
+  };
+  host_par(cores, 2);
+  return 0;
+}
@@ -0,0 +1,117 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+
+#include "xcore_c.h"
+#include "debug_print.h"
+#include "xassert.h"
+
+static void print_fault(const char *name, xcore_c_error_t error, resource_t misused)
+{
+  track_fault_t fault;
+  resource_t r;
+  track_get_fault(&fault, &r);
+  debug_printf("%s: error %d fault %d on it %d\n", name, error, fault, r == misused);
+}
+
+// The rounds in which two logical cores free the same lock.
+#define RACES 100
+
+/*
+ * Free each lock sent by test() at the same time as it does, and send back
+ * whether the free failed.
+ */
+void racer(chanend c)
+{
+  for (;;) {
+    uint32_t r;
+    chan_in_word(c, &r);
+    if (!r) {
+      break;
+    }
+    lock_t l = r;
+    xcore_c_error_t error = lock_free(&l);
+    chan_out_word(c, error);
+  }
+}
+
+void test(chanend to_racer)
+{
+  xcore_c_error_t error;
+  track_mark_t mark;
+  resource_t leak;
+
+  // Resources left allocated are leaks.
+  track_mark(&mark);
+  channel_t c;
+  chan_alloc(&c);
+  hwtimer_t tmr;
+  hwtimer_alloc(&tmr);
+  lock_t l;
+  lock_alloc(&l);
+  port p;
+  port_alloc(&p, port_1A);
+  lock_free(&l);
+  hwtimer_free(&tmr);
+  track_get_leak(&mark, &leak);
+  debug_printf("Leak: chanend %d\n", leak == c.end_a);
+  chan_free(&c);
+  track_get_leak(&mark, &leak);
+  debug_printf("Leak: port %d\n", leak == p);
+  port_free(&p);
+  track_get_leak(&mark, &leak);
+  debug_printf("Leak: none %d\n", leak == 0);
+
+  // Freeing twice.
+  lock_alloc(&l);
+  lock_t freed = l;
+  lock_free(&l);
+  l = freed;
+  error = lock_free(&l);
+  print_fault("Double free", error, freed);
+
+  // Using after free.
+  chan_alloc(&c);
+  chanend end = c.end_b;
+  chan_free(&c);
+  ERROR_SCOPE(error, {
+    chan_out_word(end, 0);
+  });
+  print_fault("Use after free", error, end);
+
+  // Running out, and using the null resource.
+  lock_t locks[5];
+  for (int i = 0; i < 5; i++) {
+    lock_alloc(&locks[i]);
+  }
+  uint32_t exhausted;
+  track_get_exhausted(XS1_RES_TYPE_LOCK, &exhausted);
+  debug_printf("Exhausted: %d\n", exhausted);
+  ERROR_SCOPE(error, {
+    lock_acquire(locks[4]);
+  });
+  print_fault("Use of null", error, 0);
+  for (int i = 0; i < 4; i++) {
+    lock_free(&locks[i]);
+  }
+
+  // A resource allocated again may be used.
+  hwtimer_alloc(&tmr);
+  uint32_t now;
+  error = hwtimer_get_time(tmr, &now);
+  hwtimer_free(&tmr);
+  debug_printf("Reallocated: error %d\n", error);
+
+  // Of two logical cores freeing a resource at once, one frees it and the
+  // other finds a double free.
+  int single = 0;
+  for (int i = 0; i < RACES; i++) {
+    lock_alloc(&l);
+    chan_out_word(to_racer, l);
+    error = lock_free(&l);
+    uint32_t other;
+    chan_in_word(to_racer, &other);
+    single += (error == error_none && other == error_ecall) ||
+              (error == error_ecall && other == error_none);
+  }
+  chan_out_word(to_racer, 0);
+  debug_printf("Racing frees: %d of %d found one double free\n", single, RACES);
+}
@@ -0,0 +1,43 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+
+#include "xcore_c.h"
+
+void channel_example_fair(chanend c, chanend d);
+
+static channel_t c, d;
+
+static void run_receiver(void *arg)
+{
+  // On the xCORE both senders have output their first word by the time the
+  // receiver has set up its events; don't leave that to the scheduler.
+  hwtimer_core_delay(100);
+  channel_example_fair(c.end_a, d.end_a);
+}
+
+// The test data provided by the par in main.xc.
+static void send_c(void *arg)
+{
+  for (int i = 0; i < 5; i++) {
+    chan_out_word(c.end_b, 555 + i);
+  }
+}
+
+static void send_d(void *arg)
+{
+  for (int i = 0; i < 5; i++) {
+    chan_out_word(d.end_b, 333 + i);
+  }
+}
+
+int main()
+{
+  chan_alloc(&c);
+  chan_alloc(&d);
+  static const host_core_t cores[] = {
+    { run_receiver, NULL },
+    { send_c, NULL },
+    { send_d, NULL },
+  };
+  host_par(cores, 3);
+  return 0;
+}
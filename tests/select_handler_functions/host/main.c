@@ -0,0 +1,51 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+
+#include "xcore_c.h"
+
+void test(chanend c, chanend d);
+
+static const int num_tests = 3;
+
+static channel_t c, d;
+
+static void run_test(void *arg)
+{
+  // On the xCORE both senders have output their first word by the time the
+  // receiver has set up its events; don't leave that to the scheduler.
+  hwtimer_core_delay(100);
+  test(c.end_a, d.end_a);
+}
+
+// The test data provided by the par in main.xc.
+static void send(chanend e, int base)
+{
+  for (int test = 0; test < num_tests; ++test) {
+    for (int i = 0; i < 5; i++) {
+      chan_out_word(e, base*test + i);
+      hwtimer_core_delay(5000 * i);
+    }
+  }
+}
+
+static void send_c(void *arg)
+{
+  send(c.end_b, 555);
+}
+
+static void send_d(void *arg)
+{
+  send(d.end_b, 333);
+}
+
+int main()
+{
+  chan_alloc(&c);
+  chan_alloc(&d);
+  static const host_core_t cores[] = {
+    { run_test, NULL },
+    { send_c, NULL },
+    { send_d, NULL },
+  };
+  host_par(cores, 3);
+  return 0;
+}
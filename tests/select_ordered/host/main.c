@@ -0,0 +1,72 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+
+#include "xcore_c.h"
+
+extern const int events_per_resource;
+
+void channel_first(chanend c, chanend d);
+void hwtimer_first(chanend c, chanend d);
+
+static channel_t c, d;
+
+// On the xCORE the instructions between reading the time and the first select
+// take longer than the 10 ticks until the timer's first event, and both
+// senders have output their first word, so every resource is ready at once.
+// Here they take no time, so each par makes ready first the resource which
+// should be taken first. Every later event finds them all ready, because each
+// print takes longer than the senders and the timer need.
+//
+// In the second par the receiver's timer fires 10 ticks after the print of its
+// order, which takes XCORE_C_HOST_PRINT_TICKS, so the senders start half way
+// through the print of the first timer event.
+static void run_channel_first(void *arg)
+{
+  hwtimer_core_delay(100);
+  channel_first(c.end_a, d.end_a);
+}
+
+static void run_hwtimer_first(void *arg)
+{
+  hwtimer_first(c.end_a, d.end_a);
+}
+
+// The test data provided by the pars in main.xc.
+static void send_c(void *arg)
+{
+  if (arg) {
+    hwtimer_core_delay(XCORE_C_HOST_PRINT_TICKS * 3 / 2);
+  }
+  for (int i = 0; i < events_per_resource; i++) {
+    chan_out_word(c.end_b, 555 + i);
+  }
+}
+
+static void send_d(void *arg)
+{
+  if (arg) {
+    hwtimer_core_delay(XCORE_C_HOST_PRINT_TICKS * 3 / 2);
+  }
+  for (int i = 0; i < events_per_resource; i++) {
+    chan_out_word(d.end_b, 333 + i);
+  }
+}
+
+int main()
+{
+  static int late = 1;
+  chan_alloc(&c);
+  chan_alloc(&d);
+  static const host_core_t channel_cores[] = {
+    { run_channel_first, NULL },
+    { send_c, NULL },
+    { send_d, NULL },
+  };
+  host_par(channel_cores, 3);
+  static const host_core_t hwtimer_cores[] = {
+    { run_hwtimer_first, NULL },
+    { send_c, &late },
+    { send_d, &late },
+  };
+  host_par(hwtimer_cores, 3);
+  return 0;
+}
@@ -0,0 +1,13 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+
+#include "xcore_c.h"
+
+void port_example();
+
+int main()
+{
+  // The loopback set up by test_select_port.py
+  host_port_connect(XS1_PORT_1B, XS1_PORT_1A);
+  port_example();
+  return 0;
+}
@@ -0,0 +1,55 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+
+#include "xcore_c.h"
+
+void channel_example(chanend c, chanend d);
+
+static channel_t c, d;
+
+static void run_receiver(void *arg)
+{
+  // On the xCORE both senders have output their first word by the time the
+  // receiver has set up its events; don't leave that to the scheduler.
+  hwtimer_core_delay(100);
+  channel_example(c.end_a, d.end_a);
+}
+
+// The send_data() of main.xc.
+static void send_data(chanend e, int v, int delta)
+{
+  hwtimer_t tmr;
+  hwtimer_alloc(&tmr);
+  uint32_t time, now;
+  hwtimer_get_time(tmr, &time);
+  time += delta;
+  for (int i = 0; i < 5; i++) {
+    // Provide test data
+    chan_out_word(e, v + i);
+    time += 20000;
+    hwtimer_wait_until(tmr, time, &now);
+  }
+  hwtimer_free(&tmr);
+}
+
+static void send_c(void *arg)
+{
+  send_data(c.end_b, 555, 0);
+}
+
+static void send_d(void *arg)
+{
+  send_data(d.end_b, 333, 10);
+}
+
+int main()
+{
+  chan_alloc(&c);
+  chan_alloc(&d);
+  static const host_core_t cores[] = {
+    { run_receiver, NULL },
+    { send_c, NULL },
+    { send_d, NULL },
+  };
+  host_par(cores, 3);
+  return 0;
+}
@@ -0,0 +1,64 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+
+#include <stdio.h>
+#include "xcore_c.h"
+#include "debug_print.h"
+#include "xassert.h"
+
+#define WORDS 64
+
+static uint32_t out[WORDS];
+static uint32_t in[WORDS];
+
+/*
+ * Measure the data rate achieved by an SPI master for each clock divide,
+ * with its MOSI looped back to its MISO. Divide 0 leaves the reference clock
+ * undivided, for the fastest 50MHz bit clock.
+ */
+void test(void)
+{
+  clock clk_sclk, clk_data;
+  clock_alloc(&clk_sclk, clock_1);
+  clock_alloc(&clk_data, clock_2);
+  clock_set_source_clk_ref(clk_sclk);
+
+  port p_sclk, p_mosi, p_miso;
+  port_alloc(&p_sclk, port_1A);
+  port_alloc(&p_mosi, port_1B);
+  port_alloc(&p_miso, port_1C);
+
+  spi_master_t spi;
+  spi_master_init(&spi, clk_sclk, clk_data, p_sclk, p_mosi, p_miso);
+
+  for (int i = 0; i < WORDS; i++) {
+    out[i] = 0x12345678u * (i + 1);
+  }
+
+  for (int divide = 0; divide <= 16; divide = divide ? divide * 2 : 1) {
+    clock_stop(clk_sclk);
+    clock_set_divide(clk_sclk, divide);
+    clock_start(clk_sclk);
+
+    uint32_t start, end;
+    hwtimer_core_get_time(&start);
+    spi_master_transfer_words(&spi, out, in, WORDS);
+    hwtimer_core_get_time(&end);
+
+    int match = 1;
+    for (int i = 0; i < WORDS; i++) {
+      if (in[i] != out[i]) {
+        match = 0;
+      }
+    }
+    // Tenths of a Mbit/s, from the 100MHz reference clock ticks.
+    uint32_t rate = (WORDS * 32 * 1000) / (end - start);
+    debug_printf("Divide %d: %d.%d Mbit/s, data %s\n", divide, rate / 10, rate % 10,
+                 match ? "matches" : "does not match");
+  }
+
+  port_free(&p_sclk);
+  port_free(&p_mosi);
+  port_free(&p_miso);
+  clock_free(&clk_sclk);
+  clock_free(&clk_data);
+}
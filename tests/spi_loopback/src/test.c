@@ -0,0 +1,144 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+
+#include "xcore_c.h"
+#include "debug_print.h"
+#include "xassert.h"
+
+/*
+ * An SPI master and slave exchanging words and then bytes.
+ *
+ * Loopbacks: master SCLK 1A -> slave 1D, master MOSI 1B -> slave 1E,
+ * slave MISO 1F -> master 1C.
+ */
+
+#define WORDS 4
+#define BYTES 8
+
+// Time for the slave to be waiting for the bit clock.
+#define SLAVE_READY_TICKS 1000
+
+static uint32_t master_word(int i)
+{
+  return 0x12345678u * (i + 1);
+}
+
+static uint32_t slave_word(int i)
+{
+  return 0x9ABCDEF0u ^ (i << 4);
+}
+
+static uint8_t master_byte(int i)
+{
+  return 0xA5 + 3 * i;
+}
+
+static uint8_t slave_byte(int i)
+{
+  return 0x3C ^ (i << 1);
+}
+
+static void print_match(const char *what, int match)
+{
+  debug_printf("%s %s\n", what, match ? "match" : "do not match");
+}
+
+void master(chanend c)
+{
+  clock clk_sclk, clk_data;
+  clock_alloc(&clk_sclk, clock_1);
+  clock_alloc(&clk_data, clock_2);
+  clock_set_source_clk_ref(clk_sclk);
+  clock_set_divide(clk_sclk, 4);
+
+  port p_sclk, p_mosi, p_miso;
+  port_alloc(&p_sclk, port_1A);
+  port_alloc(&p_mosi, port_1B);
+  port_alloc(&p_miso, port_1C);
+
+  spi_master_t spi;
+  spi_master_init(&spi, clk_sclk, clk_data, p_sclk, p_mosi, p_miso);
+
+  uint32_t ready;
+  uint32_t out_words[WORDS], in_words[WORDS];
+  for (int i = 0; i < WORDS; i++) {
+    out_words[i] = master_word(i);
+  }
+  chan_in_word(c, &ready);
+  hwtimer_core_delay(SLAVE_READY_TICKS);
+  spi_master_transfer_words(&spi, out_words, in_words, WORDS);
+  int words_match = 1;
+  for (int i = 0; i < WORDS; i++) {
+    words_match &= in_words[i] == slave_word(i);
+  }
+
+  uint8_t out_bytes[BYTES], in_bytes[BYTES];
+  for (int i = 0; i < BYTES; i++) {
+    out_bytes[i] = master_byte(i);
+  }
+  chan_in_word(c, &ready);
+  hwtimer_core_delay(SLAVE_READY_TICKS);
+  spi_master_transfer_bytes(&spi, out_bytes, in_bytes, BYTES);
+  int bytes_match = 1;
+  for (int i = 0; i < BYTES; i++) {
+    bytes_match &= in_bytes[i] == slave_byte(i);
+  }
+
+  // Report after the slave has.
+  chan_in_word(c, &ready);
+  print_match("Slave words to master", words_match);
+  print_match("Slave bytes to master", bytes_match);
+
+  port_free(&p_sclk);
+  port_free(&p_mosi);
+  port_free(&p_miso);
+  clock_stop(clk_sclk);
+  clock_stop(clk_data);
+  clock_free(&clk_sclk);
+  clock_free(&clk_data);
+}
+
+void slave(chanend c)
+{
+  clock clk;
+  clock_alloc(&clk, clock_3);
+
+  port p_sclk, p_mosi, p_miso;
+  port_alloc(&p_sclk, port_1D);
+  port_alloc(&p_mosi, port_1E);
+  port_alloc(&p_miso, port_1F);
+
+  spi_slave_t spi;
+  spi_slave_init(&spi, clk, p_sclk, p_mosi, p_miso);
+
+  uint32_t out_words[WORDS], in_words[WORDS];
+  for (int i = 0; i < WORDS; i++) {
+    out_words[i] = slave_word(i);
+  }
+  chan_out_word(c, 0);
+  spi_slave_transfer_words(&spi, out_words, in_words, WORDS);
+  int words_match = 1;
+  for (int i = 0; i < WORDS; i++) {
+    words_match &= in_words[i] == master_word(i);
+  }
+
+  uint8_t out_bytes[BYTES], in_bytes[BYTES];
+  for (int i = 0; i < BYTES; i++) {
+    out_bytes[i] = slave_byte(i);
+  }
+  chan_out_word(c, 0);
+  spi_slave_transfer_bytes(&spi, out_bytes, in_bytes, BYTES);
+  int bytes_match = 1;
+  for (int i = 0; i < BYTES; i++) {
+    bytes_match &= in_bytes[i] == master_byte(i);
+  }
+
+  print_match("Master words to slave", words_match);
+  print_match("Master bytes to slave", bytes_match);
+  chan_out_word(c, 0);
+
+  port_free(&p_sclk);
+  port_free(&p_mosi);
+  port_free(&p_miso);
+  clock_stop(clk);
+  clock_free(&clk);
+}
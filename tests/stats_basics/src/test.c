@@ -0,0 +1,102 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+
+#include <stdio.h>
+#include "xcore_c.h"
+#include "debug_print.h"
+#include "xassert.h"
+
+static const uint32_t period = 10000;
+
+typedef enum {
+  EVENT_TIMER = ENUM_ID_BASE,
+} event_choice_t;
+
+typedef struct {
+  hwtimer_t t[2];
+  int count;
+} shared_t;
+
+// The timers fire in turn, each taking one event and half a period to handle.
+DEFINE_SELECT_CALLBACK(handle_shared, data)
+{
+  shared_t *shared = (shared_t*)data;
+  hwtimer_disable_trigger(shared->t[shared->count++]);
+  hwtimer_core_delay(period / 2);
+}
+
+void test(void)
+{
+  static stats_table_t table;
+  stats_start(&table);
+
+  streaming_channel_t c;
+  s_chan_alloc(&c);
+  uint32_t out[3] = {1, 2, 3}, in[3];
+  s_chan_out_buf_word(c.end_a, out, 3);
+  s_chan_in_buf_word(c.end_b, in, 3);
+  s_chan_out_byte(c.end_a, 4);
+  uint8_t b;
+  s_chan_in_byte(c.end_b, &b);
+
+  hwtimer_t tmr;
+  hwtimer_alloc(&tmr);
+  select_disable_trigger_all();
+  uint32_t now;
+  hwtimer_get_time(tmr, &now);
+  hwtimer_setup_select(tmr, now + period, EVENT_TIMER);
+  hwtimer_enable_trigger(tmr);
+  for (int i = 0; i < 2; i++) {
+    event_choice_t choice = select_wait();
+    xassert(choice == EVENT_TIMER);
+    hwtimer_get_time(tmr, &now);
+    hwtimer_change_trigger_time(tmr, now + period);
+  }
+
+  // Timers sharing their callback data are counted separately, and the time
+  // spent in the callbacks is not counted as blocked.
+  static shared_t shared;
+  hwtimer_alloc(&shared.t[0]);
+  hwtimer_alloc(&shared.t[1]);
+  hwtimer_get_time(tmr, &now);
+  for (int i = 0; i < 2; i++) {
+    hwtimer_setup_select_callback(shared.t[i], now + (i + 1) * period, &shared,
+                                  SELECT_CALLBACK(handle_shared));
+    hwtimer_enable_trigger(shared.t[i]);
+  }
+  hwtimer_change_trigger_time(tmr, now + 3 * period);
+  event_choice_t choice = select_wait();
+  xassert(choice == EVENT_TIMER);
+  hwtimer_disable_trigger(tmr);
+
+  stats_stop();
+  s_chan_out_word(c.end_a, 5); // Not recorded.
+  uint32_t x;
+  s_chan_in_word(c.end_b, &x);
+
+  size_t count, untracked;
+  stats_get_count(&table, &count, &untracked);
+  debug_printf("Count %d untracked %d\n", count, untracked);
+
+  stats_entry_t e;
+  stats_get_resource(&table, c.end_a, &e);
+  debug_printf("Chan-end a events %d transfers %d\n", e.events, e.transfers);
+  stats_get_resource(&table, c.end_b, &e);
+  debug_printf("Chan-end b events %d transfers %d\n", e.events, e.transfers);
+  stats_get_resource(&table, tmr, &e);
+  debug_printf("Timer events %d transfers %d\n", e.events, e.transfers);
+  // Waits of one period, one period and half a period.
+  if (e.blocked >= 2 * period && e.blocked < 3 * period) {
+    debug_printf("Timer blocked ok\n");
+  } else {
+    debug_printf("Timer blocked %d\n", e.blocked);
+  }
+  for (int i = 0; i < 2; i++) {
+    stats_get_resource(&table, shared.t[i], &e);
+    debug_printf("Shared data timer %d events %d\n", i, e.events);
+  }
+  hwtimer_free(&shared.t[0]);
+  hwtimer_free(&shared.t[1]);
+
+  hwtimer_free(&tmr);
+  s_chan_free(&c);
+}
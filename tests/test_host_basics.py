@@ -0,0 +1,17 @@
+#!/usr/bin/env python
+import xmostest
+import os
+
+def runtest():
+    test_name = os.path.splitext(os.path.basename(__file__).replace("test_", "", 1))[0]
+
+    # Built natively with the host backend, see host_basics/Makefile
+    binary = '{}/bin/{}'.format(test_name, test_name)
+
+    tester = xmostest.ComparisonTester(open('{}.expect'.format(test_name)),
+                                     'lib_xcore_c', 'xcore_c_tests',
+                                     test_name)
+
+    tester.set_min_testlevel("smoke")
+
+    xmostest.run_on_pc([binary], tester=tester)
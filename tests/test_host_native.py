@@ -0,0 +1,29 @@
+#!/usr/bin/env python
+import xmostest
+import glob
+import os
+import subprocess
+
+def run(test_name, sim):
+    # Built natively with the host backend, see host_test.mk
+    subprocess.check_call(['make', '-C', os.path.join(test_name, 'host'),
+                           'HOST_SIM={}'.format(sim)])
+
+    variant = '_sim' if sim else ''
+    binary = '{}/bin/host/{}{}'.format(test_name, test_name, variant)
+
+    tester = xmostest.ComparisonTester(open('{}.expect'.format(test_name)),
+                                     'lib_xcore_c', 'xcore_c_tests',
+                                     "{}_host{}".format(test_name, variant))
+
+    tester.set_min_testlevel("smoke")
+
+    xmostest.run_on_pc([binary], tester=tester)
+
+def runtest():
+    # Each test with a host/ directory also runs natively, on threads and
+    # with the deterministic scheduler.
+    for makefile in sorted(glob.glob('*/host/Makefile')):
+        test_name = makefile.split(os.sep)[0]
+        run(test_name, 0)
+        run(test_name, 1)
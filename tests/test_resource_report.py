@@ -0,0 +1,24 @@
+#!/usr/bin/env python
+import xmostest
+import os
+
+def run(arch):
+    test_name = os.path.splitext(os.path.basename(__file__).replace("test_", "", 1))[0]
+
+    binary = '{}/bin/{}/{}_{}.xe'.format(test_name, arch, test_name, arch)
+
+    tester = xmostest.ComparisonTester(open('{}.expect'.format(test_name)),
+                                     'lib_xcore_c', 'xcore_c_tests',
+                                     "{}_{}".format(test_name, arch),
+                                     regexp=True)
+
+    tester.set_min_testlevel("smoke")
+
+    # The report is made from the built image, which is not run.
+    xmostest.run_on_pc(['python', '../lib_xcore_c/host/xcore_c_resource_report.py',
+                        binary, '-a', arch, '-t', 'consumer', '-t', 'producer'],
+                       tester=tester)
+
+def runtest():
+    run("XS1")
+    run("XS2")
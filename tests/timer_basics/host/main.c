@@ -0,0 +1,29 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+
+#include "xcore_c.h"
+
+void fast(chanend c);
+void slow(chanend c);
+
+static channel_t c;
+
+static void run_fast(void *arg)
+{
+  fast(c.end_a);
+}
+
+static void run_slow(void *arg)
+{
+  slow(c.end_b);
+}
+
+int main()
+{
+  chan_alloc(&c);
+  static const host_core_t cores[] = {
+    { run_fast, NULL },
+    { run_slow, NULL },
+  };
+  host_par(cores, 2);
+  return 0;
+}
@@ -0,0 +1,57 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+
+#include <stdio.h>
+#include "xcore_c.h"
+#include "debug_print.h"
+#include "xassert.h"
+
+static const uint32_t period = 1000;
+
+// Allow for the cost of the calls which has not been calibrated out
+static const uint32_t tolerance = 100;
+
+static void check(const char *name, uint32_t start, uint32_t end)
+{
+  uint32_t elapsed = end - start;
+  if (elapsed >= period && elapsed < period + tolerance) {
+    debug_printf("%s ok\n", name);
+  } else {
+    debug_printf("%s took %d\n", name, elapsed);
+  }
+}
+
+void test(void)
+{
+  hwtimer_t tmr;
+  hwtimer_alloc(&tmr);
+  xassert(tmr);
+
+  uint32_t start, end;
+  hwtimer_get_time(tmr, &start);
+  hwtimer_core_delay(period);
+  hwtimer_get_time(tmr, &end);
+  check("Delay", start, end);
+
+  hwtimer_get_time(tmr, &start);
+  hwtimer_core_spin(period);
+  hwtimer_get_time(tmr, &end);
+  check("Spin", start, end);
+
+  hwtimer_core_get_time(&start);
+  hwtimer_core_wait_until(start + period);
+  hwtimer_get_time(tmr, &end);
+  check("Wait until", start, end);
+
+  hwtimer_core_get_time(&start);
+  hwtimer_core_spin_until(start + period);
+  hwtimer_get_time(tmr, &end);
+  check("Spin until", start, end);
+
+  uint32_t delay_overhead, spin_overhead;
+  hwtimer_core_delay_calibrate(&delay_overhead, &spin_overhead);
+  if (delay_overhead < tolerance && spin_overhead < tolerance) {
+    debug_printf("Calibrate ok\n");
+  }
+
+  hwtimer_free(&tmr);
+}
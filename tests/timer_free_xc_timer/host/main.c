@@ -0,0 +1,25 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+
+#include "xcore_c.h"
+#include "debug_print.h"
+
+void test(unsigned numTimers);
+
+static void run_test(void *arg)
+{
+  test((unsigned)(uintptr_t)arg);
+}
+
+int main()
+{
+  // As on XS1: 4+3+2 = 9 timers, plus the one kept by the core calling
+  // host_par() where xscope would hold one.
+  static const host_core_t cores[] = {
+    { run_test, (void *)4 },
+    { run_test, (void *)3 },
+    { run_test, (void *)2 },
+  };
+  host_par(cores, 3);
+  debug_printf("success\n");
+  return 0;
+}
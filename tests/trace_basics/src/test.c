@@ -0,0 +1,98 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+
+#include <stdio.h>
+#include "xcore_c.h"
+#include "debug_print.h"
+#include "xassert.h"
+
+static const uint32_t period = 10000;
+
+typedef enum {
+  EVENT_TIMER = ENUM_ID_BASE,
+} event_choice_t;
+
+static const char *event_name(uint32_t event)
+{
+  switch (event) {
+    case trace_select_wait:     return "select_wait";
+    case trace_select_event:    return "select_event";
+    case trace_select_callback: return "select_callback";
+    case trace_chan_out:        return "chan_out";
+    case trace_chan_in:         return "chan_in";
+    case trace_user:            return "user";
+    default:                    return "unexpected";
+  }
+}
+
+DEFINE_SELECT_CALLBACK(handle_timer, data)
+{
+  hwtimer_t t = (hwtimer_t)(uintptr_t)data;
+  hwtimer_disable_trigger(t);
+}
+
+void test(void)
+{
+  static trace_buffer_t buf;
+  trace_start(&buf);
+  trace_record(trace_user, 1);
+
+  streaming_channel_t c;
+  s_chan_alloc(&c);
+  uint32_t x;
+  s_chan_out_word(c.end_a, 2);
+  s_chan_in_word(c.end_b, &x);
+  xassert(x == 2);
+
+  // A callback is taken while waiting for the select event.
+  hwtimer_t cb_tmr, tmr;
+  hwtimer_alloc(&cb_tmr);
+  hwtimer_alloc(&tmr);
+  select_disable_trigger_all();
+  uint32_t now;
+  hwtimer_get_time(tmr, &now);
+  hwtimer_setup_select_callback(cb_tmr, now + period, (void*)(uintptr_t)cb_tmr, SELECT_CALLBACK(handle_timer));
+  hwtimer_setup_select(tmr, now + 2 * period, EVENT_TIMER);
+  hwtimer_enable_trigger(cb_tmr);
+  hwtimer_enable_trigger(tmr);
+  event_choice_t choice = select_wait();
+  xassert(choice == EVENT_TIMER);
+  hwtimer_disable_trigger(tmr);
+
+  trace_stop();
+  trace_record(trace_user, 3);
+
+  size_t count, lost;
+  trace_get_count(&buf, &count, &lost);
+  debug_printf("Count %d lost %d\n", count, lost);
+  uint32_t last = 0;
+  for (size_t i = 0; i < count; i++) {
+    trace_entry_t e;
+    trace_get_entry(&buf, i, &e);
+    xassert(i == 0 || (int32_t)(e.time - last) >= 0);
+    last = e.time;
+    debug_printf("%s", event_name(e.event));
+    switch (e.event) {
+      case trace_chan_out:        xassert(e.arg == c.end_a); break;
+      case trace_chan_in:         xassert(e.arg == c.end_b); break;
+      case trace_select_callback: xassert(e.arg == cb_tmr); break;
+      case trace_select_event:    xassert(e.arg == EVENT_TIMER); break;
+      case trace_user:            debug_printf(" %d", e.arg); break;
+    }
+    debug_printf("\n");
+  }
+
+  // The oldest records are overwritten when the buffer is full.
+  trace_start(&buf);
+  for (uint32_t i = 0; i < XCORE_C_TRACE_ENTRIES + 3; i++) {
+    trace_record(trace_user, i);
+  }
+  trace_stop();
+  trace_get_count(&buf, &count, &lost);
+  trace_entry_t first;
+  trace_get_entry(&buf, 0, &first);
+  debug_printf("Count %d lost %d first %d\n", count, lost, first.arg);
+
+  hwtimer_free(&cb_tmr);
+  hwtimer_free(&tmr);
+  s_chan_free(&c);
+}
@@ -0,0 +1,32 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+
+#include "xcore_c.h"
+
+void transmitter(chanend c);
+void receiver(chanend c);
+
+static channel_t c;
+
+static void run_transmitter(void *arg)
+{
+  transmitter(c.end_a);
+}
+
+static void run_receiver(void *arg)
+{
+  receiver(c.end_b);
+}
+
+int main()
+{
+  // The loopbacks wired up on the simulator by test_uart_rx.py
+  host_port_connect(XS1_PORT_1A, XS1_PORT_1B);
+  host_port_connect(XS1_PORT_1C, XS1_PORT_1D);
+  chan_alloc(&c);
+  static const host_core_t cores[] = {
+    { run_transmitter, NULL },
+    { run_receiver, NULL },
+  };
+  host_par(cores, 2);
+  return 0;
+}
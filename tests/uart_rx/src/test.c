@@ -0,0 +1,102 @@
+// Copyright (c) 2016, XMOS Ltd, All rights reserved
+
+#include <stdio.h>
+#include "xcore_c.h"
+#include "debug_print.h"
+#include "xassert.h"
+
+#define BAUD 115200
+#define BIT_TIME (100000000 / BAUD)
+#define LINES 2
+
+// The bytes of each line's message, which is longer than the receive buffer.
+#define MSG_LEN 8
+#define BUF_SIZE 3
+static const char msg[LINES][MSG_LEN + 1] = {"Transmit", "Together"};
+
+/*
+ * Drive a byte onto every line at once. Each line's bits are offset by half a
+ * bit time from the previous line's, so the receiver samples the lines
+ * alternately.
+ */
+static void send_bytes(port p[], int i)
+{
+  int16_t t[LINES];
+  for (int line = 0; line < LINES; line++) {
+    // Drive the idle level now to get the current port time.
+    port_out(p[line], 1);
+    port_get_trigger_time(p[line], &t[line]);
+    t[line] += line * BIT_TIME / 2;
+  }
+  for (int bit = 0; bit < 10; bit++) {
+    for (int line = 0; line < LINES; line++) {
+      uint32_t value = bit == 0 ? 0 : bit == 9 ? 1 : (msg[line][i] >> (bit - 1)) & 1;
+      port_out_at_time(p[line], t[line] + (bit + 1) * BIT_TIME, value);
+    }
+  }
+}
+
+/*
+ * Drive a message onto each of two looped back lines, all lines at once.
+ */
+void transmitter(chanend c)
+{
+  port p[LINES];
+  port_alloc(&p[0], port_1A);
+  port_alloc(&p[1], port_1C);
+  port_out(p[0], 1);
+  port_out(p[1], 1);
+
+  uint32_t ready;
+  chan_in_word(c, &ready);
+
+  for (int i = 0; i < MSG_LEN; i++) {
+    send_bytes(p, i);
+  }
+
+  port_free(&p[0]);
+  port_free(&p[1]);
+}
+
+/*
+ * Receive both lines on one logical core using select events.
+ */
+void receiver(chanend c)
+{
+  select_disable_trigger_all();
+
+  port p[LINES];
+  port_alloc(&p[0], port_1B);
+  port_alloc(&p[1], port_1D);
+
+  uart_rx_t uart[LINES];
+  uint8_t buf[LINES][BUF_SIZE];
+  for (int line = 0; line < LINES; line++) {
+    uart_rx_init(&uart[line], p[line], BAUD, buf[line], BUF_SIZE);
+    uart_rx_setup_select(&uart[line], ENUM_ID_BASE + line);
+  }
+  chan_out_word(c, 1);
+
+  char received_msg[LINES][MSG_LEN + 1] = {{0}};
+  int count[LINES] = {0};
+  while (count[0] < MSG_LEN || count[1] < MSG_LEN) {
+    uint32_t line = select_wait() - ENUM_ID_BASE;
+    uart_rx_handle_event(&uart[line]);
+
+    uint8_t data;
+    size_t received;
+    uart_rx_get_byte(&uart[line], &data, &received);
+    if (received) {
+      received_msg[line][count[line]++] = data;
+    }
+  }
+
+  for (int line = 0; line < LINES; line++) {
+    uint32_t overruns, framing_errors;
+    uart_rx_get_errors(&uart[line], &overruns, &framing_errors);
+    debug_printf("Line %d: %s, %d errors\n", line, received_msg[line], overruns + framing_errors);
+  }
+
+  port_free(&p[0]);
+  port_free(&p[1]);
+}